@@ -0,0 +1,129 @@
+#include "activityanalyzer.h"
+#include "activitykernel.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QImage>
+
+namespace {
+
+// 1바이트 밝기 평면 (Y) 을 가진 포맷 - 첫 평면에서 바로 샘플링
+bool hasLumaPlane(QVideoFrameFormat::PixelFormat format)
+{
+    switch (format) {
+    case QVideoFrameFormat::Format_NV12:
+    case QVideoFrameFormat::Format_NV21:
+    case QVideoFrameFormat::Format_YUV420P:
+    case QVideoFrameFormat::Format_YUV422P:
+    case QVideoFrameFormat::Format_YV12:
+    case QVideoFrameFormat::Format_IMC1:
+    case QVideoFrameFormat::Format_IMC2:
+    case QVideoFrameFormat::Format_IMC3:
+    case QVideoFrameFormat::Format_IMC4:
+    case QVideoFrameFormat::Format_Y8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+ActivityAnalyzer::ActivityAnalyzer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void ActivityAnalyzer::reset()
+{
+    for (auto it = cameras.constBegin(); it != cameras.constEnd(); ++it) {
+        if (it->level != 0)
+            emit activityChanged(it.key(), 0.0);
+    }
+    cameras.clear();
+}
+
+bool ActivityAnalyzer::sampleLuma(const QVideoFrame &source, quint8 *out)
+{
+    QVideoFrame frame = source;
+    const int width = frame.width();
+    const int height = frame.height();
+    if (width <= 0 || height <= 0)
+        return false;
+
+    // YUV 소프트웨어 프레임 - 매핑된 Y 평면에서 최근접 샘플링 (변환/복사 없음)
+    if (frame.handleType() == QVideoFrame::NoHandle && hasLumaPlane(frame.pixelFormat())
+        && frame.map(QVideoFrame::ReadOnly)) {
+        const uchar *plane = frame.bits(0);
+        const int stride = frame.bytesPerLine(0);
+        for (int y = 0; y < ThumbHeight; ++y) {
+            const uchar *row = plane + qsizetype(y * height / ThumbHeight) * stride;
+            for (int x = 0; x < ThumbWidth; ++x)
+                *out++ = row[x * width / ThumbWidth];
+        }
+        frame.unmap();
+        return true;
+    }
+
+    // 그 외 (RGB, 하드웨어 프레임) - 변환 후 축소 (느린 경로)
+    const QImage image = frame.toImage();
+    if (image.isNull())
+        return false;
+    const QImage thumb = image.scaled(ThumbWidth, ThumbHeight, Qt::IgnoreAspectRatio, Qt::FastTransformation)
+                             .convertToFormat(QImage::Format_Grayscale8);
+    for (int y = 0; y < ThumbHeight; ++y) {
+        memcpy(out, thumb.constScanLine(y), ThumbWidth);
+        out += ThumbWidth;
+    }
+    return true;
+}
+
+void ActivityAnalyzer::addFrame(const QString &ip, const QVideoFrame &frame)
+{
+    CameraState &state = cameras[ip];
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (nowMs - state.lastSampleMs < SampleIntervalMs)
+        return;
+    state.lastSampleMs = nowMs;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    constexpr int count = ThumbWidth * ThumbHeight;
+    state.current.resize(count);
+    if (!sampleLuma(frame, state.current.data()))
+        return;
+
+    if (state.previous.size() != size_t(count)) {
+        state.previous.swap(state.current);  // 첫 프레임 - 비교 대상 없음
+        return;
+    }
+
+    const double meanDiff = double(ActivityKernel::sumAbsDiff(state.previous.data(), state.current.data(), count)) / count;
+    state.previous.swap(state.current);
+
+    ++analyzedFrames;
+    totalNs += timer.nsecsElapsed();
+
+    // 노이즈 제거 후 0~1, 급격한 깜빡임은 지수 평활
+    const double raw = qBound(0.0, (meanDiff - NoiseFloor) / (FullScale - NoiseFloor), 1.0);
+    state.smoothed = state.smoothed * 0.6 + raw * 0.4;
+
+    const int level = qRound(state.smoothed * ActivityLevels);
+    if (level != state.level) {
+        state.level = level;
+        emit activityChanged(ip, double(level) / ActivityLevels);
+    }
+}
+
+QString ActivityAnalyzer::statsText() const
+{
+    const double usPerFrame = analyzedFrames ? totalNs / 1000.0 / analyzedFrames : 0.0;
+    QString text = QString("커널: %1 | 분석 %2 프레임 | 평균 %3 us/프레임\n")
+                       .arg(ActivityKernel::activeImplementation())
+                       .arg(analyzedFrames)
+                       .arg(usPerFrame, 0, 'f', 1);
+    for (auto it = cameras.constBegin(); it != cameras.constEnd(); ++it)
+        text += QString("%1: 활동 %2 / %3\n").arg(it.key()).arg(it->level).arg(ActivityLevels);
+    return text.trimmed();
+}
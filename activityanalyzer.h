@@ -0,0 +1,52 @@
+#ifndef ACTIVITYANALYZER_H
+#define ACTIVITYANALYZER_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVideoFrame>
+
+#include <vector>
+
+// 타일 프레임 간 차이로 카메라별 활동량 추정 (서버 이벤트와 무관한 화면 움직임 표시용)
+// 밝기 채널을 ThumbWidth x ThumbHeight로 샘플링 → 이전 썸네일과 SAD (ActivityKernel, SIMD)
+class ActivityAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ActivityAnalyzer(QObject *parent = nullptr);
+
+    void addFrame(const QString &ip, const QVideoFrame &frame);  // 타일 비디오 싱크 (GUI 스레드)
+    void reset();
+
+    QString statsText() const;  // 진단 창 표시용
+
+    static constexpr int ThumbWidth = 64;
+    static constexpr int ThumbHeight = 48;
+    static constexpr int SampleIntervalMs = 100;    // 카메라당 초당 10회
+    static constexpr double NoiseFloor = 2.0;       // 픽셀당 평균 차이 - 이 이하는 센서 노이즈
+    static constexpr double FullScale = 20.0;       // 이 이상이면 활동량 1.0
+    static constexpr int ActivityLevels = 4;         // 테두리 표시 단계
+
+signals:
+    // 0.0 ~ 1.0, 단계가 바뀔 때만 (단계 = ActivityLevels)
+    void activityChanged(const QString &ip, double level);
+
+private:
+    struct CameraState {
+        std::vector<quint8> previous;
+        std::vector<quint8> current;
+        qint64 lastSampleMs = 0;
+        double smoothed = 0.0;
+        int level = 0;
+    };
+
+    bool sampleLuma(const QVideoFrame &frame, quint8 *out);
+
+    QHash<QString, CameraState> cameras;
+    quint64 analyzedFrames = 0;
+    qint64 totalNs = 0;  // 샘플링 + SAD 누적 시간
+};
+
+#endif // ACTIVITYANALYZER_H
@@ -0,0 +1,182 @@
+#include "activitykernel.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <cstdlib>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SSN_ACTIVITY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang은 함수 단위로 AVX2 허용 (파일 전체 -mavx2 없이 구형 CPU에서도 실행 가능)
+#if defined(SSN_ACTIVITY_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SSN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SSN_TARGET_AVX2
+#endif
+
+namespace ActivityKernel {
+
+namespace {
+
+quint32 sadScalar(const quint8 *a, const quint8 *b, int count)
+{
+    quint32 sum = 0;
+    for (int i = 0; i < count; ++i)
+        sum += quint32(std::abs(int(a[i]) - int(b[i])));
+    return sum;
+}
+
+#ifdef SSN_ACTIVITY_X86
+quint32 sadSse2(const quint8 *a, const quint8 *b, int count)
+{
+    // psadbw: 16바이트 절대 차이를 64비트 두 칸에 합산
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    quint32 sum = quint32(_mm_cvtsi128_si32(acc)) + quint32(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+    return sum + sadScalar(a + i, b + i, count - i);
+}
+
+SSN_TARGET_AVX2 quint32 sadAvx2(const quint8 *a, const quint8 *b, int count)
+{
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+    }
+    const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    quint32 sum = quint32(_mm_cvtsi128_si32(half)) + quint32(_mm_cvtsi128_si32(_mm_srli_si128(half, 8)));
+    return sum + sadScalar(a + i, b + i, count - i);
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;  // OS가 YMM 레지스터를 저장하지 않음
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+struct Dispatch {
+    SadFunction function;
+    const char *name;
+};
+
+Dispatch select()
+{
+#ifdef SSN_ACTIVITY_X86
+    if (cpuHasAvx2())
+        return { sadAvx2, "AVX2" };
+    return { sadSse2, "SSE2" };  // x86-64 기본 명령어
+#else
+    return { sadScalar, "scalar" };
+#endif
+}
+
+const Dispatch &dispatch()
+{
+    static const Dispatch selected = select();
+    return selected;
+}
+
+} // namespace
+
+quint32 sumAbsDiff(const quint8 *a, const quint8 *b, int count)
+{
+    return dispatch().function(a, b, count);
+}
+
+SadFunction scalar()
+{
+    return sadScalar;
+}
+
+SadFunction sse2()
+{
+#ifdef SSN_ACTIVITY_X86
+    return sadSse2;
+#else
+    return nullptr;
+#endif
+}
+
+SadFunction avx2()
+{
+#ifdef SSN_ACTIVITY_X86
+    return cpuHasAvx2() ? sadAvx2 : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+const char *activeImplementation()
+{
+    return dispatch().name;
+}
+
+QString benchmark(int width, int height, int iterations)
+{
+    const int count = width * height;
+    std::vector<quint8> a(size_t(count)), b(size_t(count));
+    QRandomGenerator random(1234);  // 실행마다 같은 입력
+    for (int i = 0; i < count; ++i) {
+        a[size_t(i)] = quint8(random.bounded(256));
+        b[size_t(i)] = quint8(random.bounded(256));
+    }
+
+    const quint32 expected = sadScalar(a.data(), b.data(), count);
+    QString report = QString("활동 감지 커널 %1x%2 (%3 바이트), %4회, 사용 구현: %5\n")
+                         .arg(width).arg(height).arg(count).arg(iterations).arg(activeImplementation());
+
+    const struct { const char *name; SadFunction function; } candidates[] = {
+        { "scalar", scalar() }, { "SSE2", sse2() }, { "AVX2", avx2() }
+    };
+    for (const auto &candidate : candidates) {
+        if (!candidate.function) {
+            report += QString("  %1: 지원 안 함\n").arg(candidate.name);
+            continue;
+        }
+
+        volatile quint32 sink = 0;  // 최적화로 호출이 사라지지 않도록
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i)
+            sink = sink + candidate.function(a.data(), b.data(), count);
+        const double nsPerFrame = double(timer.nsecsElapsed()) / iterations;
+
+        const bool ok = candidate.function(a.data(), b.data(), count) == expected;
+        report += QString("  %1: %2 ns/프레임%3\n")
+                      .arg(candidate.name)
+                      .arg(nsPerFrame, 0, 'f', 1)
+                      .arg(ok ? QString() : QStringLiteral(" (결과 불일치!)"));
+    }
+    return report.trimmed();
+}
+
+} // namespace ActivityKernel
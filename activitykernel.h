@@ -0,0 +1,26 @@
+#ifndef ACTIVITYKERNEL_H
+#define ACTIVITYKERNEL_H
+
+#include <QtGlobal>
+#include <QString>
+
+// 활동 감지 커널 - 8비트 밝기 썸네일 두 장의 절대 차이 합 (SAD)
+// x86은 실행 시 CPU 확인 후 AVX2 → SSE2 순서로 선택, 그 외 플랫폼은 스칼라
+namespace ActivityKernel {
+
+quint32 sumAbsDiff(const quint8 *a, const quint8 *b, int count);
+
+// 구현별 직접 호출 (벤치마크/검증용) - 지원하지 않는 CPU에서는 nullptr
+using SadFunction = quint32 (*)(const quint8 *, const quint8 *, int);
+SadFunction scalar();
+SadFunction sse2();
+SadFunction avx2();
+
+const char *activeImplementation();
+
+// --bench-activity: 썸네일 크기에서 구현별 프레임당 시간 비교 (결과 불일치 시 표시)
+QString benchmark(int width, int height, int iterations);
+
+} // namespace ActivityKernel
+
+#endif // ACTIVITYKERNEL_H
@@ -0,0 +1,145 @@
+#include "alertpanel.h"
+
+#include <QDateTime>
+#include <QHeaderView>
+#include <QPixmap>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+AlertPanel::AlertPanel(CameraHttpClient *client, QWidget *parent)
+    : QDialog(parent), httpClient(client)
+{
+    setWindowTitle("에스컬레이션 알림");
+    setMinimumSize(640, 360);
+    setModal(false);
+
+    summaryLabel = new QLabel();
+    summaryLabel->setStyleSheet("font-weight: bold; color: #ff8c00;");
+
+    alertTable = new QTableWidget(0, 4);
+    alertTable->setHorizontalHeaderLabels({"시각", "카메라", "내용", "횟수"});
+    alertTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+    alertTable->verticalHeader()->setVisible(false);
+    alertTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    alertTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    alertTable->setIconSize(QSize(160, 120));
+
+    QPushButton *clearButton = new QPushButton("모두 지우기");
+    QPushButton *closeButton = new QPushButton("닫기");
+    connect(clearButton, &QPushButton::clicked, this, [this]() {
+        alertTable->setRowCount(0);
+        rowByKey.clear();
+        totalCount = 0;
+        summaryLabel->clear();
+    });
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::hide);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(clearButton);
+    buttonLayout->addWidget(closeButton);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addWidget(summaryLabel);
+    mainLayout->addWidget(alertTable);
+    mainLayout->addLayout(buttonLayout);
+
+    setStyleSheet(R"(
+        QDialog { background-color: #2b2b2b; color: white; }
+        QLabel { color: white; }
+        QTableWidget { background-color: #404040; color: white; gridline-color: #555; }
+        QHeaderView::section { background-color: #353535; color: white; font-weight: bold; }
+    )");
+
+    presentTimer.setSingleShot(true);
+    connect(&presentTimer, &QTimer::timeout, this, &AlertPanel::present);
+}
+
+void AlertPanel::raiseAlert(const QString &key, const QString &cameraName, const QString &text,
+                            const QUrl &imageUrl)
+{
+    const QString timeText = QDateTime::currentDateTime().toString("HH:mm:ss");
+
+    QTableWidgetItem *timeItem = rowByKey.value(key);
+    if (timeItem) {
+        // 같은 카메라/이벤트 - 맨 위로 올리고 횟수만 증가
+        const int count = timeItem->data(Qt::UserRole).toInt() + 1;
+        const QIcon icon = timeItem->icon();
+        alertTable->removeRow(timeItem->row());
+
+        timeItem = new QTableWidgetItem(timeText);
+        timeItem->setData(Qt::UserRole, count);
+        timeItem->setIcon(icon);
+    } else {
+        timeItem = new QTableWidgetItem(timeText);
+        timeItem->setData(Qt::UserRole, 1);
+    }
+
+    alertTable->insertRow(0);
+    alertTable->setItem(0, 0, timeItem);
+    alertTable->setItem(0, 1, new QTableWidgetItem(cameraName));
+    alertTable->setItem(0, 2, new QTableWidgetItem(text));
+    alertTable->setItem(0, 3, new QTableWidgetItem(QString::number(timeItem->data(Qt::UserRole).toInt())));
+    if (!timeItem->icon().isNull())
+        alertTable->setRowHeight(0, 124);
+    rowByKey.insert(key, timeItem);
+    trimRows();
+
+    if (imageUrl.isValid())
+        fetchThumbnail(key, imageUrl);
+
+    ++totalCount;
+    summaryLabel->setText(QString("알림 %1건 | 마지막: %2 %3").arg(totalCount).arg(cameraName, timeText));
+
+    // 알림 폭주 시에도 창은 MinPresentIntervalMs마다 한 번만 앞으로
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 wait = lastPresentedMs + MinPresentIntervalMs - now;
+    if (wait <= 0)
+        present();
+    else if (!presentTimer.isActive())
+        presentTimer.start(static_cast<int>(wait));
+}
+
+void AlertPanel::present()
+{
+    lastPresentedMs = QDateTime::currentMSecsSinceEpoch();
+    show();
+    raise();
+}
+
+void AlertPanel::fetchThumbnail(const QString &key, const QUrl &imageUrl)
+{
+    if (thumbnailInFlight.contains(key))
+        return;  // 같은 행 이미지 요청은 하나만
+    thumbnailInFlight.insert(key, imageUrl);
+
+    httpClient->fetchImage(imageUrl, this, [this, key](const QByteArray &data, const QString &error) {
+        thumbnailInFlight.remove(key);
+        if (!error.isEmpty())
+            return;
+
+        QPixmap pix;
+        pix.loadFromData(data);
+        QTableWidgetItem *item = rowByKey.value(key);
+        if (pix.isNull() || !item)
+            return;  // 그 사이 행이 지워짐
+        item->setIcon(QIcon(pix.scaled(160, 120, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
+        alertTable->setRowHeight(item->row(), 124);
+    });
+}
+
+void AlertPanel::trimRows()
+{
+    while (alertTable->rowCount() > MaxRows) {
+        const int last = alertTable->rowCount() - 1;
+        QTableWidgetItem *item = alertTable->item(last, 0);
+        for (auto it = rowByKey.begin(); it != rowByKey.end(); ++it) {
+            if (it.value() == item) {
+                rowByKey.erase(it);
+                break;
+            }
+        }
+        alertTable->removeRow(last);
+    }
+}
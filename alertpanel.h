@@ -0,0 +1,44 @@
+#ifndef ALERTPANEL_H
+#define ALERTPANEL_H
+
+#include "camerahttpclient.h"
+
+#include <QDialog>
+#include <QHash>
+#include <QLabel>
+#include <QTableWidget>
+#include <QTimer>
+#include <QUrl>
+
+// 에스컬레이션 알림 통합 패널 (비모달 1개)
+// 같은 카메라/이벤트 알림은 한 행으로 합치고, 창 띄우기는 일정 간격으로 제한
+class AlertPanel : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit AlertPanel(CameraHttpClient *client, QWidget *parent = nullptr);
+
+    // key: 카메라/이벤트 구분 (같은 key는 기존 행 갱신)
+    void raiseAlert(const QString &key, const QString &cameraName, const QString &text,
+                    const QUrl &imageUrl = QUrl());
+
+private:
+    void present();
+    void fetchThumbnail(const QString &key, const QUrl &imageUrl);
+    void trimRows();
+
+    CameraHttpClient *httpClient;  // MainWindow와 공유
+    QTableWidget *alertTable;
+    QLabel *summaryLabel;
+    QHash<QString, QTableWidgetItem*> rowByKey;  // key → 첫 열 항목 (행 번호는 item->row())
+    QHash<QString, QUrl> thumbnailInFlight;
+    QTimer presentTimer;
+    qint64 lastPresentedMs = 0;
+    int totalCount = 0;
+
+    static constexpr int MinPresentIntervalMs = 5000;  // 창을 다시 띄우는 최소 간격
+    static constexpr int MaxRows = 50;
+};
+
+#endif // ALERTPANEL_H
@@ -0,0 +1,104 @@
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<quint64> allocations { 0 };
+
+} // namespace
+
+#if defined(SSN_COUNT_ALLOCATIONS) && defined(__GLIBC__)
+
+// 실행 파일에 정의한 malloc이 Qt 라이브러리의 호출까지 가로챔 - 실제 할당은 glibc 내부 함수로
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+
+void *malloc(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(pointer, size);
+}
+}
+
+#elif defined(SSN_COUNT_ALLOCATIONS)
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
+
+namespace AllocationCounter {
+
+bool enabled()
+{
+#ifdef SSN_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char *method()
+{
+#if defined(SSN_COUNT_ALLOCATIONS) && defined(__GLIBC__)
+    return "malloc/calloc/realloc (glibc)";
+#elif defined(SSN_COUNT_ALLOCATIONS)
+    return "operator new (Qt 컨테이너 malloc 제외)";
+#else
+    return "꺼짐 (-DSSN_COUNT_ALLOCATIONS=ON)";
+#endif
+}
+
+quint64 count()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace AllocationCounter
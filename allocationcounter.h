@@ -0,0 +1,17 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+// 힙 할당 횟수 집계 (--bench-ingest용)
+// CMake -DSSN_COUNT_ALLOCATIONS=ON 빌드에서만 동작 - glibc는 malloc/calloc/realloc 전체(Qt 컨테이너 포함),
+// 그 외 플랫폼은 operator new만 집계. 배포 빌드에서는 꺼 둠 (할당마다 원자 연산 추가)
+namespace AllocationCounter {
+
+bool enabled();
+const char *method();  // 집계 방식 설명
+quint64 count();       // 프로세스 시작 이후 누적
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,84 @@
+#include "appoptions.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+namespace {
+
+AppOptions &storage()
+{
+    static AppOptions options;
+    return options;
+}
+
+} // namespace
+
+const AppOptions &AppOptions::parse(const QCoreApplication &app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Smart SafetyNet 모니터링 클라이언트");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption recordOption("record", "카메라 이벤트를 파일로 기록", "file");
+    QCommandLineOption replayOption("replay", "기록 파일을 카메라 없이 재생", "file");
+    QCommandLineOption speedOption("replay-speed", "재생 배속 (1, 4, ... 또는 max)", "speed", "1");
+    QCommandLineOption gatewayOption("gateway", "이벤트 게이트웨이 URL (예: ws://127.0.0.1:8765)", "url",
+                                     qEnvironmentVariable("SSN_GATEWAY_URL"));
+    QCommandLineOption benchActivityOption("bench-activity", "활동 감지 커널(SAD) 벤치마크 후 종료");
+    QCommandLineOption benchIngestOption("bench-ingest", "이벤트 파싱 경로 벤치마크 (건당 할당/시간) 후 종료");
+    QCommandLineOption replayLoopOption("replay-loop", "재생이 끝나면 처음부터 반복");
+    QCommandLineOption kioskOption("kiosk", "무인 표시 모드 (전체 화면 + 메모리 예산)");
+    QCommandLineOption budgetOption("memory-budget-mb", "전체 메모리 예산 (MB, 키오스크 기본 512)", "mb");
+    parser.addOption(recordOption);
+    parser.addOption(replayOption);
+    parser.addOption(speedOption);
+    parser.addOption(gatewayOption);
+    parser.addOption(benchActivityOption);
+    parser.addOption(benchIngestOption);
+    parser.addOption(replayLoopOption);
+    parser.addOption(kioskOption);
+    parser.addOption(budgetOption);
+    parser.process(app);
+
+    AppOptions &options = storage();
+    options.recordPath = parser.value(recordOption);
+    options.replayPath = parser.value(replayOption);
+    options.gatewayUrl = QUrl(parser.value(gatewayOption));
+    options.benchActivity = parser.isSet(benchActivityOption);
+    options.benchIngest = parser.isSet(benchIngestOption);
+    options.replayLoop = parser.isSet(replayLoopOption);
+    options.kiosk = parser.isSet(kioskOption);
+
+    if (parser.isSet(budgetOption)) {
+        bool ok = false;
+        const int value = parser.value(budgetOption).toInt(&ok);
+        if (!ok || value < 64)
+            qWarning() << "[옵션] 잘못된 --memory-budget-mb 값:" << parser.value(budgetOption) << "- 최소 64 MB";
+        options.memoryBudgetMb = ok ? qMax(64, value) : 0;
+    }
+    if (options.kiosk && options.memoryBudgetMb == 0)
+        options.memoryBudgetMb = DefaultKioskBudgetMb;
+
+    const QString speed = parser.value(speedOption);
+    if (speed.compare("max", Qt::CaseInsensitive) == 0) {
+        options.replaySpeed = 0.0;
+    } else {
+        bool ok = false;
+        const double value = speed.toDouble(&ok);
+        if (!ok || value <= 0.0)
+            qWarning() << "[옵션] 잘못된 --replay-speed 값:" << speed << "- 1배속 사용";
+        options.replaySpeed = ok && value > 0.0 ? value : 1.0;
+    }
+
+    if (options.isReplay() && !options.recordPath.isEmpty()) {
+        qWarning() << "[옵션] 재생 중에는 기록하지 않음";
+        options.recordPath.clear();
+    }
+    return options;
+}
+
+const AppOptions &AppOptions::current()
+{
+    return storage();
+}
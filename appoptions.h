@@ -0,0 +1,36 @@
+#ifndef APPOPTIONS_H
+#define APPOPTIONS_H
+
+#include <QCoreApplication>
+#include <QString>
+#include <QUrl>
+
+// 클라이언트 실행 옵션 (main.cpp에서 한 번 파싱, 이후 current()로 조회)
+//
+//   QtClientSSN --record trace.ssnrec                 # 카메라 이벤트 원본 기록
+//   QtClientSSN --replay trace.ssnrec --replay-speed max   # 카메라 없이 기록 재생 (1, 4, max ...)
+//   QtClientSSN --bench-activity                      # 활동 감지 커널 벤치마크 후 종료
+//   QtClientSSN --bench-ingest                        # 이벤트 파싱 경로 할당/시간 비교 후 종료
+//   QtClientSSN --kiosk --memory-budget-mb 384        # 무인 벽면 표시 - 전체 화면 + 메모리 예산
+//   QtClientSSN --kiosk --replay trace.ssnrec --replay-loop   # 장기 메모리 추이 확인용 반복 부하
+struct AppOptions
+{
+    QString recordPath;         // 비어 있으면 기록 안 함
+    QString replayPath;         // 설정 시 카메라 연결 없이 기록 재생
+    double replaySpeed = 1.0;   // 배속 (0 = 최대 속도)
+    QUrl gatewayUrl;            // --gateway 또는 SSN_GATEWAY_URL
+    bool benchActivity = false; // 활동 감지 커널 벤치마크만 실행
+    bool benchIngest = false;   // 이벤트 파싱 벤치마크만 실행 (할당 횟수는 SSN_COUNT_ALLOCATIONS 빌드)
+    bool replayLoop = false;    // 재생이 끝나면 처음부터 다시
+    bool kiosk = false;         // 전체 화면 + 메모리 예산 (기본 DefaultKioskBudgetMb)
+    int memoryBudgetMb = 0;     // 0 = 예산 없음 (캐시별 기본 한도만)
+
+    bool isReplay() const { return !replayPath.isEmpty(); }
+
+    static constexpr int DefaultKioskBudgetMb = 512;
+
+    static const AppOptions &parse(const QCoreApplication &app);
+    static const AppOptions &current();
+};
+
+#endif // APPOPTIONS_H
@@ -0,0 +1,168 @@
+#include "camerahttpclient.h"
+
+#include <QNetworkRequest>
+#include <QDebug>
+
+CameraHttpClient::CameraHttpClient(QNetworkAccessManager *manager, CameraTls *tls, QObject *parent)
+    : QObject(parent), networkManager(manager), cameraTls(tls)
+{
+    imageCache.setMaxCost(ImageCacheKb);
+}
+
+QUrl CameraHttpClient::imageUrl(const QString &ip, const QString &imagePath)
+{
+    QString cleanPath = imagePath;
+    if (cleanPath.startsWith("../"))
+        cleanPath = cleanPath.mid(3);
+    else if (cleanPath.startsWith("./"))
+        cleanPath = cleanPath.mid(2);
+    return QUrl(QString("http://%1/%2").arg(ip, cleanPath));
+}
+
+void CameraHttpClient::get(const QUrl &url, QObject *context, ReplyHandler handler, Priority priority)
+{
+    PendingRequest request;
+    request.url = url;
+    request.context = context;
+    request.hasContext = context != nullptr;
+    request.handler = std::move(handler);
+
+    const QString host = url.host();
+    hosts[host].lanes[static_cast<int>(priority)].push_back(std::move(request));
+    pump(host);
+}
+
+void CameraHttpClient::pump(const QString &host)
+{
+    HostQueue &queue = hosts[host];
+    while (queue.running < MaxConcurrentPerHost) {
+        PendingRequest next;
+        bool found = false;
+        for (int lane = 0; lane < 3 && !found; ++lane) {
+            // 미리 받기는 다른 요청이 없고 절반 이하로 사용 중일 때만
+            if (lane == static_cast<int>(Priority::Prefetch) && queue.running >= MaxConcurrentPerHost / 2)
+                break;
+            while (!queue.lanes[lane].empty()) {
+                next = std::move(queue.lanes[lane].front());
+                queue.lanes[lane].pop_front();
+                if (next.hasContext && !next.context)
+                    continue;  // 요청한 창이 이미 닫힘
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return;
+
+        ++queue.running;
+        start(host, std::move(next));
+    }
+}
+
+void CameraHttpClient::start(const QString &host, PendingRequest request)
+{
+    QNetworkRequest networkRequest(request.url);
+    networkRequest.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);         // 카메라가 지원하면 다중화
+    networkRequest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true); // HTTP/1.1 연결 재사용
+    networkRequest.setTransferTimeout(10000);
+    if (cameraTls && request.url.scheme() == QLatin1String("https"))
+        networkRequest.setSslConfiguration(cameraTls->configurationFor(host));
+
+    ++requestCount;
+    QNetworkReply *reply = networkManager->get(networkRequest);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, host, request = std::move(request)]() {
+        reply->deleteLater();
+        if (reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool())
+            ++http2Replies;
+
+        --hosts[host].running;
+        if (!request.hasContext || request.context)
+            request.handler(reply);
+        pump(host);
+    });
+}
+
+void CameraHttpClient::fetchImage(const QString &ip, const QString &imagePath, QObject *context,
+                                  ImageHandler handler, Priority priority)
+{
+    fetchImage(imageUrl(ip, imagePath), context, std::move(handler), priority);
+}
+
+void CameraHttpClient::fetchImage(const QUrl &url, QObject *context, ImageHandler handler, Priority priority)
+{
+    const QString key = url.toString();
+
+    if (const QByteArray *cached = imageCache.object(key)) {
+        ++cacheHits;
+        if (handler)
+            handler(*cached, QString());
+        return;
+    }
+
+    auto waiting = imageWaiters.find(key);
+    if (waiting != imageWaiters.end()) {
+        // 같은 이미지 요청이 진행 중 - 응답을 함께 받음
+        ++coalescedImages;
+        waiting->push_back({ context, context != nullptr, std::move(handler) });
+        return;
+    }
+    imageWaiters[key].push_back({ context, context != nullptr, std::move(handler) });
+
+    get(url, this, [this, key](QNetworkReply *reply) {
+        QByteArray data;
+        QString error;
+        if (reply->error() == QNetworkReply::NoError) {
+            data = reply->readAll();
+            imageCache.insert(key, new QByteArray(data), qMax<qsizetype>(1, data.size() / 1024));
+        } else {
+            error = reply->errorString();
+        }
+
+        const std::vector<ImageWaiter> waiters = imageWaiters.take(key);
+        for (const ImageWaiter &waiter : waiters) {
+            if (waiter.handler && (!waiter.hasContext || waiter.context))
+                waiter.handler(data, error);
+        }
+    }, priority);
+}
+
+void CameraHttpClient::prefetchImage(const QString &ip, const QString &imagePath)
+{
+    if (imagePath.isEmpty())
+        return;
+    const QString key = imageUrl(ip, imagePath).toString();
+    if (imageCache.contains(key) || imageWaiters.contains(key))
+        return;
+    fetchImage(ip, imagePath, nullptr, ImageHandler(), Priority::Prefetch);
+}
+
+void CameraHttpClient::setImageCacheBytes(qint64 bytes)
+{
+    imageCache.setMaxCost(static_cast<int>(qBound<qint64>(1, bytes / 1024, ImageCacheKb)));
+
+    // 요청이 끝난 카메라(삭제 포함)의 대기열 항목도 정리
+    for (auto it = hosts.begin(); it != hosts.end();) {
+        const HostQueue &queue = it.value();
+        const bool idle = queue.running == 0 && queue.lanes[0].empty() && queue.lanes[1].empty() && queue.lanes[2].empty();
+        it = idle ? hosts.erase(it) : std::next(it);
+    }
+}
+
+QString CameraHttpClient::statsText() const
+{
+    QString text = QString("요청 %1건 | HTTP/2 %2건 | 이미지 캐시 적중 %3건 | 중복 병합 %4건 | 캐시 %5 KB\n")
+                       .arg(requestCount)
+                       .arg(http2Replies)
+                       .arg(cacheHits)
+                       .arg(coalescedImages)
+                       .arg(imageCache.totalCost());
+    for (auto it = hosts.constBegin(); it != hosts.constEnd(); ++it) {
+        const HostQueue &queue = it.value();
+        text += QString("%1: 진행 %2 | 대기 %3\n")
+                    .arg(it.key())
+                    .arg(queue.running)
+                    .arg(queue.lanes[0].size() + queue.lanes[1].size() + queue.lanes[2].size());
+    }
+    return text.trimmed();
+}
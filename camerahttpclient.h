@@ -0,0 +1,94 @@
+#ifndef CAMERAHTTPCLIENT_H
+#define CAMERAHTTPCLIENT_H
+
+#include "cameratls.h"
+
+#include <QObject>
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QUrl>
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+// 카메라 REST / 이미지 요청 공용 계층
+// - QNetworkAccessManager 하나 공유 (HTTP/2 허용, HTTP/1.1은 파이프라이닝)
+// - 카메라(호스트)별 동시 요청 수 제한 + 우선순위 대기열
+// - 감지 이미지는 바이트 캐시 + 같은 이미지 중복 요청 병합
+class CameraHttpClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Priority : quint8 {
+        Interactive,  // 사용자가 연 이미지
+        Normal,       // 로그 동기화 등
+        Prefetch      // 여유 있을 때만 (최근 감지 이미지 미리 받기)
+    };
+
+    using ReplyHandler = std::function<void(QNetworkReply *reply)>;   // reply는 호출 후 자동 삭제
+    using ImageHandler = std::function<void(const QByteArray &data, const QString &error)>;
+
+    CameraHttpClient(QNetworkAccessManager *manager, CameraTls *tls, QObject *parent = nullptr);
+
+    // context가 사라지면 콜백 생략
+    void get(const QUrl &url, QObject *context, ReplyHandler handler, Priority priority = Priority::Normal);
+
+    void fetchImage(const QUrl &url, QObject *context, ImageHandler handler,
+                    Priority priority = Priority::Interactive);
+    void fetchImage(const QString &ip, const QString &imagePath, QObject *context, ImageHandler handler,
+                    Priority priority = Priority::Interactive);
+    void prefetchImage(const QString &ip, const QString &imagePath);
+
+    // 서버가 주는 상대 경로("../", "./")를 http://ip/path 로 정리
+    static QUrl imageUrl(const QString &ip, const QString &imagePath);
+
+    QString statsText() const;  // 진단 창 표시용
+
+    // 이미지 캐시 한도 (키오스크 메모리 예산) - 줄이면 오래된 이미지부터 즉시 제거
+    void setImageCacheBytes(qint64 bytes);
+    qint64 memoryUsage() const { return qint64(imageCache.totalCost()) * 1024; }
+
+    static constexpr int MaxConcurrentPerHost = 4;
+    static constexpr int ImageCacheKb = 32 * 1024;
+
+private:
+    struct PendingRequest {
+        QUrl url;
+        QPointer<QObject> context;
+        ReplyHandler handler;
+        bool hasContext = false;
+    };
+
+    struct HostQueue {
+        int running = 0;
+        std::deque<PendingRequest> lanes[3];  // Priority 순
+    };
+
+    void pump(const QString &host);
+    void start(const QString &host, PendingRequest request);
+
+    QNetworkAccessManager *networkManager;
+    CameraTls *cameraTls;
+    QHash<QString, HostQueue> hosts;
+
+    struct ImageWaiter {
+        QPointer<QObject> context;
+        bool hasContext = false;
+        ImageHandler handler;
+    };
+    QCache<QString, QByteArray> imageCache;          // URL → 이미지 바이트 (비용 KB)
+    QHash<QString, std::vector<ImageWaiter>> imageWaiters;  // 진행 중인 이미지 요청
+
+    quint64 requestCount = 0;
+    quint64 cacheHits = 0;
+    quint64 coalescedImages = 0;
+    quint64 http2Replies = 0;
+};
+
+#endif // CAMERAHTTPCLIENT_H
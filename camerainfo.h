@@ -2,18 +2,48 @@
 #define CAMERAINFO_H
 
 #include <QString>
+#include <QUrl>
 
 struct CameraInfo {
+    enum class Type { Pi, Onvif };
+
     QString name;
     QString ip;
-    QString port;
+    QString port;           // Pi: RTSPS 포트 / ONVIF: 디바이스 서비스(HTTP) 포트
+    Type type = Type::Pi;
+
+    // ONVIF 인증 정보 (없으면 인증 없이 요청)
+    QString onvifUser;
+    QString onvifPassword;
+
+    // CameraRegistry에 함께 저장되는 마지막 상태
+    QString lastMode;            // 마지막으로 요청한 모드 (raw / blur / detect / trespass / fall)
+    QString preferredProfile;    // ONVIF: 마지막으로 선택된 프로파일 토큰
+    QString preferredStreamUri;  // ONVIF: 해당 프로파일 스트림 URI (인증 정보 없이 저장, 시작 시 조회 전에 바로 재생)
+    QString tlsFingerprint;      // 최초 연결 때 고정한 서버 인증서 SHA-256 (hex)
+
+    bool isOnvif() const { return type == Type::Onvif; }
 
     QString rtspUrl() const {
         return QString("rtsps://%1:%2/raw").arg(ip, port);
     }
 
+    // ONVIF 스트림 URI에 인증 정보를 붙인 재생용 URL (저장/비교는 인증 정보 없는 URI로)
+    QString onvifPlaybackUrl(const QString &streamUri) const {
+        QUrl url(streamUri);
+        if (!url.isValid() || onvifUser.isEmpty())
+            return streamUri;
+        url.setUserName(onvifUser);
+        url.setPassword(onvifPassword);
+        return url.toString();
+    }
+
+    QString onvifServiceUrl() const {
+        return QString("http://%1:%2/onvif/device_service").arg(ip, port);
+    }
+
     bool operator==(const CameraInfo &other) const {
-        return name == other.name && ip == other.ip && port == other.port;
+        return name == other.name && ip == other.ip && port == other.port && type == other.type;
     }
 };
 
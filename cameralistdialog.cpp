@@ -46,8 +46,8 @@ CameraListDialog::CameraListDialog(QWidget *parent, QVector<CameraInfo>* cameraL
 
 void CameraListDialog::setupUI()
 {
-    table = new QTableWidget(0, 4);
-    table->setHorizontalHeaderLabels(QStringList() << "스트리밍 영역" << "카메라 이름" << "카메라 IP" << "포트번호");
+    table = new QTableWidget(0, 5);
+    table->setHorizontalHeaderLabels(QStringList() << "스트리밍 영역" << "카메라 이름" << "카메라 IP" << "포트번호" << "유형");
     table->horizontalHeader()->setStretchLastSection(true);
     table->verticalHeader()->setVisible(false);
     table->setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -79,6 +79,7 @@ void CameraListDialog::refreshTable()
         table->setItem(i, 1, new QTableWidgetItem(cam.name));
         table->setItem(i, 2, new QTableWidgetItem(cam.ip));
         table->setItem(i, 3, new QTableWidgetItem(cam.port));
+        table->setItem(i, 4, new QTableWidgetItem(cam.isOnvif() ? "ONVIF" : "Pi"));
     }
 }
 
@@ -90,6 +91,9 @@ void CameraListDialog::onAddCamera()
         info.name = dialog.getCameraName();
         info.ip = dialog.getCameraIP();
         info.port = dialog.getCameraPort();
+        info.type = dialog.getCameraType();
+        info.onvifUser = dialog.getOnvifUser();
+        info.onvifPassword = dialog.getOnvifPassword();
 
         cameraListRef->append(info);
         refreshTable();
@@ -1,5 +1,4 @@
 #include "cameraregistrationdialog.h"
-#include "camerainfo.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -49,6 +48,13 @@ void CameraRegistrationDialog::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
+    // 카메라 유형 (Pi 서버 / ONVIF)
+    QLabel *typeLabel = new QLabel("카메라 유형:");
+    typeCombo = new QComboBox();
+    typeCombo->addItem("Pi 카메라 (RTSPS)", static_cast<int>(CameraInfo::Type::Pi));
+    typeCombo->addItem("ONVIF 카메라", static_cast<int>(CameraInfo::Type::Onvif));
+    connect(typeCombo, &QComboBox::currentIndexChanged, this, &CameraRegistrationDialog::onTypeChanged);
+
     // 카메라 이름
     QLabel *nameLabel = new QLabel("카메라 이름:");
     nameEdit = new QLineEdit();
@@ -65,10 +71,17 @@ void CameraRegistrationDialog::setupUI()
     ipEdit->setValidator(ipValidator);
 
     // 포트 번호
-    QLabel *portLabel = new QLabel("포트번호:");
+    portLabel = new QLabel("포트번호:");
     portEdit = new QLineEdit();
     portEdit->setPlaceholderText("예: 8555");
 
+    // ONVIF 인증 정보 (선택)
+    onvifUserLabel = new QLabel("ONVIF 사용자 (선택):");
+    onvifUserEdit = new QLineEdit();
+    onvifPasswordLabel = new QLabel("ONVIF 비밀번호 (선택):");
+    onvifPasswordEdit = new QLineEdit();
+    onvifPasswordEdit->setEchoMode(QLineEdit::Password);
+
     // 버튼 생성
     okButton = new QPushButton("등록");
     cancelButton = new QPushButton("취소");
@@ -94,16 +107,24 @@ void CameraRegistrationDialog::setupUI()
     btnLayout->addWidget(cancelButton);
 
     // 메인 레이아웃 구성
+    mainLayout->addWidget(typeLabel);
+    mainLayout->addWidget(typeCombo);
     mainLayout->addWidget(nameLabel);
     mainLayout->addWidget(nameEdit);
     mainLayout->addWidget(ipLabel);
     mainLayout->addWidget(ipEdit);
     mainLayout->addWidget(portLabel);
     mainLayout->addWidget(portEdit);
+    mainLayout->addWidget(onvifUserLabel);
+    mainLayout->addWidget(onvifUserEdit);
+    mainLayout->addWidget(onvifPasswordLabel);
+    mainLayout->addWidget(onvifPasswordEdit);
     mainLayout->addLayout(btnLayout);
 
+    onTypeChanged(typeCombo->currentIndex());
+
     // 다이얼로그 크기 확장 (진짜 중요!)
-    setFixedSize(420, 300);
+    setFixedSize(420, 460);
     setModal(true);
     setWindowTitle("카메라 등록");
 
@@ -146,6 +167,19 @@ void CameraRegistrationDialog::onOkClicked()
     accept();
 }
 
+void CameraRegistrationDialog::onTypeChanged(int index)
+{
+    Q_UNUSED(index);
+    const bool onvif = getCameraType() == CameraInfo::Type::Onvif;
+
+    portLabel->setText(onvif ? "ONVIF 서비스 포트:" : "포트번호:");
+    portEdit->setPlaceholderText(onvif ? "예: 80" : "예: 8555");
+    onvifUserLabel->setVisible(onvif);
+    onvifUserEdit->setVisible(onvif);
+    onvifPasswordLabel->setVisible(onvif);
+    onvifPasswordEdit->setVisible(onvif);
+}
+
 void CameraRegistrationDialog::onCancelClicked()
 {
     reject();
@@ -155,3 +189,6 @@ void CameraRegistrationDialog::onCancelClicked()
 QString CameraRegistrationDialog::getCameraName() const { return nameEdit->text().trimmed(); }
 QString CameraRegistrationDialog::getCameraIP() const { return ipEdit->text().trimmed(); }
 QString CameraRegistrationDialog::getCameraPort() const { return portEdit->text().trimmed(); }
+CameraInfo::Type CameraRegistrationDialog::getCameraType() const { return static_cast<CameraInfo::Type>(typeCombo->currentData().toInt()); }
+QString CameraRegistrationDialog::getOnvifUser() const { return onvifUserEdit->text().trimmed(); }
+QString CameraRegistrationDialog::getOnvifPassword() const { return onvifPasswordEdit->text(); }
@@ -4,6 +4,10 @@
 #include <QDialog>
 #include <QLineEdit>
 #include <QPushButton>
+#include <QComboBox>
+#include <QLabel>
+
+#include "camerainfo.h"
 
 class CameraRegistrationDialog : public QDialog
 {
@@ -15,6 +19,9 @@ public:
     QString getCameraName() const;
     QString getCameraIP() const;
     QString getCameraPort() const;
+    CameraInfo::Type getCameraType() const;
+    QString getOnvifUser() const;
+    QString getOnvifPassword() const;
 
 private slots:
     void onOkClicked();
@@ -22,10 +29,17 @@ private slots:
 
 private:
     void setupUI();
+    void onTypeChanged(int index);
 
+    QComboBox *typeCombo;
     QLineEdit *nameEdit;
     QLineEdit *ipEdit;
     QLineEdit *portEdit;
+    QLabel *portLabel;
+    QLabel *onvifUserLabel;
+    QLineEdit *onvifUserEdit;
+    QLabel *onvifPasswordLabel;
+    QLineEdit *onvifPasswordEdit;
 
     QPushButton *okButton;
     QPushButton *cancelButton;
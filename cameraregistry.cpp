@@ -0,0 +1,111 @@
+#include "cameraregistry.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+QString CameraRegistry::filePath()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return QDir(dir).filePath("cameras.json");
+}
+
+QVector<CameraInfo> CameraRegistry::load()
+{
+    return load(filePath());
+}
+
+QVector<CameraInfo> CameraRegistry::load(const QString &path)
+{
+    QVector<CameraInfo> cameras;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return cameras;  // 첫 실행
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject()) {
+        qWarning() << "[CameraRegistry] 파일 파싱 실패:" << file.fileName();
+        return cameras;
+    }
+
+    const QJsonArray arr = doc["cameras"].toArray();
+    for (const QJsonValue &val : arr) {
+        QJsonObject obj = val.toObject();
+
+        CameraInfo camera;
+        camera.name = obj["name"].toString();
+        camera.ip = obj["ip"].toString();
+        camera.port = obj["port"].toString();
+        camera.type = obj["type"].toString() == "onvif" ? CameraInfo::Type::Onvif : CameraInfo::Type::Pi;
+        camera.onvifUser = obj["onvif_user"].toString();
+        camera.onvifPassword = obj["onvif_password"].toString();
+        camera.lastMode = obj["last_mode"].toString();
+        camera.preferredProfile = obj["preferred_profile"].toString();
+        // 예전 파일에는 인증 정보가 붙은 URI가 저장돼 있을 수 있음 - 읽을 때 제거 (다음 저장부터 빠짐)
+        QUrl streamUri(obj["preferred_stream_uri"].toString());
+        streamUri.setUserInfo(QString());
+        camera.preferredStreamUri = streamUri.toString();
+        camera.tlsFingerprint = obj["tls_fingerprint"].toString();
+
+        if (!camera.ip.isEmpty())
+            cameras.append(camera);
+    }
+
+    qDebug() << "[CameraRegistry] 카메라" << cameras.size() << "대 복원";
+    return cameras;
+}
+
+bool CameraRegistry::save(const QVector<CameraInfo> &cameras)
+{
+    QJsonArray arr;
+    for (const CameraInfo &camera : cameras) {
+        QJsonObject obj;
+        obj["name"] = camera.name;
+        obj["ip"] = camera.ip;
+        obj["port"] = camera.port;
+        obj["type"] = camera.isOnvif() ? "onvif" : "pi";
+        if (!camera.onvifUser.isEmpty()) {
+            obj["onvif_user"] = camera.onvifUser;
+            obj["onvif_password"] = camera.onvifPassword;
+        }
+        obj["last_mode"] = camera.lastMode;
+        obj["preferred_profile"] = camera.preferredProfile;
+        obj["preferred_stream_uri"] = camera.preferredStreamUri;
+        if (!camera.tlsFingerprint.isEmpty())
+            obj["tls_fingerprint"] = camera.tlsFingerprint;
+        arr.append(obj);
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["cameras"] = arr;
+
+    QDir().mkpath(QFileInfo(filePath()).absolutePath());
+
+    // 저장 중 종료되어도 기존 파일이 깨지지 않도록 QSaveFile 사용
+    QSaveFile file(filePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[CameraRegistry] 저장 실패:" << file.errorString();
+        return false;
+    }
+    // ONVIF 비밀번호가 들어있으므로 소유자만 읽기/쓰기 - 내용을 쓰기 전에 임시 파일에 지정
+    // (commit 후에 바꾸면 교체된 파일이 잠시 기본 권한으로 노출됨)
+    if (!file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner)) {
+        qWarning() << "[CameraRegistry] 권한 설정 실패:" << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qWarning() << "[CameraRegistry] 저장 실패:" << file.errorString();
+        return false;
+    }
+    return true;
+}
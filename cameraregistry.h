@@ -0,0 +1,20 @@
+#ifndef CAMERAREGISTRY_H
+#define CAMERAREGISTRY_H
+
+#include "camerainfo.h"
+
+#include <QVector>
+#include <QString>
+
+// 카메라 목록 디스크 저장소 (앱 데이터 폴더의 cameras.json)
+class CameraRegistry
+{
+public:
+    static QString filePath();
+
+    static QVector<CameraInfo> load();
+    static QVector<CameraInfo> load(const QString &path);  // 게이트웨이 등 다른 경로
+    static bool save(const QVector<CameraInfo> &cameras);
+};
+
+#endif // CAMERAREGISTRY_H
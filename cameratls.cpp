@@ -0,0 +1,176 @@
+#include "cameratls.h"
+
+#include <QCryptographicHash>
+#include <QNetworkReply>
+#include <QDebug>
+
+namespace {
+
+// 고정된 인증서일 때 허용하는 오류 - 자가서명/체인 검증 실패와 IP 접속에 따른 호스트명 불일치만
+// (만료/폐기/서명 오류 등은 지문이 맞아도 허용하지 않음)
+bool isPinnableError(const QSslError &error)
+{
+    switch (error.error()) {
+    case QSslError::SelfSignedCertificate:
+    case QSslError::SelfSignedCertificateInChain:
+    case QSslError::UnableToGetLocalIssuerCertificate:
+    case QSslError::UnableToGetIssuerCertificate:
+    case QSslError::UnableToVerifyFirstCertificate:
+    case QSslError::CertificateUntrusted:
+    case QSslError::HostNameMismatch:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+CameraTls::CameraTls(QObject *parent)
+    : QObject(parent)
+{
+    baseConfiguration = QSslConfiguration::defaultConfiguration();
+    // 자가서명 인증서 - CA 검증 대신 지문 고정으로 확인 (오류는 sslErrors에서 선택적으로 허용)
+    baseConfiguration.setPeerVerifyMode(QSslSocket::VerifyPeer);
+    // 세션 티켓을 꺼내 다음 연결에 재사용
+    baseConfiguration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+}
+
+QSslConfiguration CameraTls::configurationFor(const QString &host) const
+{
+    QSslConfiguration config = baseConfiguration;
+    const QByteArray ticket = sessionTickets.value(host);
+    if (!ticket.isEmpty())
+        config.setSessionTicket(ticket);
+    return config;
+}
+
+void CameraTls::setPin(const QString &host, const QString &fingerprint)
+{
+    if (fingerprint.isEmpty())
+        pins.remove(host);
+    else
+        pins.insert(host, fingerprint);
+}
+
+QString CameraTls::fingerprint(const QSslCertificate &certificate)
+{
+    return QString::fromLatin1(certificate.digest(QCryptographicHash::Sha256).toHex());
+}
+
+bool CameraTls::verifyPeer(const QString &host, const QSslCertificate &peer)
+{
+    if (peer.isNull()) {
+        ++rejected;
+        return false;
+    }
+
+    const QString actual = fingerprint(peer);
+    const QString expected = pins.value(host);
+
+    if (expected.isEmpty()) {
+        // 최초 연결 - 이 인증서로 고정
+        pins.insert(host, actual);
+        qDebug() << "[TLS] 인증서 고정:" << host << actual.left(16) << "...";
+        emit pinned(host, actual);
+        return true;
+    }
+
+    if (expected == actual)
+        return true;
+
+    ++rejected;
+    qWarning() << "[TLS] 인증서 불일치 → 연결 거부:" << host << "고정" << expected.left(16) << "수신" << actual.left(16);
+    emit pinMismatch(host);
+    return false;
+}
+
+QList<QSslError> CameraTls::pinnedErrors(const QString &host, const QSslCertificate &peer, const QList<QSslError> &errors)
+{
+    if (!verifyPeer(host, peer))
+        return {};
+
+    QList<QSslError> allowed;
+    for (const QSslError &error : errors) {
+        if (!isPinnableError(error)) {
+            ++rejected;
+            qWarning() << "[TLS] 허용하지 않는 인증서 오류 → 연결 거부:" << host << error.errorString();
+            return {};
+        }
+        allowed.append(error);
+    }
+    return allowed;
+}
+
+void CameraTls::attach(QWebSocket *socket, const QString &host)
+{
+    connect(socket, &QWebSocket::sslErrors, this, [this, socket, host](const QList<QSslError> &errors) {
+        const QList<QSslError> allowed = pinnedErrors(host, socket->sslConfiguration().peerCertificate(), errors);
+        if (!allowed.isEmpty())
+            socket->ignoreSslErrors(allowed);  // 고정된 인증서의 자가서명/체인 오류만 허용
+    });
+    // CA 검증을 통과한 인증서는 sslErrors가 오지 않음 - 연결될 때마다 지문을 다시 확인
+    connect(socket, &QWebSocket::connected, this, [this, socket, host]() {
+        if (!verifyPeer(host, socket->sslConfiguration().peerCertificate())) {
+            socket->abort();
+            return;
+        }
+        ++handshakes;
+        rememberSession(host, socket->sslConfiguration());
+    });
+}
+
+void CameraTls::applyConfiguration(QWebSocket *socket, const QString &host)
+{
+    const QSslConfiguration config = configurationFor(host);
+    if (!config.sessionTicket().isEmpty())
+        ++ticketOffers;
+    socket->setSslConfiguration(config);
+}
+
+void CameraTls::attach(QNetworkAccessManager *manager)
+{
+    connect(manager, &QNetworkAccessManager::sslErrors, this, [this](QNetworkReply *reply, const QList<QSslError> &errors) {
+        const QList<QSslError> allowed = pinnedErrors(reply->url().host(), reply->sslConfiguration().peerCertificate(), errors);
+        if (!allowed.isEmpty())
+            reply->ignoreSslErrors(allowed);
+    });
+    // 핸드셰이크가 끝날 때마다 (요청 본문을 보내기 전) 지문 확인 - CA가 서명한 다른 인증서도 거부
+    connect(manager, &QNetworkAccessManager::encrypted, this, [this](QNetworkReply *reply) {
+        if (!verifyPeer(reply->url().host(), reply->sslConfiguration().peerCertificate())) {
+            reply->abort();
+            return;
+        }
+        ++handshakes;
+        rememberSession(reply->url().host(), reply->sslConfiguration());
+    });
+}
+
+void CameraTls::warmUp(QNetworkAccessManager *manager, const QString &host, quint16 port)
+{
+    if (warmedHosts.contains(host))
+        return;
+    warmedHosts.insert(host);
+
+    const QSslConfiguration config = configurationFor(host);
+    if (!config.sessionTicket().isEmpty())
+        ++ticketOffers;
+    manager->connectToHostEncrypted(host, port, config);
+}
+
+void CameraTls::rememberSession(const QString &host, const QSslConfiguration &negotiated)
+{
+    const QByteArray ticket = negotiated.sessionTicket();
+    if (!ticket.isEmpty())
+        sessionTickets.insert(host, ticket);
+}
+
+QString CameraTls::statsText() const
+{
+    return QString("핸드셰이크 %1회 | 세션 티켓 재사용 시도 %2회 | 보관 티켓 %3개 | 거부 %4회\n고정된 인증서: %5개")
+        .arg(handshakes)
+        .arg(ticketOffers)
+        .arg(sessionTickets.size())
+        .arg(rejected)
+        .arg(pins.size());
+}
@@ -0,0 +1,67 @@
+#ifndef CAMERATLS_H
+#define CAMERATLS_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QSslCertificate>
+#include <QSslConfiguration>
+#include <QSslError>
+#include <QNetworkAccessManager>
+#include <QWebSocket>
+
+// 카메라 TLS 공용 설정 - 카메라별 세션 티켓 재사용 + 인증서 지문 고정 (최초 연결 시 고정, TOFU)
+// 지문은 핸드셰이크가 끝날 때마다 확인 (CA 검증을 통과한 인증서도 지문이 다르면 끊음)
+// sslErrors는 일괄 무시하지 않고 고정된 인증서의 자가서명/체인 오류만 허용
+class CameraTls : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CameraTls(QObject *parent = nullptr);
+
+    // 공용 설정 + 해당 카메라의 마지막 세션 티켓
+    QSslConfiguration configurationFor(const QString &host) const;
+
+    void setPin(const QString &host, const QString &fingerprint);
+    QString pin(const QString &host) const { return pins.value(host); }
+
+    // 고정 지문과 같으면(또는 최초면 고정 후) true → 호출자가 errors를 무시
+    bool verifyPeer(const QString &host, const QSslCertificate &peer);
+
+    // 웹소켓: 소켓마다 한 번 - 인증서 검증 + 세션 저장
+    void attach(QWebSocket *socket, const QString &host);
+    // 웹소켓: open()마다 직전에 호출 - 공용 설정 + 그때까지 받은 마지막 세션 티켓 (재연결도 티켓 재사용)
+    void applyConfiguration(QWebSocket *socket, const QString &host);
+
+    // REST: 매니저의 모든 HTTPS 응답에 검증/세션 저장 적용
+    void attach(QNetworkAccessManager *manager);
+
+    // 시작 시 TLS 연결을 미리 맺어 둠 (첫 REST 요청이 핸드셰이크를 기다리지 않도록)
+    void warmUp(QNetworkAccessManager *manager, const QString &host, quint16 port);
+
+    static QString fingerprint(const QSslCertificate &certificate);
+
+    QString statsText() const;  // 진단 창 표시용
+
+signals:
+    void pinned(const QString &host, const QString &fingerprint);  // 최초 고정 → 레지스트리 저장
+    void pinMismatch(const QString &host);
+
+private:
+    // 지문이 맞고 모든 오류가 자가서명/체인 오류일 때만 그 목록, 아니면 빈 목록 (→ 연결 실패)
+    QList<QSslError> pinnedErrors(const QString &host, const QSslCertificate &peer, const QList<QSslError> &errors);
+    void rememberSession(const QString &host, const QSslConfiguration &negotiated);
+
+    QSslConfiguration baseConfiguration;
+    QHash<QString, QString> pins;            // host → SHA-256 hex
+    QHash<QString, QByteArray> sessionTickets;
+    QSet<QString> warmedHosts;
+
+    quint64 handshakes = 0;
+    quint64 ticketOffers = 0;   // 저장된 티켓으로 연결 시도한 횟수
+    quint64 rejected = 0;
+};
+
+#endif // CAMERATLS_H
@@ -0,0 +1,324 @@
+#include "clipbuffer.h"
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDesktopServices>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QVideoFrameFormat>
+#include <QDebug>
+
+namespace {
+
+// 4:2:0 YUV - 밝기 평면 + 가로/세로 절반 색차
+bool isYuv420(QVideoFrameFormat::PixelFormat format)
+{
+    switch (format) {
+    case QVideoFrameFormat::Format_NV12:
+    case QVideoFrameFormat::Format_NV21:
+    case QVideoFrameFormat::Format_YUV420P:
+    case QVideoFrameFormat::Format_YV12:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// 작업 스레드에서 매핑해 바로 읽을 수 있는 프레임 (메모리 버퍼 + RGB 계열 또는 4:2:0 YUV)
+bool mappableOnWorker(const QVideoFrame &frame)
+{
+    if (frame.handleType() != QVideoFrame::NoHandle)
+        return false;
+    const QVideoFrameFormat::PixelFormat format = frame.pixelFormat();
+    return isYuv420(format) || QVideoFrameFormat::imageFormatFromPixelFormat(format) != QImage::Format_Invalid;
+}
+
+inline uchar clampByte(int value)
+{
+    return static_cast<uchar>(qBound(0, value, 255));
+}
+
+// 매핑한 프레임을 targetWidth 폭으로 축소 (전체 해상도 QImage를 만들지 않음) - 작업 스레드
+QImage downscaleMapped(QVideoFrame frame, int targetWidth)
+{
+    const int width = frame.width();
+    const int height = frame.height();
+    if (width <= 0 || height <= 0 || !frame.map(QVideoFrame::ReadOnly))
+        return QImage();
+
+    const int outWidth = qMin(width, targetWidth);
+    const int outHeight = qMax(1, static_cast<int>(qint64(height) * outWidth / width));
+    const QVideoFrameFormat::PixelFormat format = frame.pixelFormat();
+    QImage result;
+
+    if (const QImage::Format imageFormat = QVideoFrameFormat::imageFormatFromPixelFormat(format);
+        imageFormat != QImage::Format_Invalid) {
+        // RGB 계열 - 매핑된 버퍼를 복사 없이 감싸 축소 (결과는 새 버퍼 - unmap 후에도 유효해야 함)
+        const QImage mapped(frame.bits(0), width, height, frame.bytesPerLine(0), imageFormat);
+        result = outWidth == width ? mapped.copy()
+                                   : mapped.scaled(outWidth, outHeight, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    } else {
+        // 4:2:0 YUV - 출력 픽셀만 최근접 샘플링 + BT.601 변환
+        // NV12/NV21은 UV가 한 평면에 번갈아, YUV420P/YV12는 U/V 평면이 따로 (YV12는 V가 먼저)
+        const uchar *lumaPlane = frame.bits(0);
+        const int lumaStride = frame.bytesPerLine(0);
+        int uIndex = 1, vIndex = 2, uOffset = 0, vOffset = 0, chromaStep = 1;
+        switch (format) {
+        case QVideoFrameFormat::Format_NV12: vIndex = 1; vOffset = 1; chromaStep = 2; break;
+        case QVideoFrameFormat::Format_NV21: vIndex = 1; uOffset = 1; chromaStep = 2; break;
+        case QVideoFrameFormat::Format_YV12: uIndex = 2; vIndex = 1; break;
+        default: break;
+        }
+        const uchar *uPlane = frame.bits(uIndex) + uOffset;
+        const uchar *vPlane = frame.bits(vIndex) + vOffset;
+        const int uStride = frame.bytesPerLine(uIndex);
+        const int vStride = frame.bytesPerLine(vIndex);
+
+        result = QImage(outWidth, outHeight, QImage::Format_RGB32);
+        for (int oy = 0; oy < outHeight; ++oy) {
+            const int sy = static_cast<int>(qint64(oy) * height / outHeight);
+            const uchar *luma = lumaPlane + qsizetype(sy) * lumaStride;
+            const uchar *uRow = uPlane + qsizetype(sy / 2) * uStride;
+            const uchar *vRow = vPlane + qsizetype(sy / 2) * vStride;
+            QRgb *out = reinterpret_cast<QRgb *>(result.scanLine(oy));
+            for (int ox = 0; ox < outWidth; ++ox) {
+                const int sx = static_cast<int>(qint64(ox) * width / outWidth);
+                const int chroma = (sx / 2) * chromaStep;
+                const int c = 298 * (luma[sx] - 16);
+                const int d = uRow[chroma] - 128;
+                const int e = vRow[chroma] - 128;
+                out[ox] = qRgb(clampByte((c + 409 * e + 128) >> 8),
+                               clampByte((c - 100 * d - 208 * e + 128) >> 8),
+                               clampByte((c + 516 * d + 128) >> 8));
+            }
+        }
+    }
+
+    frame.unmap();
+    return result;
+}
+
+} // namespace
+
+ClipBuffer::ClipBuffer(QObject *parent)
+    : QObject(parent)
+{
+    encodePool.setMaxThreadCount(2);
+
+    maintenanceTimer.setInterval(1000);
+    connect(&maintenanceTimer, &QTimer::timeout, this, [this]() {
+        trimAll();
+        finishDueClips();
+    });
+    maintenanceTimer.start();
+}
+
+ClipBuffer::~ClipBuffer()
+{
+    finishDueClips(true);  // 저장 중이던 클립은 모인 프레임까지 기록
+    encodePool.waitForDone();
+}
+
+QString ClipBuffer::clipDirectory()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return dir + "/clips";
+}
+
+void ClipBuffer::openClip(QWidget *parent, const QString &path)
+{
+    if (!QFile::exists(path)) {
+        QMessageBox::information(parent, "클립", "클립을 저장 중이거나 삭제되었습니다.\n" + path);
+        return;
+    }
+    QDesktopServices::openUrl(QUrl::fromLocalFile(path));
+}
+
+qint64 ClipBuffer::cameraBudget() const
+{
+    const qint64 cameras = qMax<qint64>(1, buffers.size());
+    return qMin(MaxBytesPerCamera, totalLimit / cameras);
+}
+
+void ClipBuffer::setMemoryLimit(qint64 bytes)
+{
+    totalLimit = qBound<qint64>(MaxBytesPerCamera / 8, bytes, MaxTotalBytes);
+    trimAll();
+}
+
+void ClipBuffer::addFrame(const QString &ip, const QVideoFrame &frame)
+{
+    CameraBuffer &buffer = buffers[ip];
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (nowMs - buffer.lastCaptureMs < 1000 / CaptureFps)
+        return;
+    if (buffer.encoding) {
+        ++skippedFrames;
+        return;
+    }
+    buffer.lastCaptureMs = nowMs;
+
+    // 소프트웨어 프레임은 그대로 작업 스레드로 (암시적 공유 - 복사 없음) → 매핑 + 축소 + 압축 모두 작업 스레드
+    // 하드웨어 프레임(텍스처)과 읽을 수 없는 포맷만 GUI 스레드에서 변환
+    QImage image;
+    if (!mappableOnWorker(frame)) {
+        image = frame.toImage();
+        if (image.isNull())
+            return;
+        ++guiConvertedFrames;
+    }
+    buffer.encoding = true;
+
+    encodePool.start([this, ip, nowMs, frame, image]() {
+        QImage scaled;
+        if (image.isNull())
+            scaled = downscaleMapped(frame, FrameWidth);
+        else
+            scaled = image.width() > FrameWidth ? image.scaledToWidth(FrameWidth, Qt::SmoothTransformation) : image;
+
+        QByteArray jpeg;
+        if (!scaled.isNull()) {
+            QBuffer out(&jpeg);
+            out.open(QIODevice::WriteOnly);
+            scaled.save(&out, "JPEG", JpegQuality);
+        }
+
+        QMetaObject::invokeMethod(this, [this, ip, nowMs, jpeg]() {
+            appendEncoded(ip, nowMs, jpeg);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ClipBuffer::appendEncoded(const QString &ip, qint64 atMs, const QByteArray &jpeg)
+{
+    auto it = buffers.find(ip);
+    if (it == buffers.end())
+        return;  // 그 사이 카메라 삭제
+    CameraBuffer &buffer = it.value();
+    buffer.encoding = false;
+    if (jpeg.isEmpty())
+        return;
+
+    buffer.frames.push_back({ atMs, jpeg });
+    buffer.bytes += jpeg.size();
+    totalBytes += jpeg.size();
+    ++capturedFrames;
+    trim(buffer, atMs);
+
+    for (PendingClip &clip : pendingClips) {
+        if (clip.ip == ip && atMs <= clip.untilMs)
+            clip.frames.append(jpeg);
+    }
+    finishDueClips();
+}
+
+void ClipBuffer::trim(CameraBuffer &buffer, qint64 nowMs)
+{
+    const qint64 budget = cameraBudget();
+    while (!buffer.frames.empty()
+           && (buffer.bytes > budget || nowMs - buffer.frames.front().atMs > PreEventMs)) {
+        const qint64 size = buffer.frames.front().jpeg.size();
+        buffer.bytes -= size;
+        totalBytes -= size;
+        buffer.frames.pop_front();
+    }
+}
+
+void ClipBuffer::trimAll()
+{
+    // 더 이상 프레임이 오지 않는 카메라(다른 페이지, 삭제)는 비워지면 제거 - 카메라당 몫 재분배
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = buffers.begin(); it != buffers.end();) {
+        trim(it.value(), nowMs);
+        if (it->frames.empty() && !it->encoding)
+            it = buffers.erase(it);
+        else
+            ++it;
+    }
+}
+
+QString ClipBuffer::saveClip(const QString &ip, const QString &label)
+{
+    // 같은 카메라 클립이 저장 중이면 그 클립에 포함
+    for (const PendingClip &clip : std::as_const(pendingClips)) {
+        if (clip.ip == ip)
+            return clip.path;
+    }
+
+    auto it = buffers.constFind(ip);
+    if (it == buffers.constEnd() || it->frames.empty())
+        return QString();  // 화면에 재생 중이 아닌 카메라
+
+    QDir().mkpath(clipDirectory());
+
+    PendingClip clip;
+    clip.ip = ip;
+    clip.untilMs = QDateTime::currentMSecsSinceEpoch() + PostEventMs;
+    clip.path = QString("%1/%2_%3_%4.mjpeg")
+                    .arg(clipDirectory(),
+                         QString(ip).replace(':', '_'),
+                         QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"),
+                         label);
+    clip.frames.reserve(static_cast<int>(it->frames.size()) + PostEventMs / 1000 * CaptureFps);
+    for (const Frame &frame : it->frames)
+        clip.frames.append(frame.jpeg);
+
+    qDebug() << "[Clip] 저장 시작:" << clip.path << "이전 프레임" << clip.frames.size() << "개";
+    pendingClips.append(clip);
+    return clip.path;
+}
+
+void ClipBuffer::finishDueClips(bool force)
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (int i = pendingClips.size() - 1; i >= 0; --i) {
+        if (!force && pendingClips[i].untilMs > nowMs)
+            continue;
+
+        PendingClip clip = pendingClips.takeAt(i);
+        ++savedClips;
+
+        // 파일 쓰기 + 오래된 클립 정리는 작업 스레드
+        encodePool.start([this, clip]() {
+            QSaveFile file(clip.path);
+            if (!file.open(QIODevice::WriteOnly)) {
+                qWarning() << "[Clip] 파일 열기 실패:" << clip.path << file.errorString();
+                return;
+            }
+            for (const QByteArray &jpeg : clip.frames)
+                file.write(jpeg);
+            if (!file.commit()) {
+                qWarning() << "[Clip] 저장 실패:" << clip.path << file.errorString();
+                return;
+            }
+
+            QDir dir(clipDirectory());
+            const QFileInfoList files = dir.entryInfoList({ "*.mjpeg" }, QDir::Files, QDir::Time);
+            for (int f = MaxClipFiles; f < files.size(); ++f)
+                QFile::remove(files.at(f).absoluteFilePath());
+
+            const QString path = clip.path;
+            const int frames = static_cast<int>(clip.frames.size());
+            QMetaObject::invokeMethod(this, [this, path, frames]() { emit clipSaved(path, frames); },
+                                      Qt::QueuedConnection);
+        });
+    }
+}
+
+QString ClipBuffer::statsText() const
+{
+    return QString("카메라 %1대 | 버퍼 %2 / %3 KB (카메라당 %4 KB) | 캡처 %5 (GUI 변환 %6) | 건너뜀 %7 | 클립 %8개 (저장 중 %9)")
+        .arg(buffers.size())
+        .arg(totalBytes / 1024)
+        .arg(totalLimit / 1024)
+        .arg(cameraBudget() / 1024)
+        .arg(capturedFrames)
+        .arg(guiConvertedFrames)
+        .arg(skippedFrames)
+        .arg(savedClips)
+        .arg(pendingClips.size());
+}
@@ -0,0 +1,96 @@
+#ifndef CLIPBUFFER_H
+#define CLIPBUFFER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include <QVideoFrame>
+#include <QWidget>
+
+#include <deque>
+
+// 카메라별 이벤트 전 영상 버퍼 + 이벤트 전/후 클립 저장
+//
+// QMediaPlayer는 압축 패킷을 내주지 않으므로, 타일이 이미 디코딩한 프레임을 낮은 fps로 샘플링해
+// 작업 스레드에서 JPEG 한 번만 압축해 보관하고 클립은 그 JPEG를 그대로 이어 씀 (.mjpeg, 재압축 없음)
+// 소프트웨어 프레임은 작업 스레드에서 매핑해 FrameWidth로 바로 축소 - GUI 스레드 변환은 하드웨어 프레임만
+// 메모리는 카메라 수와 무관하게 MaxTotalBytes 이하 - 카메라가 늘면 카메라당 몫이 줄어듦
+class ClipBuffer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClipBuffer(QObject *parent = nullptr);
+    ~ClipBuffer();
+
+    // 타일 비디오 싱크 프레임 (GUI 스레드) - CaptureFps로 샘플링
+    void addFrame(const QString &ip, const QVideoFrame &frame);
+
+    // 이벤트 전 PreEventMs + 이후 PostEventMs 클립 저장 시작
+    // 반환: 저장될 파일 경로 (버퍼된 프레임이 없으면 빈 문자열)
+    QString saveClip(const QString &ip, const QString &label);
+
+    static QString clipDirectory();
+    static void openClip(QWidget *parent, const QString &path);  // 기본 플레이어로 열기 (저장 중이면 안내)
+    QString statsText() const;  // 진단 창 표시용
+
+    // 전체 버퍼 한도 (기본 MaxTotalBytes, 키오스크 메모리 예산에서 조정) - 줄이면 바로 잘라냄
+    void setMemoryLimit(qint64 bytes);
+    qint64 memoryUsage() const { return totalBytes; }
+
+    static constexpr int CaptureFps = 5;
+    static constexpr int FrameWidth = 640;
+    static constexpr int JpegQuality = 70;
+    static constexpr qint64 PreEventMs = 10000;
+    static constexpr qint64 PostEventMs = 5000;
+    static constexpr qint64 MaxBytesPerCamera = 8 * 1024 * 1024;
+    static constexpr qint64 MaxTotalBytes = 48 * 1024 * 1024;
+    static constexpr int MaxClipFiles = 200;  // 오래된 클립부터 삭제
+
+signals:
+    void clipSaved(const QString &path, int frames);
+
+private:
+    struct Frame {
+        qint64 atMs;
+        QByteArray jpeg;
+    };
+
+    struct CameraBuffer {
+        std::deque<Frame> frames;
+        qint64 bytes = 0;
+        qint64 lastCaptureMs = 0;
+        bool encoding = false;  // 압축 중이면 다음 프레임 건너뜀 (작업 스레드 적체 방지)
+    };
+
+    struct PendingClip {
+        QString ip;
+        QString path;
+        qint64 untilMs = 0;
+        QVector<QByteArray> frames;  // 버퍼와 공유 (암시적 공유 - 복사 없음)
+    };
+
+    void appendEncoded(const QString &ip, qint64 atMs, const QByteArray &jpeg);
+    void trim(CameraBuffer &buffer, qint64 nowMs);
+    void trimAll();
+    void finishDueClips(bool force = false);
+    qint64 cameraBudget() const;
+
+    QHash<QString, CameraBuffer> buffers;
+    QVector<PendingClip> pendingClips;
+    qint64 totalBytes = 0;
+    qint64 totalLimit = MaxTotalBytes;
+    QThreadPool encodePool;  // 압축 + 파일 쓰기 (소멸 시 완료 대기)
+    QTimer maintenanceTimer; // 화면에서 빠진 카메라 버퍼 비우기 + 클립 마감
+
+    quint64 capturedFrames = 0;
+    quint64 skippedFrames = 0;
+    quint64 guiConvertedFrames = 0;  // 작업 스레드에서 읽을 수 없어 GUI 스레드에서 toImage한 프레임
+    quint64 savedClips = 0;
+};
+
+#endif // CLIPBUFFER_H
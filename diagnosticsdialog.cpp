@@ -0,0 +1,70 @@
+#include "diagnosticsdialog.h"
+
+#include <QScrollArea>
+
+DiagnosticsDialog::DiagnosticsDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("진단");
+    setMinimumSize(520, 400);
+    setModal(false);
+
+    QWidget *content = new QWidget();
+    sectionLayout = new QVBoxLayout(content);
+    sectionLayout->addStretch();
+
+    QScrollArea *scroll = new QScrollArea();
+    scroll->setWidgetResizable(true);
+    scroll->setWidget(content);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addWidget(scroll);
+
+    setStyleSheet(R"(
+        QDialog { background-color: #2b2b2b; color: white; }
+        QLabel { color: white; }
+    )");
+
+    refreshTimer.setInterval(1000);
+    connect(&refreshTimer, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+}
+
+void DiagnosticsDialog::addSection(const QString &title, std::function<QString()> provider)
+{
+    QLabel *titleLabel = new QLabel(title);
+    titleLabel->setStyleSheet("font-weight: bold; color: orange; margin-top: 6px;");
+
+    Section section;
+    section.body = new QLabel();
+    section.body->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    section.body->setStyleSheet("font-family: monospace;");
+    section.provider = std::move(provider);
+
+    // 마지막 stretch 앞에 추가
+    const int insertAt = sectionLayout->count() - 1;
+    sectionLayout->insertWidget(insertAt, titleLabel);
+    sectionLayout->insertWidget(insertAt + 1, section.body);
+    sections.append(section);
+
+    if (isVisible())
+        refresh();
+}
+
+void DiagnosticsDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    refresh();
+    refreshTimer.start();
+}
+
+void DiagnosticsDialog::hideEvent(QHideEvent *event)
+{
+    refreshTimer.stop();  // 닫혀 있을 때는 수집 비용 없음
+    QDialog::hideEvent(event);
+}
+
+void DiagnosticsDialog::refresh()
+{
+    for (const Section &section : std::as_const(sections))
+        section.body->setText(section.provider());
+}
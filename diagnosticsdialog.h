@@ -0,0 +1,39 @@
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QVector>
+
+#include <functional>
+
+// 런타임 진단 창 - 각 서브시스템이 섹션(제목 + 텍스트 생성 함수)을 등록, 열려 있는 동안 1초마다 갱신
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog(QWidget *parent = nullptr);
+
+    void addSection(const QString &title, std::function<QString()> provider);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void refresh();
+
+    struct Section {
+        QLabel *body = nullptr;
+        std::function<QString()> provider;
+    };
+
+    QVBoxLayout *sectionLayout;
+    QVector<Section> sections;
+    QTimer refreshTimer;
+};
+
+#endif // DIAGNOSTICSDIALOG_H
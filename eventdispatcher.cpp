@@ -0,0 +1,78 @@
+#include "eventdispatcher.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <cstring>
+
+int EventDispatcher::registerHandler(const QString &type, std::unique_ptr<Handler> handler)
+{
+    const QByteArray name = type.toUtf8();
+    if (const int existing = typeId(std::string_view(name.constData(), size_t(name.size()))); existing >= 0) {
+        handlers[existing] = std::move(handler);
+        return existing;
+    }
+
+    const int id = static_cast<int>(handlers.size());
+    typeNames.push_back(name);
+    handlers.push_back(std::move(handler));
+
+    TypeStats stats;
+    stats.type = type;
+    typeStats.append(stats);
+    return id;
+}
+
+int EventDispatcher::typeId(std::string_view type) const
+{
+    for (size_t id = 0; id < typeNames.size(); ++id) {
+        const QByteArray &name = typeNames[id];
+        if (size_t(name.size()) == type.size() && std::memcmp(name.constData(), type.data(), type.size()) == 0)
+            return static_cast<int>(id);
+    }
+    return -1;
+}
+
+bool EventDispatcher::dispatch(const QString &ip, const EventFrame &frame)
+{
+    const std::string_view type = frame.type();
+    const int id = typeId(type);
+    if (id < 0) {
+        ++unknownTypes;
+        qWarning() << "[WebSocket] 알 수 없는 타입 수신:" << EventFrame::toQString(type);
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const DecodeReport report = handlers[id]->handle(ip, frame);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    TypeStats &stats = typeStats[id];
+    ++stats.count;
+    stats.totalNs += elapsed;
+    stats.maxNs = qMax(stats.maxNs, elapsed);
+    if (stats.schema.add(report)) {
+        qWarning() << "[WebSocket] 스키마 불일치:" << stats.type << ip
+                   << "필드 누락" << report.missing << "타입 불일치" << report.wrongType << "(이후는 집계만)";
+    }
+    return true;
+}
+
+QString EventDispatcher::statsText() const
+{
+    QString text;
+    for (const TypeStats &stats : typeStats) {
+        const double avgUs = stats.count ? stats.totalNs / 1000.0 / stats.count : 0.0;
+        text += QString("%1: %2건 | 평균 %3 µs | 최대 %4 µs")
+                    .arg(stats.type, -20)
+                    .arg(stats.count)
+                    .arg(avgUs, 0, 'f', 1)
+                    .arg(stats.maxNs / 1000.0, 0, 'f', 1);
+        if (stats.schema.mismatched)
+            text += QStringLiteral(" | ") + stats.schema.text();
+        text += QLatin1Char('\n');
+    }
+    text += QString("알 수 없는 타입: %1건").arg(unknownTypes);
+    return text;
+}
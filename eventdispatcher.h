@@ -0,0 +1,80 @@
+#ifndef EVENTDISPATCHER_H
+#define EVENTDISPATCHER_H
+
+#include "eventframe.h"
+#include "serverevents.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// 서버 이벤트 타입 문자열 → 핸들러 디스패치 테이블
+// 타입은 등록 시 한 번만 정수 id로 바꾸고, 타입별 처리 횟수/소요 시간을 자동 집계
+// 타입 조회는 수신 프레임의 뷰를 등록된 이름과 길이 + 바이트 비교 (타입 수가 적어 해시보다 빠르고 할당 없음)
+// 필드는 EventSchema<Event>로 디코딩 - 스키마 불일치는 타입별로 집계하고 첫 건만 경고
+class EventDispatcher
+{
+public:
+    // 타입 하나를 처리하는 핸들러 - 메시지를 타입별 구조체로 디코딩 후 콜백 호출, 디코딩 결과 반환
+    class Handler
+    {
+    public:
+        virtual ~Handler() = default;
+        virtual DecodeReport handle(const QString &ip, const EventFrame &frame) = 0;
+    };
+
+    template <typename Event>
+    class TypedEventHandler : public Handler
+    {
+    public:
+        using Callback = std::function<void(const QString &ip, const Event &event)>;
+        explicit TypedEventHandler(Callback callback) : callback(std::move(callback)) {}
+
+        DecodeReport handle(const QString &ip, const EventFrame &frame) override
+        {
+            DecodeReport report;
+            callback(ip, decodeEvent<Event>(frame, &report));  // EventSchema<Event> 필요
+            return report;
+        }
+
+    private:
+        Callback callback;
+    };
+
+    struct TypeStats {
+        QString type;
+        quint64 count = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        SchemaStats schema;
+    };
+
+    // 같은 타입을 다시 등록하면 핸들러만 교체 (id 유지)
+    template <typename Event>
+    int registerHandler(const QString &type, typename TypedEventHandler<Event>::Callback callback)
+    {
+        return registerHandler(type, std::make_unique<TypedEventHandler<Event>>(std::move(callback)));
+    }
+    int registerHandler(const QString &type, std::unique_ptr<Handler> handler);
+
+    int typeId(std::string_view type) const;
+
+    // 등록되지 않은 타입이면 false
+    bool dispatch(const QString &ip, const EventFrame &frame);
+
+    const QVector<TypeStats> &stats() const { return typeStats; }
+    quint64 unknownCount() const { return unknownTypes; }
+    QString statsText() const;  // 진단 창 표시용
+
+private:
+    std::vector<QByteArray> typeNames;               // id 순서 (UTF-8)
+    std::vector<std::unique_ptr<Handler>> handlers;  // id 순서
+    QVector<TypeStats> typeStats;                     // id 순서
+    quint64 unknownTypes = 0;
+};
+
+#endif // EVENTDISPATCHER_H
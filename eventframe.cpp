@@ -0,0 +1,420 @@
+#include "eventframe.h"
+
+#include <QByteArray>
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+void skipSpace(const char *&p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+        ++p;
+}
+
+// p는 여는 따옴표 - 성공 시 닫는 따옴표 다음으로 이동
+bool scanString(const char *&p, const char *end, std::string_view *content, bool *escaped)
+{
+    const char *start = ++p;
+    bool hasEscape = false;
+    while (p < end && *p != '"') {
+        if (*p == '\\') {
+            hasEscape = true;
+            ++p;
+        }
+        ++p;
+    }
+    if (p >= end)
+        return false;
+    *content = std::string_view(start, static_cast<size_t>(p - start));
+    *escaped = hasEscape;
+    ++p;
+    return true;
+}
+
+// 객체/배열을 괄호 짝만 맞춰 건너뜀 (문자열 안의 괄호는 무시)
+bool skipContainer(const char *&p, const char *end)
+{
+    int depth = 0;
+    while (p < end) {
+        const char c = *p;
+        if (c == '"') {
+            std::string_view ignored;
+            bool escaped = false;
+            if (!scanString(p, end, &ignored, &escaped))
+                return false;
+            continue;
+        }
+        ++p;
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+bool scanLiteral(const char *&p, const char *end)
+{
+    const char *start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t')
+        ++p;
+    return p > start;
+}
+
+void appendUtf8(char *&out, quint32 codePoint)
+{
+    if (codePoint < 0x80) {
+        *out++ = static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+bool readHex4(const char *p, const char *end, quint32 *value)
+{
+    if (end - p < 4)
+        return false;
+    quint32 result = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = p[i];
+        result <<= 4;
+        if (c >= '0' && c <= '9') result |= quint32(c - '0');
+        else if (c >= 'a' && c <= 'f') result |= quint32(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') result |= quint32(c - 'A' + 10);
+        else return false;
+    }
+    *value = result;
+    return true;
+}
+
+} // namespace
+
+EventFrame::EventFrame(std::pmr::memory_resource *arena)
+    : arena(arena), fieldList(arena)
+{
+    fieldList.reserve(ReservedFields);
+}
+
+bool EventFrame::parse(std::string_view json)
+{
+    fieldList.clear();
+    const char *p = json.data();
+    const char *end = p + json.size();
+    skipSpace(p, end);
+    if (p >= end || *p != '{')
+        return false;
+    return parseObject(p, end, Scope::Top);
+}
+
+bool EventFrame::parseObject(const char *&p, const char *end, Scope scope)
+{
+    ++p;  // '{'
+    skipSpace(p, end);
+    if (p < end && *p == '}') {
+        ++p;
+        return true;
+    }
+
+    while (p < end) {
+        Field field;
+        field.scope = scope;
+
+        bool keyEscaped = false;
+        if (*p != '"' || !scanString(p, end, &field.key, &keyEscaped))
+            return false;
+        skipSpace(p, end);
+        if (p >= end || *p != ':')
+            return false;
+        ++p;
+        skipSpace(p, end);
+        if (p >= end)
+            return false;
+
+        const char *valueStart = p;
+        switch (*p) {
+        case '"':
+            field.kind = Kind::String;
+            if (!scanString(p, end, &field.value, &field.escaped))
+                return false;
+            break;
+        case '{':
+            field.kind = Kind::Object;
+            if (scope == Scope::Top && field.key == "data") {
+                // data 객체는 한 단계 풀어서 필드 목록에 - 원문 범위는 끝난 뒤 채움
+                const size_t index = fieldList.size();
+                fieldList.push_back(field);
+                if (!parseObject(p, end, Scope::Data))
+                    return false;
+                fieldList[index].value = std::string_view(valueStart, static_cast<size_t>(p - valueStart));
+                skipSpace(p, end);
+                if (p < end && *p == ',') {
+                    ++p;
+                    skipSpace(p, end);
+                    continue;
+                }
+                if (p < end && *p == '}') {
+                    ++p;
+                    return true;
+                }
+                return false;
+            }
+            if (!skipContainer(p, end))
+                return false;
+            field.value = std::string_view(valueStart, static_cast<size_t>(p - valueStart));
+            break;
+        case '[':
+            field.kind = Kind::Array;
+            if (!skipContainer(p, end))
+                return false;
+            field.value = std::string_view(valueStart, static_cast<size_t>(p - valueStart));
+            break;
+        default:
+            if (!scanLiteral(p, end))
+                return false;
+            field.value = std::string_view(valueStart, static_cast<size_t>(p - valueStart));
+            if (field.value == "true" || field.value == "false")
+                field.kind = Kind::Bool;
+            else if (field.value == "null")
+                field.kind = Kind::Null;
+            else
+                field.kind = Kind::Number;
+            break;
+        }
+        fieldList.push_back(field);
+
+        skipSpace(p, end);
+        if (p < end && *p == ',') {
+            ++p;
+            skipSpace(p, end);
+            continue;
+        }
+        if (p < end && *p == '}') {
+            ++p;
+            return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+const EventFrame::Field *EventFrame::find(std::string_view key, Scope scope) const
+{
+    for (const Field &field : fieldList) {
+        if (field.scope == scope && field.key == key)
+            return &field;
+    }
+    return nullptr;
+}
+
+std::string_view EventFrame::text(std::string_view key, Scope scope) const
+{
+    std::string_view value;
+    const Field *field = find(key, scope);
+    return field && readString(*field, &value) ? value : std::string_view();
+}
+
+qint64 EventFrame::integer(std::string_view key, Scope scope) const
+{
+    qint64 value = 0;
+    const Field *field = find(key, scope);
+    return field && readInteger(*field, &value) ? value : 0;
+}
+
+double EventFrame::number(std::string_view key, Scope scope) const
+{
+    double value = 0.0;
+    const Field *field = find(key, scope);
+    return field && readNumber(*field, &value) ? value : 0.0;
+}
+
+bool EventFrame::boolean(std::string_view key, Scope scope) const
+{
+    bool value = false;
+    const Field *field = find(key, scope);
+    return field && readBool(*field, &value) && value;
+}
+
+bool EventFrame::readString(const Field &field, std::string_view *value) const
+{
+    if (field.kind != Kind::String)
+        return false;
+    *value = field.escaped ? unescape(field.value) : field.value;
+    return true;
+}
+
+bool EventFrame::readInteger(const Field &field, qint64 *value) const
+{
+    if (field.kind != Kind::Number)
+        return false;
+
+    const char *first = field.value.data();
+    const char *last = first + field.value.size();
+    const auto result = std::from_chars(first, last, *value);
+    if (result.ec == std::errc() && result.ptr == last)
+        return true;
+
+    // 3.0 같은 실수 표기는 정수값일 때만 허용
+    double number = 0.0;
+    if (!readNumber(field, &number) || number != static_cast<double>(static_cast<qint64>(number)))
+        return false;
+    *value = static_cast<qint64>(number);
+    return true;
+}
+
+bool EventFrame::readNumber(const Field &field, double *value) const
+{
+    if (field.kind != Kind::Number)
+        return false;
+    // fromRawData - 복사 없이 원본 바이트를 그대로 사용
+    bool ok = false;
+    *value = QByteArray::fromRawData(field.value.data(), static_cast<qsizetype>(field.value.size())).toDouble(&ok);
+    return ok;
+}
+
+bool EventFrame::readBool(const Field &field, bool *value) const
+{
+    if (field.kind != Kind::Bool)
+        return false;
+    *value = field.value == "true";
+    return true;
+}
+
+bool EventFrame::nextElement(std::string_view array, size_t *offset, std::string_view *element)
+{
+    const char *begin = array.data();
+    const char *end = begin + array.size();
+    const char *p = begin + *offset;
+    if (*offset == 0) {
+        skipSpace(p, end);
+        if (p >= end || *p != '[')
+            return false;
+        ++p;
+    }
+    skipSpace(p, end);
+    if (p < end && *p == ',') {
+        ++p;
+        skipSpace(p, end);
+    }
+    if (p >= end || *p == ']')
+        return false;
+
+    const char *start = p;
+    if (*p == '{' || *p == '[') {
+        if (!skipContainer(p, end))
+            return false;
+    } else if (*p == '"') {
+        std::string_view ignored;
+        bool escaped = false;
+        if (!scanString(p, end, &ignored, &escaped))
+            return false;
+    } else if (!scanLiteral(p, end)) {
+        return false;
+    }
+
+    *element = std::string_view(start, static_cast<size_t>(p - start));
+    *offset = static_cast<size_t>(p - begin);
+    return true;
+}
+
+std::string_view EventFrame::unescape(std::string_view raw) const
+{
+    // 풀어 쓴 결과는 원문보다 길지 않음 (\uXXXX 6바이트 → UTF-8 최대 4바이트)
+    char *buffer = static_cast<char *>(arena->allocate(raw.size(), 1));
+    char *out = buffer;
+    const char *p = raw.data();
+    const char *end = p + raw.size();
+
+    while (p < end) {
+        if (*p != '\\') {
+            *out++ = *p++;
+            continue;
+        }
+        if (++p >= end)
+            break;
+        const char c = *p++;
+        switch (c) {
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u': {
+            quint32 codePoint = 0;
+            if (!readHex4(p, end, &codePoint))
+                break;
+            p += 4;
+            // 서로게이트 쌍 (😀 등)
+            quint32 low = 0;
+            if (codePoint >= 0xD800 && codePoint < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u'
+                && readHex4(p + 2, end, &low) && low >= 0xDC00 && low < 0xE000) {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                p += 6;
+            }
+            appendUtf8(out, codePoint);
+            break;
+        }
+        default:  // \" \\ \/
+            *out++ = c;
+            break;
+        }
+    }
+    return std::string_view(buffer, static_cast<size_t>(out - buffer));
+}
+
+std::string_view EventFrame::peekType(std::string_view json)
+{
+    const char *p = json.data();
+    const char *end = p + json.size();
+    skipSpace(p, end);
+    if (p >= end || *p != '{')
+        return std::string_view();
+    ++p;
+
+    while (p < end) {
+        skipSpace(p, end);
+        std::string_view key;
+        bool escaped = false;
+        if (p >= end || *p != '"' || !scanString(p, end, &key, &escaped))
+            return std::string_view();
+        skipSpace(p, end);
+        if (p >= end || *p != ':')
+            return std::string_view();
+        ++p;
+        skipSpace(p, end);
+        if (p >= end)
+            return std::string_view();
+
+        if (*p == '"') {
+            std::string_view value;
+            if (!scanString(p, end, &value, &escaped))
+                return std::string_view();
+            if (key == "type")
+                return escaped ? std::string_view() : value;
+        } else if (*p == '{' || *p == '[') {
+            if (!skipContainer(p, end))
+                return std::string_view();
+        } else if (!scanLiteral(p, end)) {
+            return std::string_view();
+        }
+
+        skipSpace(p, end);
+        if (p >= end || *p != ',')
+            return std::string_view();
+        ++p;
+    }
+    return std::string_view();
+}
@@ -0,0 +1,71 @@
+#ifndef EVENTFRAME_H
+#define EVENTFRAME_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// 카메라 이벤트 1건(UTF-8 JSON)을 제자리에서 토큰화
+// - 최상위 필드 + "data" 객체 한 단계만 필드 목록으로 (더 깊은 값은 원문 범위만)
+// - 문자열은 원본 버퍼를 가리키는 뷰 - 이스케이프가 있을 때만 아레나에 풀어 씀
+// - 필드 목록/풀어 쓴 문자열은 호출자가 준 아레나(배치 단위 monotonic 버퍼)에 올라감
+// 뷰는 원본 버퍼와 아레나가 살아 있는 동안만 유효 - 남길 값은 QString 등으로 복사
+class EventFrame
+{
+public:
+    enum class Scope : quint8 { Top, Data };
+    enum class Kind : quint8 { Null, Bool, Number, String, Object, Array };
+
+    struct Field {
+        std::string_view key;
+        std::string_view value;  // 문자열은 따옴표 안쪽, 객체/배열은 괄호 포함 원문
+        Kind kind = Kind::Null;
+        Scope scope = Scope::Top;
+        bool escaped = false;    // 문자열에 역슬래시 이스케이프 포함
+    };
+
+    explicit EventFrame(std::pmr::memory_resource *arena);
+
+    bool parse(std::string_view json);  // 최상위가 객체가 아니거나 문법 오류면 false
+
+    const Field *find(std::string_view key, Scope scope = Scope::Top) const;
+    std::string_view type() const { return text("type"); }
+
+    std::string_view text(std::string_view key, Scope scope = Scope::Top) const;
+    qint64 integer(std::string_view key, Scope scope = Scope::Top) const;
+    double number(std::string_view key, Scope scope = Scope::Top) const;
+    bool boolean(std::string_view key, Scope scope = Scope::Top) const;
+
+    // 필드 값 읽기 - 종류가 맞지 않으면 false (스키마 디코더가 불일치로 집계)
+    bool readString(const Field &field, std::string_view *value) const;
+    bool readInteger(const Field &field, qint64 *value) const;
+    bool readNumber(const Field &field, double *value) const;
+    bool readBool(const Field &field, bool *value) const;
+
+    // 배열 원문("[...]")의 다음 원소 - offset은 0에서 시작, 원소가 없으면 false
+    static bool nextElement(std::string_view array, size_t *offset, std::string_view *element);
+
+    const std::pmr::vector<Field> &fields() const { return fieldList; }
+
+    // 토큰화 없이 최상위 "type" 값만 (수신 큐 우선순위 결정용, 이스케이프 없는 값만)
+    static std::string_view peekType(std::string_view json);
+
+    static QString toQString(std::string_view text)
+    {
+        return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+    }
+
+    static constexpr int ReservedFields = 24;  // 이벤트 한 건 필드 수 - 아레나에서 재할당 없도록
+
+private:
+    bool parseObject(const char *&p, const char *end, Scope scope);
+    std::string_view unescape(std::string_view raw) const;
+
+    std::pmr::memory_resource *arena;
+    std::pmr::vector<Field> fieldList;
+};
+
+#endif // EVENTFRAME_H
@@ -0,0 +1,239 @@
+#include "eventgateway.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+EventGateway::EventGateway(QObject *parent)
+    : QObject(parent)
+{
+    server = new QWebSocketServer("SSN Event Gateway", QWebSocketServer::NonSecureMode, this);
+    connect(server, &QWebSocketServer::newConnection, this, &EventGateway::onNewClient);
+
+    // 카메라는 자가서명 인증서 - 클라이언트와 동일하게 지문 고정으로 확인 (업스트림 연결마다 지문 확인, 불일치면 끊음)
+    cameraTls = new CameraTls(this);
+    connect(cameraTls, &CameraTls::pinMismatch, this, [](const QString &host) {
+        qWarning() << "[Gateway] 인증서 불일치 - 카메라 연결 거부:" << host;
+    });
+}
+
+EventGateway::~EventGateway()
+{
+    for (Upstream &upstream : upstreams) {
+        upstream.socket->disconnect(this);
+        upstream.socket->close();
+    }
+}
+
+bool EventGateway::listen(const QHostAddress &address, quint16 port)
+{
+    if (!server->listen(address, port)) {
+        qWarning() << "[Gateway] 수신 대기 실패:" << server->errorString();
+        return false;
+    }
+    qDebug() << "[Gateway] 대기 중:" << QString("ws://%1:%2").arg(address.toString()).arg(server->serverPort());
+    return true;
+}
+
+void EventGateway::addCamera(const QString &cameraId, const QUrl &url, const QString &fingerprint)
+{
+    if (cameraId.isEmpty() || !url.isValid())
+        return;
+    if (cameraId.contains('"') || cameraId.contains('\\')) {
+        qWarning() << "[Gateway] 사용할 수 없는 카메라 id:" << cameraId;
+        return;  // 프레임을 문자열로 조립하므로 따옴표 불가
+    }
+
+    if (auto it = upstreams.constFind(cameraId); it != upstreams.constEnd()) {
+        if (it->url == url)
+            return;
+        it->socket->disconnect(this);
+        it->socket->deleteLater();
+        upstreams.remove(cameraId);
+    }
+
+    Upstream upstream;
+    upstream.url = url;
+    upstream.socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    upstreams.insert(cameraId, upstream);
+
+    QWebSocket *socket = upstream.socket;
+    if (url.scheme() == QLatin1String("wss")) {
+        // 레지스트리(또는 먼저 받은 구독)의 지문이 우선 - 인증 없는 로컬 구독이 고정 지문을 바꾸지 못하게
+        if (!fingerprint.isEmpty() && cameraTls->pin(url.host()).isEmpty())
+            cameraTls->setPin(url.host(), fingerprint);
+        cameraTls->attach(socket, url.host());
+    }
+    connect(socket, &QWebSocket::connected, this, [this, cameraId, socket]() {
+        if (socket->state() != QAbstractSocket::ConnectedState)
+            return;  // 인증서 지문 불일치로 CameraTls가 이미 끊은 연결 (백오프 유지)
+        Upstream &up = upstreams[cameraId];
+        up.connected = true;
+        up.backoffMs = 1000;
+        qDebug() << "[Gateway] 카메라 연결됨:" << cameraId;
+        broadcast(statusFrame(cameraId));
+    });
+    connect(socket, &QWebSocket::disconnected, this, [this, cameraId]() {
+        Upstream &up = upstreams[cameraId];
+        const bool wasConnected = up.connected;
+        up.connected = false;
+        if (wasConnected)
+            broadcast(statusFrame(cameraId));
+        scheduleReconnect(cameraId);
+    });
+    connect(socket, &QWebSocket::errorOccurred, this, [this, cameraId, socket](QAbstractSocket::SocketError) {
+        // 연결 실패는 disconnected 없이 끝날 수 있음
+        if (socket->state() == QAbstractSocket::UnconnectedState)
+            scheduleReconnect(cameraId);
+    });
+    connect(socket, &QWebSocket::textMessageReceived, this, [this, cameraId](const QString &message) {
+        onUpstreamMessage(cameraId, message);
+    });
+
+    openUpstream(socket, url);
+}
+
+void EventGateway::removeCamera(const QString &cameraId)
+{
+    auto it = upstreams.find(cameraId);
+    if (it == upstreams.end())
+        return;
+
+    // 재연결 타이머는 소켓을 컨텍스트로 잡고 있어 소켓과 함께 취소됨
+    QWebSocket *socket = it->socket;
+    socket->disconnect(this);
+    socket->close();
+    socket->deleteLater();
+    upstreams.erase(it);
+    qDebug() << "[Gateway] 카메라 구독 해제:" << cameraId;
+    broadcast(statusFrame(cameraId));  // 없는 id는 connected:false
+}
+
+void EventGateway::openUpstream(QWebSocket *socket, const QUrl &url)
+{
+    if (url.scheme() == QLatin1String("wss"))
+        cameraTls->applyConfiguration(socket, url.host());  // 재연결도 마지막 세션 티켓으로
+    socket->open(url);
+}
+
+void EventGateway::scheduleReconnect(const QString &cameraId)
+{
+    auto it = upstreams.find(cameraId);
+    if (it == upstreams.end() || it->reconnectPending)
+        return;
+
+    it->reconnectPending = true;
+    const int delay = it->backoffMs;
+    it->backoffMs = qMin(it->backoffMs * 2, MaxBackoffMs);
+    QWebSocket *socket = it->socket;
+
+    QTimer::singleShot(delay, socket, [this, cameraId, socket]() {
+        auto up = upstreams.find(cameraId);
+        if (up == upstreams.end() || up->socket != socket)
+            return;
+        up->reconnectPending = false;
+        if (up->connected)
+            return;
+        openUpstream(socket, up->url);
+    });
+}
+
+void EventGateway::onNewClient()
+{
+    while (QWebSocket *client = server->nextPendingConnection()) {
+        clients.append(client);
+        qDebug() << "[Gateway] 클라이언트 연결:" << client->peerAddress().toString();
+
+        connect(client, &QWebSocket::textMessageReceived, this, [this, client](const QString &message) {
+            onClientMessage(client, message);
+        });
+        connect(client, &QWebSocket::disconnected, this, [this, client]() {
+            clients.removeOne(client);
+            client->deleteLater();
+        });
+
+        // 현재 카메라 연결 상태 전달
+        for (auto it = upstreams.constBegin(); it != upstreams.constEnd(); ++it)
+            client->sendTextMessage(statusFrame(it.key()));
+    }
+}
+
+void EventGateway::onClientMessage(QWebSocket *client, const QString &message)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    if (!doc.isObject()) {
+        qWarning() << "[Gateway] 클라이언트 메시지 파싱 실패";
+        return;
+    }
+    const QJsonObject obj = doc.object();
+
+    if (obj.value(QLatin1String("type")).toString() == QLatin1String("gateway_subscribe")) {
+        const QJsonArray cameras = obj.value(QLatin1String("cameras")).toArray();
+        for (const QJsonValue &val : cameras) {
+            const QJsonObject camera = val.toObject();
+            const QString id = camera.value(QLatin1String("camera")).toString();
+            const bool known = upstreams.contains(id);
+            addCamera(id, QUrl(camera.value(QLatin1String("url")).toString()),
+                      camera.value(QLatin1String("tls_fingerprint")).toString());
+            if (known)
+                client->sendTextMessage(statusFrame(id));
+        }
+        return;
+    }
+
+    if (obj.value(QLatin1String("type")).toString() == QLatin1String("gateway_unsubscribe")) {
+        const QJsonArray cameras = obj.value(QLatin1String("cameras")).toArray();
+        for (const QJsonValue &val : cameras)
+            removeCamera(val.toString());
+        return;
+    }
+
+    const QString cameraId = obj.value(QLatin1String("camera")).toString();
+    auto it = upstreams.constFind(cameraId);
+    if (it == upstreams.constEnd() || !it->connected) {
+        qWarning() << "[Gateway] 카메라 비연결 상태 - 전달 안 함:" << cameraId;
+        return;
+    }
+
+    const QJsonObject payload = obj.value(QLatin1String("msg")).toObject();
+    if (!isForwardableCommand(payload)) {
+        qWarning() << "[Gateway] 허용되지 않은 명령 - 전달 안 함:" << cameraId
+                   << payload.value(QLatin1String("type")).toString();
+        return;
+    }
+    it->socket->sendTextMessage(QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact)));
+}
+
+bool EventGateway::isForwardableCommand(const QJsonObject &payload)
+{
+    // 로컬 포트는 인증 없이 열려 있음 - 클라이언트가 실제로 보내는 명령만 카메라로 넘김
+    const QString type = payload.value(QLatin1String("type")).toString();
+    return type == QLatin1String("set_mode") || type == QLatin1String("request_stm_status");
+}
+
+void EventGateway::onUpstreamMessage(const QString &cameraId, const QString &message)
+{
+    if (clients.isEmpty())
+        return;
+
+    // 카메라 원본 JSON은 다시 파싱하지 않고 그대로 감쌈
+    const QString frame = QLatin1String("{\"camera\":\"") + cameraId + QLatin1String("\",\"msg\":")
+                          + message + QLatin1Char('}');
+    broadcast(frame);
+}
+
+void EventGateway::broadcast(const QString &frame)
+{
+    for (QWebSocket *client : std::as_const(clients))
+        client->sendTextMessage(frame);
+}
+
+QString EventGateway::statusFrame(const QString &cameraId) const
+{
+    QJsonObject status;
+    status["type"] = "gateway_status";
+    status["camera"] = cameraId;
+    status["connected"] = upstreams.value(cameraId).connected;
+    return QString::fromUtf8(QJsonDocument(status).toJson(QJsonDocument::Compact));
+}
@@ -0,0 +1,67 @@
+#ifndef EVENTGATEWAY_H
+#define EVENTGATEWAY_H
+
+#include "cameratls.h"
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QTimer>
+#include <QUrl>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+// 이벤트 게이트웨이 - 카메라 WebSocket들을 대신 연결하고 로컬 클라이언트에는 하나의 연결로 전달
+//
+// 카메라 → 클라이언트: {"camera":"<id>","msg":<카메라 원본 JSON>}
+// 클라이언트 → 카메라: {"camera":"<id>","msg":{...}}  (msg.type은 set_mode / request_stm_status만 전달)
+// 연결 상태:          {"type":"gateway_status","camera":"<id>","connected":true|false}
+// 구독:              {"type":"gateway_subscribe","cameras":[{"camera":"<id>","url":"wss://...","tls_fingerprint":"<hex>"}]}
+// 구독 해제:          {"type":"gateway_unsubscribe","cameras":["<id>",...]}  (업스트림을 닫음 - 모든 클라이언트에 connected:false)
+// wss 업스트림은 클라이언트와 같은 CameraTls로 인증서 지문 고정 (레지스트리 지문 우선, 불일치 시 연결 거부)
+class EventGateway : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventGateway(QObject *parent = nullptr);
+    ~EventGateway();
+
+    bool listen(const QHostAddress &address, quint16 port);
+    quint16 serverPort() const { return server->serverPort(); }
+
+    // 이미 있는 id면 URL이 같을 때 무시
+    // fingerprint: 고정할 인증서 지문 (이미 고정된 호스트는 바꾸지 않음, 비어 있으면 최초 연결 때 고정)
+    void addCamera(const QString &cameraId, const QUrl &url, const QString &fingerprint = QString());
+    void removeCamera(const QString &cameraId);  // 업스트림 연결 종료 + 해제
+    int cameraCount() const { return static_cast<int>(upstreams.size()); }
+
+private:
+    struct Upstream {
+        QWebSocket *socket = nullptr;
+        QUrl url;
+        bool connected = false;
+        bool reconnectPending = false;
+        int backoffMs = 1000;
+    };
+
+    void onNewClient();
+    void onClientMessage(QWebSocket *client, const QString &message);
+    static bool isForwardableCommand(const QJsonObject &payload);
+    void onUpstreamMessage(const QString &cameraId, const QString &message);
+    void openUpstream(QWebSocket *socket, const QUrl &url);
+    void scheduleReconnect(const QString &cameraId);
+    void broadcast(const QString &frame);
+    QString statusFrame(const QString &cameraId) const;
+
+    QWebSocketServer *server;
+    QHash<QString, Upstream> upstreams;   // 카메라 id(IP) → 업스트림 연결
+    QList<QWebSocket*> clients;
+    CameraTls *cameraTls;                 // 모든 업스트림이 공유 (호스트별 지문 + 세션 티켓)
+
+    static constexpr int MaxBackoffMs = 30000;
+};
+
+#endif // EVENTGATEWAY_H
@@ -0,0 +1,122 @@
+#include "eventrecorder.h"
+
+#include <QDateTime>
+#include <QtEndian>
+#include <QDebug>
+
+EventRecorder::EventRecorder(QObject *parent)
+    : QObject(parent)
+{
+    flushTimer.setInterval(FlushIntervalMs);
+    connect(&flushTimer, &QTimer::timeout, this, &EventRecorder::flush);
+}
+
+EventRecorder::~EventRecorder()
+{
+    close();
+}
+
+bool EventRecorder::open(const QString &path)
+{
+    close();
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[Record] 파일 열기 실패:" << path << file.errorString();
+        return false;
+    }
+
+    char header[EventRecordFormat::HeaderSize];
+    memcpy(header, EventRecordFormat::Magic, sizeof(EventRecordFormat::Magic));
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), header + sizeof(EventRecordFormat::Magic));
+    file.write(header, sizeof(header));
+
+    cameraIndex.clear();
+    buffer.clear();
+    buffer.reserve(FlushBytes * 2);
+    frameCount = 0;
+    bytesWritten = sizeof(header);
+    lastFrameUs = 0;
+    clock.start();
+    flushTimer.start();
+
+    qDebug() << "[Record] 이벤트 기록 시작:" << path;
+    return true;
+}
+
+void EventRecorder::close()
+{
+    if (!file.isOpen())
+        return;
+
+    flush();
+    flushTimer.stop();
+    file.close();
+    qDebug() << "[Record] 기록 종료 - 프레임" << frameCount << "개," << bytesWritten << "바이트";
+}
+
+void EventRecorder::record(const QString &ip, const QByteArray &message)
+{
+    if (!file.isOpen())
+        return;
+
+    auto it = cameraIndex.constFind(ip);
+    if (it == cameraIndex.constEnd()) {
+        const QByteArray ipUtf8 = ip.toUtf8();
+        buffer.append(char(EventRecordFormat::Camera));
+        appendVarint(quint64(ipUtf8.size()));
+        buffer.append(ipUtf8);
+        it = cameraIndex.insert(ip, quint32(cameraIndex.size()));
+    }
+
+    const qint64 nowUs = clock.nsecsElapsed() / 1000;
+    buffer.append(char(EventRecordFormat::Frame));
+    appendVarint(it.value());
+    appendVarint(quint64(nowUs - lastFrameUs));
+    appendVarint(quint64(message.size()));
+    buffer.append(message);
+    lastFrameUs = nowUs;
+    ++frameCount;
+
+    if (buffer.size() >= FlushBytes)
+        flush();
+}
+
+void EventRecorder::flush()
+{
+    if (buffer.isEmpty() || !file.isOpen())
+        return;
+
+    const qint64 written = file.write(buffer);
+    if (written != buffer.size()) {
+        qWarning() << "[Record] 쓰기 실패 - 기록 중단:" << file.errorString();
+        buffer.clear();
+        flushTimer.stop();
+        file.close();
+        return;
+    }
+    file.flush();
+    bytesWritten += quint64(written);
+    buffer.clear();
+}
+
+void EventRecorder::appendVarint(quint64 value)
+{
+    // LEB128 - 7비트씩, 상위 비트는 다음 바이트 존재 표시
+    while (value >= 0x80) {
+        buffer.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.append(char(value));
+}
+
+QString EventRecorder::statsText() const
+{
+    if (!file.isOpen())
+        return "기록 안 함";
+    return QString("기록 중: %1 | 프레임 %2개 | 카메라 %3대 | %4 KB")
+        .arg(file.fileName())
+        .arg(frameCount)
+        .arg(cameraIndex.size())
+        .arg((bytesWritten + quint64(buffer.size())) / 1024);
+}
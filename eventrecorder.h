@@ -0,0 +1,59 @@
+#ifndef EVENTRECORDER_H
+#define EVENTRECORDER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QTimer>
+
+// 카메라 이벤트 기록 파일 (.ssnrec)
+//
+//   헤더   "SSNREC1\0" + 기록 시작 시각 (int64 LE, epoch ms)
+//   카메라 [0x01] 길이(varint) IP(UTF-8)              - 처음 등장할 때 한 번, 순서대로 번호 부여
+//   프레임 [0x02] 카메라 번호(varint) 이전 프레임과의 간격 us(varint) 길이(varint) 원본 메시지(UTF-8)
+//
+// 수신 시각은 단조 시계 기준이라 재생 시 간격이 그대로 재현됨
+namespace EventRecordFormat {
+constexpr char Magic[8] = { 'S', 'S', 'N', 'R', 'E', 'C', '1', '\0' };
+constexpr int HeaderSize = 16;
+enum Kind : quint8 { Camera = 0x01, Frame = 0x02 };
+}
+
+class EventRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventRecorder(QObject *parent = nullptr);
+    ~EventRecorder();
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    // 수신 직후 원본 메시지 그대로 기록 (버퍼에 모아 주기적으로 파일에 씀)
+    void record(const QString &ip, const QByteArray &message);
+
+    QString statsText() const;  // 진단 창 표시용
+
+private:
+    void flush();
+    void appendVarint(quint64 value);
+
+    QFile file;
+    QByteArray buffer;
+    QHash<QString, quint32> cameraIndex;  // IP → 파일 내 카메라 번호
+    QElapsedTimer clock;
+    qint64 lastFrameUs = 0;
+    QTimer flushTimer;
+
+    quint64 frameCount = 0;
+    quint64 bytesWritten = 0;
+
+    static constexpr int FlushBytes = 64 * 1024;
+    static constexpr int FlushIntervalMs = 1000;  // 비정상 종료 시 잃는 구간 상한
+};
+
+#endif // EVENTRECORDER_H
@@ -0,0 +1,151 @@
+#include "eventreplayer.h"
+#include "eventrecorder.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+
+bool readVarint(const QByteArray &data, qsizetype &pos, quint64 &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+        const quint8 byte = static_cast<quint8>(data.at(pos++));
+        value |= quint64(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+EventReplayer::EventReplayer(QObject *parent)
+    : QObject(parent)
+{
+    tickTimer.setSingleShot(true);
+    tickTimer.setTimerType(Qt::PreciseTimer);
+    connect(&tickTimer, &QTimer::timeout, this, &EventReplayer::emitDue);
+}
+
+bool EventReplayer::load(const QString &path)
+{
+    stop();
+    frames.clear();
+    cameraIps.clear();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[Replay] 파일 열기 실패:" << path << file.errorString();
+        return false;
+    }
+    data = file.readAll();
+    fileName = path;
+
+    if (data.size() < EventRecordFormat::HeaderSize
+        || memcmp(data.constData(), EventRecordFormat::Magic, sizeof(EventRecordFormat::Magic)) != 0) {
+        qWarning() << "[Replay] 기록 파일 형식 아님:" << path;
+        data.clear();
+        return false;
+    }
+    recordStartMs = qFromLittleEndian<qint64>(data.constData() + sizeof(EventRecordFormat::Magic));
+
+    qsizetype pos = EventRecordFormat::HeaderSize;
+    qint64 atUs = 0;
+    while (pos < data.size()) {
+        const quint8 kind = static_cast<quint8>(data.at(pos++));
+        quint64 a = 0, b = 0, length = 0;
+
+        if (kind == EventRecordFormat::Camera) {
+            if (!readVarint(data, pos, length) || pos + qsizetype(length) > data.size())
+                break;
+            cameraIps.append(QString::fromUtf8(data.constData() + pos, qsizetype(length)));
+            pos += qsizetype(length);
+        } else if (kind == EventRecordFormat::Frame) {
+            if (!readVarint(data, pos, a) || !readVarint(data, pos, b) || !readVarint(data, pos, length)
+                || pos + qsizetype(length) > data.size() || a >= quint64(cameraIps.size()))
+                break;
+            atUs += qint64(b);
+            frames.append({ atUs, qint32(pos), qint32(length), quint32(a) });
+            pos += qsizetype(length);
+        } else {
+            break;
+        }
+    }
+
+    // 기록 중 비정상 종료로 끝이 잘린 파일은 온전한 프레임까지만 재생
+    if (pos < data.size())
+        qWarning() << "[Replay] 손상된 레코드 - 오프셋" << pos << "이후 무시";
+
+    qDebug() << "[Replay] 로드:" << path << "프레임" << frames.size() << "개, 카메라" << cameraIps.size()
+             << "대, 기록 시각" << QDateTime::fromMSecsSinceEpoch(recordStartMs).toString(Qt::ISODate);
+    return true;
+}
+
+void EventReplayer::start(double speed)
+{
+    this->speed = speed;
+    next = 0;
+    elapsedMs = 0;
+    running = true;
+    clock.start();
+    emitDue();
+}
+
+void EventReplayer::stop()
+{
+    running = false;
+    tickTimer.stop();
+}
+
+void EventReplayer::emitDue()
+{
+    if (!running)
+        return;
+
+    const qint64 sliceStartMs = clock.elapsed();
+
+    while (next < frames.size()) {
+        const Frame &frame = frames.at(next);
+
+        if (speed > 0.0) {
+            const qint64 dueUs = qint64(frame.atUs / speed);
+            const qint64 nowUs = clock.nsecsElapsed() / 1000;
+            if (dueUs > nowUs) {
+                tickTimer.start(int(qMax<qint64>(0, (dueUs - nowUs) / 1000)));
+                return;
+            }
+        } else if (clock.elapsed() - sliceStartMs >= MaxSpeedBudgetMs) {
+            // 최대 속도 - 수신 큐/UI가 돌 수 있도록 잠깐 양보
+            tickTimer.start(0);
+            return;
+        }
+
+        ++next;
+        emit messageReceived(cameraIps.at(int(frame.camera)),
+                             QString::fromUtf8(data.constData() + frame.offset, frame.length));
+    }
+
+    running = false;
+    elapsedMs = clock.elapsed();
+    qDebug() << "[Replay] 완료 - 프레임" << frames.size() << "개," << elapsedMs << "ms";
+    emit finished(static_cast<int>(frames.size()), elapsedMs);
+}
+
+QString EventReplayer::statsText() const
+{
+    if (fileName.isEmpty())
+        return "재생 안 함";
+
+    const qint64 ms = running ? clock.elapsed() : elapsedMs;
+    const double rate = ms > 0 ? next * 1000.0 / ms : 0.0;
+    return QString("재생: %1 (%2) | %3 / %4 프레임 | %5 ms | %6 프레임/초")
+        .arg(fileName)
+        .arg(speed > 0.0 ? QString("%1배속").arg(speed) : QString("최대 속도"))
+        .arg(next)
+        .arg(frames.size())
+        .arg(ms)
+        .arg(rate, 0, 'f', 0);
+}
@@ -0,0 +1,59 @@
+#ifndef EVENTREPLAYER_H
+#define EVENTREPLAYER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+// EventRecorder 파일(.ssnrec)을 원래 수신 간격대로 다시 내보냄
+// speed 1 = 실시간, N = N배속, 0 = 최대 속도 (이벤트 루프는 주기적으로 양보)
+class EventReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventReplayer(QObject *parent = nullptr);
+
+    bool load(const QString &path);  // 파일 전체를 읽고 프레임 색인만 만듦 (메시지 복사 없음)
+    void start(double speed);
+    void stop();
+
+    QStringList cameras() const { return cameraIps; }
+    int frameCount() const { return static_cast<int>(frames.size()); }
+
+    QString statsText() const;  // 진단 창 표시용
+
+    static constexpr int MaxSpeedBudgetMs = 20;  // 최대 속도에서 한 번에 내보내는 시간
+
+signals:
+    void messageReceived(const QString &ip, const QString &message);
+    void finished(int frames, qint64 elapsedMs);
+
+private:
+    struct Frame {
+        qint64 atUs;       // 기록 시작 기준 수신 시각
+        qint32 offset;     // data 내 메시지 위치
+        qint32 length;
+        quint32 camera;
+    };
+
+    void emitDue();
+
+    QString fileName;
+    QByteArray data;
+    QStringList cameraIps;
+    QVector<Frame> frames;
+    qint64 recordStartMs = 0;
+
+    QTimer tickTimer;
+    QElapsedTimer clock;
+    double speed = 1.0;
+    int next = 0;
+    bool running = false;
+    qint64 elapsedMs = 0;
+};
+
+#endif // EVENTREPLAYER_H
@@ -0,0 +1,201 @@
+#include "exportdialog.h"
+#include "logstore.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QStandardPaths>
+#include <QVBoxLayout>
+
+ExportDialog::ExportDialog(const LogStore *logStore, QWidget *parent)
+    : QDialog(parent), logStore(logStore)
+{
+    setupUI();
+    setWindowTitle("로그 내보내기");
+    setMinimumWidth(480);
+    setModal(true);
+
+    connect(&exporter, &LogExporter::progress, this, &ExportDialog::onProgress);
+    connect(&exporter, &LogExporter::finished, this, &ExportDialog::onFinished);
+}
+
+void ExportDialog::setupUI()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+
+    rangeCheckBox = new QCheckBox("기간 지정");
+    fromEdit = new QDateTimeEdit(now.addDays(-1));
+    toEdit = new QDateTimeEdit(now);
+    for (QDateTimeEdit *edit : { fromEdit, toEdit }) {
+        edit->setDisplayFormat("yyyy-MM-dd HH:mm");
+        edit->setCalendarPopup(true);
+        edit->setEnabled(false);
+    }
+    connect(rangeCheckBox, &QCheckBox::toggled, fromEdit, &QDateTimeEdit::setEnabled);
+    connect(rangeCheckBox, &QCheckBox::toggled, toEdit, &QDateTimeEdit::setEnabled);
+
+    QHBoxLayout *rangeLayout = new QHBoxLayout();
+    rangeLayout->addWidget(rangeCheckBox);
+    rangeLayout->addWidget(fromEdit);
+    rangeLayout->addWidget(new QLabel("~"));
+    rangeLayout->addWidget(toEdit);
+
+    // 카메라/기능 콤보 데이터 = LogStore 카메라 id / LogFunction 값 (-1 = 전체)
+    cameraComboBox = new QComboBox();
+    cameraComboBox->addItem("전체", -1);
+    for (int id = 0; logStore && id < logStore->cameraCount(); ++id)
+        cameraComboBox->addItem(logStore->cameraName(quint16(id)), id);
+
+    functionComboBox = new QComboBox();
+    functionComboBox->addItem("전체", -1);
+    for (int function = 0; function <= int(LogFunction::Health); ++function)
+        functionComboBox->addItem(LogStore::functionText(static_cast<LogFunction>(function)), function);
+
+    formatComboBox = new QComboBox();
+    formatComboBox->addItem("CSV (.csv)", int(LogExporter::Format::Csv));
+    formatComboBox->addItem("열 형식 SSNCOL1 (.ssncol)", int(LogExporter::Format::Columnar));
+
+    const QString documents = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    pathEdit = new QLineEdit(QDir(documents).filePath(
+        QString("ssn_logs_%1.csv").arg(now.toString("yyyyMMdd_HHmmss"))));
+    QPushButton *browseButton = new QPushButton("찾아보기");
+    connect(browseButton, &QPushButton::clicked, this, &ExportDialog::onBrowseClicked);
+
+    // 형식을 바꾸면 확장자도 맞춤
+    connect(formatComboBox, &QComboBox::currentIndexChanged, this, [this]() {
+        const QFileInfo info(pathEdit->text());
+        const QString suffix = selectedFormat() == LogExporter::Format::Csv ? "csv" : "ssncol";
+        pathEdit->setText(info.dir().filePath(info.completeBaseName() + "." + suffix));
+    });
+
+    QHBoxLayout *pathLayout = new QHBoxLayout();
+    pathLayout->addWidget(pathEdit);
+    pathLayout->addWidget(browseButton);
+
+    QFormLayout *form = new QFormLayout();
+    form->addRow("기간", rangeLayout);
+    form->addRow("카메라", cameraComboBox);
+    form->addRow("기능", functionComboBox);
+    form->addRow("형식", formatComboBox);
+    form->addRow("파일", pathLayout);
+
+    progressBar = new QProgressBar();
+    progressBar->setRange(0, 1000);
+    progressBar->setValue(0);
+    statusLabel = new QLabel(QString("전체 로그 %1건").arg(logStore ? logStore->size() : 0));
+
+    exportButton = new QPushButton("내보내기");
+    cancelButton = new QPushButton("취소");
+    closeButton = new QPushButton("닫기");
+    cancelButton->setEnabled(false);
+    connect(exportButton, &QPushButton::clicked, this, &ExportDialog::onExportClicked);
+    connect(cancelButton, &QPushButton::clicked, &exporter, &LogExporter::cancel);
+    connect(closeButton, &QPushButton::clicked, this, &ExportDialog::reject);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(exportButton);
+    buttonLayout->addWidget(cancelButton);
+    buttonLayout->addWidget(closeButton);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(form);
+    mainLayout->addWidget(progressBar);
+    mainLayout->addWidget(statusLabel);
+    mainLayout->addLayout(buttonLayout);
+
+    setStyleSheet(R"(
+        QDialog { background-color: #2b2b2b; color: white; }
+        QLabel, QCheckBox { color: white; }
+        QPushButton {
+            background-color: #404040;
+            color: white;
+            border: 1px solid #555;
+            padding: 8px;
+            border-radius: 4px;
+            min-width: 80px;
+        }
+        QPushButton:hover { background-color: #505050; }
+        QPushButton:disabled { color: #888; }
+    )");
+}
+
+LogExporter::Format ExportDialog::selectedFormat() const
+{
+    return static_cast<LogExporter::Format>(formatComboBox->currentData().toInt());
+}
+
+void ExportDialog::onBrowseClicked()
+{
+    const QString filter = selectedFormat() == LogExporter::Format::Csv
+        ? QStringLiteral("CSV (*.csv)") : QStringLiteral("SSNCOL1 (*.ssncol)");
+    const QString path = QFileDialog::getSaveFileName(this, "내보낼 파일", pathEdit->text(), filter);
+    if (!path.isEmpty())
+        pathEdit->setText(path);
+}
+
+void ExportDialog::onExportClicked()
+{
+    if (!logStore)
+        return;
+    const QString path = pathEdit->text().trimmed();
+    if (path.isEmpty()) {
+        QMessageBox::warning(this, "로그 내보내기", "저장할 파일 경로를 입력하세요.");
+        return;
+    }
+
+    LogExporter::Filter filter;
+    if (rangeCheckBox->isChecked()) {
+        filter.fromMs = fromEdit->dateTime().toMSecsSinceEpoch();
+        filter.toMs = toEdit->dateTime().toMSecsSinceEpoch() + 59999;  // 분 단위 입력 - 끝 분 포함
+        if (filter.toMs < filter.fromMs) {
+            QMessageBox::warning(this, "로그 내보내기", "종료 시각이 시작 시각보다 빠릅니다.");
+            return;
+        }
+    }
+    filter.cameraId = cameraComboBox->currentData().toInt();
+    filter.function = functionComboBox->currentData().toInt();
+
+    if (!exporter.start(*logStore, filter, selectedFormat(), path))
+        return;
+    progressBar->setValue(0);
+    statusLabel->setText("내보내는 중...");
+    setRunning(true);
+}
+
+void ExportDialog::onProgress(qint64 written, qint64 total)
+{
+    progressBar->setValue(total > 0 ? int(written * 1000 / total) : 1000);
+    statusLabel->setText(QString("%1 / %2행 기록").arg(written).arg(total));
+}
+
+void ExportDialog::onFinished(bool ok, qint64 rows, const QString &message)
+{
+    Q_UNUSED(rows);
+    setRunning(false);
+    if (!ok)
+        progressBar->setValue(0);
+    statusLabel->setText(ok ? QString("✅ %1").arg(message) : QString("❌ %1").arg(message));
+}
+
+void ExportDialog::setRunning(bool running)
+{
+    exportButton->setEnabled(!running);
+    cancelButton->setEnabled(running);
+    for (QWidget *widget : std::initializer_list<QWidget *>{ rangeCheckBox, cameraComboBox, functionComboBox, formatComboBox, pathEdit })
+        widget->setEnabled(!running);
+    fromEdit->setEnabled(!running && rangeCheckBox->isChecked());
+    toEdit->setEnabled(!running && rangeCheckBox->isChecked());
+}
+
+void ExportDialog::reject()
+{
+    // 진행 중인 내보내기는 취소 - 부분 파일은 LogExporter가 남기지 않음 (소멸자에서 완료 대기)
+    if (exporter.isRunning())
+        exporter.cancel();
+    QDialog::reject();
+}
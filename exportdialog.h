@@ -0,0 +1,56 @@
+#ifndef EXPORTDIALOG_H
+#define EXPORTDIALOG_H
+
+#include "logexporter.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDateTimeEdit>
+#include <QDialog>
+#include <QLabel>
+#include <QLineEdit>
+#include <QProgressBar>
+#include <QPushButton>
+
+class LogStore;
+
+// 로그 내보내기 창 - 기간/카메라/기능 필터, CSV 또는 열 형식(SSNCOL1), 진행률 + 취소
+class ExportDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ExportDialog(const LogStore *logStore, QWidget *parent = nullptr);
+
+protected:
+    void reject() override;  // 진행 중이면 취소 후 닫힘
+
+private slots:
+    void onBrowseClicked();
+    void onExportClicked();
+    void onProgress(qint64 written, qint64 total);
+    void onFinished(bool ok, qint64 rows, const QString &message);
+
+private:
+    void setupUI();
+    void setRunning(bool running);
+    LogExporter::Format selectedFormat() const;
+
+    const LogStore *logStore;
+    LogExporter exporter;
+
+    QCheckBox *rangeCheckBox;
+    QDateTimeEdit *fromEdit;
+    QDateTimeEdit *toEdit;
+    QComboBox *cameraComboBox;
+    QComboBox *functionComboBox;
+    QComboBox *formatComboBox;
+    QLineEdit *pathEdit;
+    QProgressBar *progressBar;
+    QLabel *statusLabel;
+    QPushButton *exportButton;
+    QPushButton *cancelButton;
+    QPushButton *closeButton;
+};
+
+#endif // EXPORTDIALOG_H
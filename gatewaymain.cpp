@@ -0,0 +1,61 @@
+#include "eventgateway.h"
+#include "cameraregistry.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+// SSNGateway - 카메라 WebSocket을 모아 클라이언트에 하나의 로컬 연결로 제공
+//
+//   SSNGateway                                  # 클라이언트 카메라 레지스트리의 Pi 카메라 연결
+//   SSNGateway --camera 127.0.0.1=ws://127.0.0.1:9001/ws   # 시뮬레이터 등 임의 URL
+//
+// 클라이언트는 --gateway ws://127.0.0.1:8765 (또는 SSN_GATEWAY_URL) 로 실행
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // 클라이언트와 같은 이름 → 같은 앱 데이터 폴더(cameras.json)
+    app.setApplicationName("QtClientSSN Camera Monitoring System");
+    app.setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Smart SafetyNet 이벤트 게이트웨이");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption portOption({"p", "port"}, "클라이언트 수신 포트 (기본 8765)", "port", "8765");
+    QCommandLineOption cameraOption({"c", "camera"}, "카메라 id=WebSocket URL (여러 번 지정 가능)", "id=url");
+    QCommandLineOption registryOption("registry", "카메라 레지스트리 파일 경로", "path", CameraRegistry::filePath());
+    parser.addOption(portOption);
+    parser.addOption(cameraOption);
+    parser.addOption(registryOption);
+    parser.process(app);
+
+    EventGateway gateway;
+
+    const QStringList cameraArgs = parser.values(cameraOption);
+    if (!cameraArgs.isEmpty()) {
+        for (const QString &arg : cameraArgs) {
+            const int sep = arg.indexOf('=');
+            if (sep <= 0) {
+                qWarning() << "[Gateway] 잘못된 --camera 값:" << arg;
+                continue;
+            }
+            gateway.addCamera(arg.left(sep), QUrl(arg.mid(sep + 1)));
+        }
+    } else {
+        for (const CameraInfo &camera : CameraRegistry::load(parser.value(registryOption))) {
+            if (!camera.isOnvif())
+                gateway.addCamera(camera.ip, QUrl(QString("wss://%1:8443/ws").arg(camera.ip)), camera.tlsFingerprint);
+        }
+    }
+    qDebug() << "[Gateway] 카메라" << gateway.cameraCount() << "대";
+
+    bool ok = false;
+    const quint16 port = parser.value(portOption).toUShort(&ok);
+    if (!ok || !gateway.listen(QHostAddress::LocalHost, port))
+        return 1;
+
+    return app.exec();
+}
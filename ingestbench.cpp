@@ -0,0 +1,239 @@
+#include "ingestbench.h"
+#include "allocationcounter.h"
+#include "eventdispatcher.h"
+#include "eventframe.h"
+#include "logstore.h"
+#include "serverevents.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QVector>
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace {
+
+// 카메라 서버가 보내는 이벤트 종류별 1건씩 (감지 이미지 경로/시각 포함)
+const char *const SampleMessages[] = {
+    R"({"type":"new_detection","data":{"person_count":3,"helmet_count":2,"safety_vest_count":3,"avg_confidence":0.8734,"image_path":"../images/ppe_20250102_030405.jpg","timestamp":"2025-01-02 03:04:05"}})",
+    R"({"type":"new_blur","data":{"count":4,"timestamp":"2025-01-02 03:04:06"}})",
+    R"({"type":"anomaly_status","data":{"status":"detected","timestamp":"2025-01-02T03:04:07"}})",
+    R"({"type":"stm_status_update","data":{"temperature":24.5,"light":312,"buzzer_on":false,"led_on":true}})",
+    R"({"type":"new_fall","data":{"count":1,"timestamp":"2025-01-02 03:04:08"}})",
+};
+constexpr int SampleCount = int(sizeof(SampleMessages) / sizeof(SampleMessages[0]));
+constexpr int BatchSize = 32;  // IngestQueue 처리 한 턴과 비슷한 규모
+
+const QString CameraName = QStringLiteral("Bench");
+const QString CameraIp = QStringLiteral("10.0.0.1");
+
+struct PathResult {
+    double allocationsPerEvent = 0.0;
+    double microsPerEvent = 0.0;
+};
+
+// ---- 기존 경로 재현: toUtf8 → QJsonDocument → 타입 QString (큐 + 디스패치) → data QJsonObject → QString 필드
+
+qint64 legacyTimestamp(const QString &ts)
+{
+    if (ts.size() < 19)
+        return 0;
+    QString normalized = ts.left(19);
+    normalized[10] = QLatin1Char(' ');
+    const QDateTime dt = QDateTime::fromString(normalized, "yyyy-MM-dd HH:mm:ss");
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : 0;
+}
+
+void legacyIngest(const QString &message, LogStore &store, const QHash<QString, int> &typeIds, QSet<QString> &blurKeys)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    const QJsonObject obj = doc.object();
+    const QString queueType = obj.value(QLatin1String("type")).toString();  // 수신 큐 우선순위 조회
+    const int id = typeIds.value(obj.value(QLatin1String("type")).toString(), -1);
+    Q_UNUSED(queueType);
+
+    const QJsonObject data = obj.value(QLatin1String("data")).toObject();
+    LogEntry entry;
+    entry.cameraId = store.cameraId(CameraName, CameraIp);
+    const QString cameraKey = CameraName + QLatin1Char('\n') + CameraIp;  // 기존 cameraId 조회 키
+    Q_UNUSED(cameraKey);
+
+    switch (id) {
+    case 0: {
+        entry.personCount = toLogCount(data.value(QLatin1String("person_count")).toInt());
+        entry.helmetCount = toLogCount(data.value(QLatin1String("helmet_count")).toInt());
+        entry.vestCount = toLogCount(data.value(QLatin1String("safety_vest_count")).toInt());
+        entry.confidence = float(data.value(QLatin1String("avg_confidence")).toDouble());
+        const QString imagePath = data.value(QLatin1String("image_path")).toString();
+        const QString timestamp = data.value(QLatin1String("timestamp")).toString();
+        entry.sourceTimestampMs = legacyTimestamp(timestamp);
+        entry.imageId = store.internImage(imagePath);
+        break;
+    }
+    case 1:
+    case 4: {
+        entry.count = toLogCount(data.value(QLatin1String("count")).toInt());
+        const QString timestamp = data.value(QLatin1String("timestamp")).toString();
+        entry.sourceTimestampMs = legacyTimestamp(timestamp);
+        if (id == 1)
+            blurKeys.insert(CameraName + "_" + timestamp);
+        break;
+    }
+    case 2: {
+        const QString status = data.value(QLatin1String("status")).toString();
+        const QString timestamp = data.value(QLatin1String("timestamp")).toString();
+        entry.event = status == QLatin1String("detected") ? LogEvent::AnomalyDetected : LogEvent::AnomalyCleared;
+        break;
+    }
+    case 3:
+        entry.temperature = float(data.value(QLatin1String("temperature")).toDouble());
+        entry.light = toLogCount(data.value(QLatin1String("light")).toInt());
+        entry.buzzerOn = data.value(QLatin1String("buzzer_on")).toBool();
+        entry.ledOn = data.value(QLatin1String("led_on")).toBool();
+        break;
+    default:
+        break;
+    }
+    store.append(entry);
+}
+
+// ---- 현재 경로: toUtf8 한 번 → type만 훑어 우선순위 → 배치 아레나에서 토큰화 → 스키마 디코딩 → 남길 필드만 복사
+
+void registerArenaHandlers(EventDispatcher &dispatcher, LogStore &store, QSet<quint64> &blurKeys)
+{
+    auto entryFor = [&store]() {
+        LogEntry entry;
+        entry.cameraId = store.cameraId(CameraName, CameraIp);
+        return entry;
+    };
+
+    dispatcher.registerHandler<DetectionEvent>("new_detection", [&store, entryFor](const QString &, const DetectionEvent &event) {
+        LogEntry entry = entryFor();
+        entry.personCount = toLogCount(event.personCount);
+        entry.helmetCount = toLogCount(event.helmetCount);
+        entry.vestCount = toLogCount(event.vestCount);
+        entry.confidence = float(event.confidence);
+        entry.sourceTimestampMs = LogStore::parseServerTimestamp(event.timestamp);
+        entry.imageId = store.internImage(EventFrame::toQString(event.imagePath));
+        store.append(entry);
+    });
+    dispatcher.registerHandler<CountEvent>("new_blur", [&store, &blurKeys, entryFor](const QString &, const CountEvent &event) {
+        LogEntry entry = entryFor();
+        entry.count = toLogCount(event.count);
+        entry.sourceTimestampMs = LogStore::parseServerTimestamp(event.timestamp);
+        blurKeys.insert((quint64(entry.cameraId) << 48) ^ quint64(entry.sourceTimestampMs));
+        store.append(entry);
+    });
+    dispatcher.registerHandler<AnomalyEvent>("anomaly_status", [&store, entryFor](const QString &, const AnomalyEvent &event) {
+        LogEntry entry = entryFor();
+        entry.event = event.status == "detected" ? LogEvent::AnomalyDetected : LogEvent::AnomalyCleared;
+        store.append(entry);
+    });
+    dispatcher.registerHandler<StmStatusEvent>("stm_status_update", [&store, entryFor](const QString &, const StmStatusEvent &event) {
+        LogEntry entry = entryFor();
+        entry.temperature = float(event.temperature);
+        entry.light = toLogCount(event.light);
+        entry.buzzerOn = event.buzzerOn;
+        entry.ledOn = event.ledOn;
+        store.append(entry);
+    });
+    dispatcher.registerHandler<CountEvent>("new_fall", [&store, entryFor](const QString &, const CountEvent &event) {
+        LogEntry entry = entryFor();
+        entry.count = toLogCount(event.count);
+        entry.sourceTimestampMs = LogStore::parseServerTimestamp(event.timestamp);
+        store.append(entry);
+    });
+}
+
+template <typename Body>
+PathResult measure(int iterations, Body body)
+{
+    body(SampleCount);  // 정적 초기화/캐시 워밍업은 집계에서 제외
+
+    const quint64 before = AllocationCounter::count();
+    QElapsedTimer timer;
+    timer.start();
+    body(iterations);
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    PathResult result;
+    result.allocationsPerEvent = double(AllocationCounter::count() - before) / iterations;
+    result.microsPerEvent = elapsedNs / 1000.0 / iterations;
+    return result;
+}
+
+} // namespace
+
+namespace IngestBench {
+
+QString run(int iterations)
+{
+    iterations = qMax(iterations, SampleCount);
+
+    QVector<QString> messages;  // WebSocket이 넘겨주는 형태 (QString)
+    for (const char *sample : SampleMessages)
+        messages.append(QString::fromUtf8(sample));
+
+    // 기존 경로
+    LogStore legacyStore;
+    QSet<QString> legacyBlurKeys;
+    const QHash<QString, int> legacyTypes = {
+        { "new_detection", 0 }, { "new_blur", 1 }, { "anomaly_status", 2 }, { "stm_status_update", 3 }, { "new_fall", 4 }
+    };
+    const PathResult legacy = measure(iterations, [&](int count) {
+        for (int i = 0; i < count; ++i)
+            legacyIngest(messages.at(i % SampleCount), legacyStore, legacyTypes, legacyBlurKeys);
+    });
+
+    // 아레나 경로 (IngestQueue::enqueue + drain과 같은 순서)
+    LogStore arenaStore;
+    QSet<quint64> arenaBlurKeys;
+    EventDispatcher dispatcher;
+    registerArenaHandlers(dispatcher, arenaStore, arenaBlurKeys);
+    QHash<QByteArray, int> priorities = { { "new_detection", 1 }, { "new_blur", 2 } };
+    QVector<QByteArray> batch;
+    batch.reserve(BatchSize);
+    alignas(std::max_align_t) static std::byte arenaBuffer[16 * 1024];
+
+    const PathResult arena = measure(iterations, [&](int count) {
+        for (int first = 0; first < count; first += BatchSize) {
+            const int last = qMin(count, first + BatchSize);
+            for (int i = first; i < last; ++i) {
+                const QByteArray json = messages.at(i % SampleCount).toUtf8();
+                const std::string_view type = EventFrame::peekType(std::string_view(json.constData(), size_t(json.size())));
+                volatile int priority = priorities.value(QByteArray::fromRawData(type.data(), qsizetype(type.size())), 0);
+                Q_UNUSED(priority);
+                batch.append(json);
+            }
+
+            std::pmr::monotonic_buffer_resource arenaResource(arenaBuffer, sizeof(arenaBuffer));
+            EventFrame frame(&arenaResource);
+            for (const QByteArray &json : std::as_const(batch)) {
+                if (frame.parse(std::string_view(json.constData(), size_t(json.size()))))
+                    dispatcher.dispatch(CameraIp, frame);
+            }
+            batch.clear();
+        }
+    });
+
+    QString report = QString("수신 이벤트 %1건 (샘플 %2종, 배치 %3건) | 할당 집계: %4\n")
+                         .arg(iterations).arg(SampleCount).arg(BatchSize).arg(AllocationCounter::method());
+    auto line = [](const char *name, const PathResult &result) {
+        const QString allocations = AllocationCounter::enabled()
+            ? QString::number(result.allocationsPerEvent, 'f', 2) : QStringLiteral("-");
+        return QString("  %1: 할당 %2회/건 | %3 µs/건\n")
+            .arg(QString::fromUtf8(name), -22)
+            .arg(allocations)
+            .arg(result.microsPerEvent, 0, 'f', 2);
+    };
+    report += line("기존 (QJsonDocument)", legacy);
+    report += line("아레나 (EventFrame)", arena);
+    return report.trimmed();
+}
+
+} // namespace IngestBench
@@ -0,0 +1,15 @@
+#ifndef INGESTBENCH_H
+#define INGESTBENCH_H
+
+#include <QString>
+
+// --bench-ingest: 수신 이벤트 1건을 LogEntry로 만들기까지의 할당 횟수 / 시간 비교
+// 기존 경로(QJsonDocument + QJsonObject + QString 필드)를 그대로 재현한 것과 현재 아레나 경로를 같은 입력으로 측정
+// 할당 횟수는 -DSSN_COUNT_ALLOCATIONS=ON 빌드에서만 표시 (AllocationCounter)
+namespace IngestBench {
+
+QString run(int iterations);
+
+} // namespace IngestBench
+
+#endif // INGESTBENCH_H
@@ -0,0 +1,188 @@
+#include "ingestqueue.h"
+
+#include <QDebug>
+#include <QScopedValueRollback>
+
+IngestQueue::IngestQueue(Consumer consumer, QObject *parent)
+    : QObject(parent), consumer(std::move(consumer))
+{
+    clock.start();
+
+    // 0ms 타이머 - 처리 턴 사이에 이벤트 루프(영상/그리기)가 돌 수 있게 함
+    drainTimer.setInterval(0);
+    connect(&drainTimer, &QTimer::timeout, this, &IngestQueue::drain);
+}
+
+void IngestQueue::enqueue(const QString &ip, const QByteArray &json)
+{
+    auto it = queues.find(ip);
+    if (it == queues.end()) {
+        it = queues.insert(ip, CameraQueue());
+        roundRobin.append(ip);
+    }
+    CameraQueue &queue = it.value();
+    ++queue.stats.enqueued;
+
+    Item item;
+    item.json = json;
+    item.receivedMs = clock.elapsed();
+
+    // 우선순위는 "type" 값만 훑어서 결정 (전체 토큰화는 처리 턴에서)
+    const std::string_view type = EventFrame::peekType(std::string_view(json.constData(), size_t(json.size())));
+    const Priority priority = priorities.value(QByteArray::fromRawData(type.data(), static_cast<qsizetype>(type.size())),
+                                               Priority::High);
+    switch (priority) {
+    case Priority::High:
+        queue.high.push_back(std::move(item));
+        ++totalDepth;
+        if (static_cast<int>(queue.high.size()) > MaxHighPerCamera) {
+            queue.high.pop_front();
+            --totalDepth;
+            ++queue.stats.dropped;
+            ++totalDropped;
+            shedChanged = true;
+        }
+        break;
+
+    case Priority::Low:
+        if (queue.depth() >= OverloadDepth && !queue.low.empty()) {
+            // 과부하 - 대기 중인 blur를 최신 값으로 교체 (인원 수는 마지막 값만 의미 있음)
+            queue.low.back() = std::move(item);
+            ++queue.stats.coalesced;
+            ++totalCoalesced;
+            shedChanged = true;
+            break;
+        }
+        queue.low.push_back(std::move(item));
+        ++totalDepth;
+        break;
+
+    case Priority::Normal:
+        queue.normal.push_back(std::move(item));
+        ++totalDepth;
+        break;
+    }
+
+    if (queue.depth() - static_cast<int>(queue.high.size()) > MaxQueuedPerCamera)
+        shedOne(queue);
+
+    if (!drainTimer.isActive())
+        drainTimer.start();
+}
+
+void IngestQueue::removeCamera(const QString &ip)
+{
+    auto it = queues.find(ip);
+    if (it == queues.end())
+        return;
+    totalDepth -= it->depth();
+    queues.erase(it);
+
+    // 순회 위치가 제거된 카메라보다 뒤면 한 칸 당겨 다음 카메라를 건너뛰지 않음
+    const int index = static_cast<int>(roundRobin.indexOf(ip));
+    roundRobin.removeAt(index);
+    if (index < nextCamera)
+        --nextCamera;
+
+    if (totalDepth <= 0) {
+        totalDepth = 0;
+        drainTimer.stop();
+    }
+}
+
+void IngestQueue::shedOne(CameraQueue &queue)
+{
+    // 낮은 우선순위의 가장 오래된 이벤트부터 버림
+    std::deque<Item> &victim = !queue.low.empty() ? queue.low : queue.normal;
+    if (victim.empty())
+        return;
+
+    victim.pop_front();
+    --totalDepth;
+    ++queue.stats.dropped;
+    ++totalDropped;
+    shedChanged = true;
+}
+
+bool IngestQueue::takeNext(CameraQueue &queue, Item &item)
+{
+    for (std::deque<Item> *lane : { &queue.high, &queue.normal, &queue.low }) {
+        if (!lane->empty()) {
+            item = std::move(lane->front());
+            lane->pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void IngestQueue::drain()
+{
+    // 핸들러 안에서 이벤트 루프가 다시 돌아도 (모달 창 등) 아레나 버퍼를 겹쳐 쓰지 않도록
+    if (draining)
+        return;
+    QScopedValueRollback<bool> drainingGuard(draining, true);
+
+    QElapsedTimer budget;
+    budget.start();
+
+    // 배치 아레나 - 이번 턴의 모든 이벤트가 필드 목록 하나를 재사용하고, 턴이 끝나면 통째로 버림
+    std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer));
+    EventFrame frame(&arena);
+
+    // 카메라를 돌아가며 1건씩 - 한 카메라 폭주가 다른 카메라의 낙상/침입 처리를 막지 않음
+    int idleRounds = 0;
+    while (totalDepth > 0 && budget.elapsed() < DrainBudgetMs && !roundRobin.isEmpty()) {
+        nextCamera %= roundRobin.size();
+        const QString ip = roundRobin.at(nextCamera++);
+
+        auto it = queues.find(ip);
+        Item item;
+        if (it == queues.end() || !takeNext(it.value(), item)) {
+            if (++idleRounds >= roundRobin.size())
+                break;  // depth 집계와 불일치 방지
+            continue;
+        }
+        idleRounds = 0;
+        --totalDepth;
+
+        CameraStats &stats = it.value().stats;
+        ++stats.processed;
+        stats.maxLatencyMs = qMax(stats.maxLatencyMs, clock.elapsed() - item.receivedMs);
+
+        if (!frame.parse(std::string_view(item.json.constData(), size_t(item.json.size())))) {
+            ++totalMalformed;
+            qWarning() << "[WebSocket 메시지] JSON 파싱 실패:" << ip;
+            continue;
+        }
+        consumer(ip, frame);  // 핸들러가 enqueue를 다시 불러도 안전 (it 재사용 안 함)
+    }
+
+    if (totalDepth <= 0) {
+        totalDepth = 0;
+        drainTimer.stop();
+    }
+
+    if (shedChanged) {
+        shedChanged = false;
+        emit shedCountChanged(totalDropped, totalCoalesced);
+    }
+}
+
+QString IngestQueue::statsText() const
+{
+    QString text = QString("대기 %1건 | 버림 %2건 | 병합 %3건 | 파싱 실패 %4건\n")
+                       .arg(totalDepth).arg(totalDropped).arg(totalCoalesced).arg(totalMalformed);
+    for (const QString &ip : roundRobin) {
+        const CameraQueue &queue = queues.constFind(ip).value();
+        text += QString("%1: 수신 %2 | 처리 %3 | 대기 %4 | 버림 %5 | 병합 %6 | 최대 지연 %7 ms\n")
+                    .arg(ip)
+                    .arg(queue.stats.enqueued)
+                    .arg(queue.stats.processed)
+                    .arg(queue.depth())
+                    .arg(queue.stats.dropped)
+                    .arg(queue.stats.coalesced)
+                    .arg(queue.stats.maxLatencyMs);
+    }
+    return text.trimmed();
+}
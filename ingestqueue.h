@@ -0,0 +1,99 @@
+#ifndef INGESTQUEUE_H
+#define INGESTQUEUE_H
+
+#include "eventframe.h"
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QTimer>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+
+// 카메라 이벤트 수신 큐 - 카메라별 상한 + 우선순위 + 시간 예산 안에서만 처리
+// 폭주 시 낮은 우선순위(blur)는 병합, 중간(detection)은 오래된 것부터 버림 → UI/영상이 밀리지 않음
+// 큐에는 수신한 UTF-8 원문만 보관 - 처리 턴마다 배치 아레나 위에서 토큰화해 핸들러로 전달
+class IngestQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Priority : quint8 {
+        High,    // 낙상 / 침입 / 이상소음 / 응답 - 버리지 않음
+        Normal,  // PPE 감지 - 상한 초과 시 오래된 것부터 버림
+        Low      // blur 인원 수 - 과부하 시 최신 1건으로 병합
+    };
+
+    using Consumer = std::function<void(const QString &ip, const EventFrame &frame)>;
+
+    struct CameraStats {
+        quint64 enqueued = 0;
+        quint64 processed = 0;
+        quint64 dropped = 0;
+        quint64 coalesced = 0;
+        qint64 maxLatencyMs = 0;   // 수신 → 처리까지 최대 지연
+    };
+
+    explicit IngestQueue(Consumer consumer, QObject *parent = nullptr);
+
+    void setPriority(const QByteArray &type, Priority priority) { priorities.insert(type, priority); }
+    void enqueue(const QString &ip, const QByteArray &json);  // json은 암시적 공유 - 복사 없음
+    void removeCamera(const QString &ip);  // 대기 중 이벤트 + 통계 + 순회 순서에서 제거 (삭제된 카메라)
+    QStringList cameras() const { return roundRobin; }
+
+    int depth() const { return totalDepth; }
+    quint64 droppedCount() const { return totalDropped; }
+    quint64 coalescedCount() const { return totalCoalesced; }
+    quint64 malformedCount() const { return totalMalformed; }
+    QString statsText() const;  // 진단 창 표시용
+
+    static constexpr int MaxQueuedPerCamera = 128;  // Normal + Low 합계 상한
+    static constexpr int MaxHighPerCamera = 1024;   // 안전 상한 (정상 상황에서는 도달하지 않음)
+    static constexpr int OverloadDepth = 32;        // 이 이상 쌓이면 Low 병합 시작
+    static constexpr int DrainBudgetMs = 8;         // 한 번의 처리 턴에 쓰는 최대 시간
+    static constexpr size_t ArenaBytes = 16 * 1024; // 처리 턴 하나의 필드 목록 + 이스케이프 해제 문자열
+
+signals:
+    void shedCountChanged(quint64 dropped, quint64 coalesced);
+
+private:
+    struct Item {
+        QByteArray json;
+        qint64 receivedMs = 0;
+    };
+
+    struct CameraQueue {
+        std::deque<Item> high;
+        std::deque<Item> normal;
+        std::deque<Item> low;
+        CameraStats stats;
+        int depth() const { return static_cast<int>(high.size() + normal.size() + low.size()); }
+    };
+
+    void drain();
+    bool takeNext(CameraQueue &queue, Item &item);
+    void shedOne(CameraQueue &queue);
+
+    Consumer consumer;
+    QHash<QByteArray, Priority> priorities;    // 타입 → 우선순위 (미등록은 High)
+    QHash<QString, CameraQueue> queues;
+    QStringList roundRobin;                    // 카메라 순회 순서
+    int nextCamera = 0;
+    int totalDepth = 0;
+    quint64 totalDropped = 0;
+    quint64 totalCoalesced = 0;
+    quint64 totalMalformed = 0;
+    bool shedChanged = false;
+    bool draining = false;
+
+    alignas(std::max_align_t) std::byte arenaBuffer[ArenaBytes];  // 넘치면 힙에서 추가 (턴이 끝나면 해제)
+
+    QTimer drainTimer;
+    QElapsedTimer clock;
+};
+
+#endif // INGESTQUEUE_H
@@ -0,0 +1,71 @@
+#ifndef LOGENTRY_H
+#define LOGENTRY_H
+
+#include <QtGlobal>
+
+// 로그 기능 구분 (테이블의 Function 열)
+enum class LogFunction : quint8 {
+    Raw,
+    Blur,
+    PPE,
+    Night,
+    Sound,
+    Fall,
+    Health
+};
+
+// 로그 이벤트 코드 - 표시 문자열은 LogStore::eventText()에서 필요할 때만 생성
+enum class LogEvent : quint8 {
+    ModeEnabled,        // "Raw mode enabled" 등 (function에 따라 문구 결정)
+    HelmetMissing,
+    VestMissing,
+    PpeMissing,
+    Trespass,
+    BlurCount,
+    AnomalyDetected,
+    AnomalyCleared,
+    Fall,
+    HealthStatus,
+    HealthTimeout,
+    HealthNoSocket,
+    StartupReady,       // 시작 후 그리드 전체 첫 프레임 표시 (durationMs, count = 스트림 수)
+    ModeChangeFailed,   // 카메라 모드 전환 실패 (function = 요청한 모드)
+    ModeRolledBack,     // 부분 실패로 성공한 카메라를 이전 모드로 복원 (count = 복원 대수)
+    TlsPinMismatch,     // 고정된 인증서와 다른 인증서 - 연결 거부
+    StreamStalled,      // 영상 프레임 멈춤/재생 오류 (durationMs = 마지막 프레임 이후)
+    StreamRecovered,    // 멈춘 영상 복구 (durationMs = 중단 시간, count = 재시작 횟수)
+    StreamHealth,       // 헬시 체크 시 영상 상태 (count = fps, durationMs = 지터 ms)
+    PpeCompliant        // PPE 감지 결과 모두 착용 (PpeClassifier 판정)
+};
+
+// 로그 1건 - 문자열 없이 고정 크기 필드만 보관 (카메라/이미지 경로는 LogStore 테이블 참조)
+struct LogEntry {
+    qint64 timestampMs = 0;        // 로그 기록 시각 (epoch ms)
+    qint64 sourceTimestampMs = 0;  // 서버가 보낸 감지 시각 (없으면 0)
+    quint32 imageId = 0;           // LogStore 이미지 경로 테이블 키 (0 = 이미지 없음)
+    quint32 clipId = 0;            // LogStore 클립 경로 테이블 키 (0 = 클립 없음, ClipBuffer 저장 파일)
+    quint16 cameraId = 0;          // LogStore 카메라 테이블 인덱스 (0 = System)
+    qint16 zone = -1;              // 실제 스트리밍 영역 번호
+    LogFunction function = LogFunction::Raw;
+    LogEvent event = LogEvent::ModeEnabled;
+
+    // 이벤트별 수치 데이터
+    quint16 personCount = 0;
+    quint16 helmetCount = 0;
+    quint16 vestCount = 0;
+    quint16 count = 0;             // 침입자 수 / Blur 감지 인원 / 낙상 수
+    float confidence = 0.0f;
+    float temperature = 0.0f;
+    quint16 light = 0;
+    bool buzzerOn = false;
+    bool ledOn = false;
+    quint32 durationMs = 0;        // 소요 시간 (시작 시간 보고 등)
+};
+
+// 서버 JSON의 int 값을 카운트 필드 범위로 변환
+inline quint16 toLogCount(int value)
+{
+    return static_cast<quint16>(qBound(0, value, 0xFFFF));
+}
+
+#endif // LOGENTRY_H
@@ -0,0 +1,508 @@
+#include "logexporter.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSaveFile>
+#include <QSet>
+#include <QtEndian>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr char Magic[8] = { 'S', 'S', 'N', 'C', 'O', 'L', '1', '\0' };
+constexpr qsizetype CsvFlushBytes = 4 * 1024 * 1024;
+
+struct Column {
+    const char *name;
+    LogExporter::ColumnType type;
+    quint8 width;
+};
+
+// 열 순서 = ColumnarWriter::add()의 기록 순서
+constexpr Column Columns[] = {
+    { "timestamp_ms",        LogExporter::ColumnType::Int,   8 },
+    { "source_timestamp_ms", LogExporter::ColumnType::Int,   8 },
+    { "camera_id",           LogExporter::ColumnType::UInt,  2 },
+    { "zone",                LogExporter::ColumnType::Int,   2 },
+    { "function",            LogExporter::ColumnType::UInt,  1 },
+    { "event",               LogExporter::ColumnType::UInt,  1 },
+    { "person_count",        LogExporter::ColumnType::UInt,  2 },
+    { "helmet_count",        LogExporter::ColumnType::UInt,  2 },
+    { "vest_count",          LogExporter::ColumnType::UInt,  2 },
+    { "count",               LogExporter::ColumnType::UInt,  2 },
+    { "confidence",          LogExporter::ColumnType::Float, 4 },
+    { "temperature",         LogExporter::ColumnType::Float, 4 },
+    { "light",               LogExporter::ColumnType::UInt,  2 },
+    { "buzzer_on",           LogExporter::ColumnType::UInt,  1 },
+    { "led_on",              LogExporter::ColumnType::UInt,  1 },
+    { "duration_ms",         LogExporter::ColumnType::UInt,  4 },
+    { "image_id",            LogExporter::ColumnType::UInt,  4 },
+    { "clip_id",             LogExporter::ColumnType::UInt,  4 },
+};
+constexpr int ColumnCount = int(sizeof(Columns) / sizeof(Columns[0]));
+
+// CSV event 열 - 표시 문구(이모지, 수치 포함) 대신 고정 코드
+const char *eventCode(LogEvent event)
+{
+    switch (event) {
+    case LogEvent::ModeEnabled:      return "mode_enabled";
+    case LogEvent::HelmetMissing:    return "helmet_missing";
+    case LogEvent::VestMissing:      return "vest_missing";
+    case LogEvent::PpeMissing:       return "ppe_missing";
+    case LogEvent::Trespass:         return "trespass";
+    case LogEvent::BlurCount:        return "blur_count";
+    case LogEvent::AnomalyDetected:  return "anomaly_detected";
+    case LogEvent::AnomalyCleared:   return "anomaly_cleared";
+    case LogEvent::Fall:             return "fall";
+    case LogEvent::HealthStatus:     return "health_status";
+    case LogEvent::HealthTimeout:    return "health_timeout";
+    case LogEvent::HealthNoSocket:   return "health_no_socket";
+    case LogEvent::StartupReady:     return "startup_ready";
+    case LogEvent::ModeChangeFailed: return "mode_change_failed";
+    case LogEvent::ModeRolledBack:   return "mode_rolled_back";
+    case LogEvent::TlsPinMismatch:   return "tls_pin_mismatch";
+    case LogEvent::StreamStalled:    return "stream_stalled";
+    case LogEvent::StreamRecovered:  return "stream_recovered";
+    case LogEvent::StreamHealth:     return "stream_health";
+    case LogEvent::PpeCompliant:     return "ppe_compliant";
+    }
+    return "unknown";
+}
+
+// ---- CSV
+
+void appendInt(QByteArray &out, qint64 value)
+{
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, qsizetype(result.ptr - buffer));
+}
+
+void appendDigits(QByteArray &out, int value, int digits)
+{
+    char buffer[4];
+    for (int i = digits - 1; i >= 0; --i) {
+        buffer[i] = char('0' + value % 10);
+        value /= 10;
+    }
+    out.append(buffer, digits);
+}
+
+// 소수 둘째 자리 고정 (신뢰도/온도) - 행마다 문자열 포맷팅 없이 정수 연산
+void appendFixed2(QByteArray &out, float value)
+{
+    qint64 scaled = qRound64(double(value) * 100.0);
+    if (scaled < 0) {
+        out.append('-');
+        scaled = -scaled;
+    }
+    appendInt(out, scaled / 100);
+    out.append('.');
+    appendDigits(out, int(scaled % 100), 2);
+}
+
+void appendCsvText(QByteArray &out, const QByteArray &text)
+{
+    bool quote = false;
+    for (const char c : text) {
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+            quote = true;
+            break;
+        }
+    }
+    if (!quote) {
+        out.append(text);
+        return;
+    }
+    out.append('"');
+    for (const char c : text) {
+        if (c == '"')
+            out.append('"');
+        out.append(c);
+    }
+    out.append('"');
+}
+
+// 로컬 시각 문자열 - QDateTime 변환은 분이 바뀔 때만, 초/밀리초는 직접 붙임
+class TimeFormatter
+{
+public:
+    void append(QByteArray &out, qint64 ms)
+    {
+        if (ms <= 0)
+            return;
+        const qint64 minute = ms / 60000;
+        if (minute != cachedMinute) {
+            cachedMinute = minute;
+            prefix = QDateTime::fromMSecsSinceEpoch(minute * 60000).toString("yyyy-MM-dd HH:mm:").toUtf8();
+        }
+        const int rest = int(ms - minute * 60000);
+        out.append(prefix);
+        appendDigits(out, rest / 1000, 2);
+        out.append('.');
+        appendDigits(out, rest % 1000, 3);
+    }
+
+private:
+    qint64 cachedMinute = -1;
+    QByteArray prefix;
+};
+
+class CsvWriter
+{
+public:
+    explicit CsvWriter(const LogStore &store)
+        : store(store)
+    {
+        // 카메라/기능 문자열은 한 번만 변환
+        for (int id = 0; id < store.cameraCount(); ++id) {
+            QByteArray name, ip;
+            appendCsvText(name, store.cameraName(quint16(id)).toUtf8());
+            appendCsvText(ip, store.cameraIp(quint16(id)).toUtf8());
+            cameraNames.push_back(name);
+            cameraIps.push_back(ip);
+        }
+        for (int function = 0; function <= int(LogFunction::Health); ++function) {
+            QByteArray text;
+            appendCsvText(text, LogStore::functionText(static_cast<LogFunction>(function)).toUtf8());
+            functionNames.push_back(text);
+        }
+        buffer.reserve(CsvFlushBytes + 64 * 1024);
+        buffer.append("\xEF\xBB\xBF");  // BOM - 엑셀에서 한글 카메라 이름이 깨지지 않도록
+        buffer.append("time,source_time,camera,ip,zone,function,event,person_count,helmet_count,vest_count,count,"
+                      "confidence,temperature,light,buzzer_on,led_on,duration_ms,image_path,clip_path\n");
+    }
+
+    void add(const LogEntry &entry)
+    {
+        times.append(buffer, entry.timestampMs);
+        buffer.append(',');
+        times.append(buffer, entry.sourceTimestampMs);
+        buffer.append(',');
+        if (entry.cameraId < cameraNames.size()) {
+            buffer.append(cameraNames[entry.cameraId]);
+            buffer.append(',');
+            buffer.append(cameraIps[entry.cameraId]);
+        } else {
+            buffer.append(',');
+        }
+        buffer.append(',');
+        appendInt(buffer, entry.zone);
+        buffer.append(',');
+        if (int(entry.function) < int(functionNames.size()))
+            buffer.append(functionNames[int(entry.function)]);
+        buffer.append(',');
+        buffer.append(eventCode(entry.event));
+        for (const quint16 value : { entry.personCount, entry.helmetCount, entry.vestCount, entry.count }) {
+            buffer.append(',');
+            appendInt(buffer, value);
+        }
+        buffer.append(',');
+        appendFixed2(buffer, entry.confidence);
+        buffer.append(',');
+        appendFixed2(buffer, entry.temperature);
+        buffer.append(',');
+        appendInt(buffer, entry.light);
+        buffer.append(entry.buzzerOn ? ",1," : ",0,");
+        buffer.append(entry.ledOn ? "1," : "0,");
+        appendInt(buffer, entry.durationMs);
+        buffer.append(',');
+        if (entry.imageId)
+            appendCsvText(buffer, store.imagePath(entry).toUtf8());
+        buffer.append(',');
+        if (entry.clipId)
+            appendCsvText(buffer, store.clipPath(entry).toUtf8());
+        buffer.append('\n');
+    }
+
+    bool flush(QIODevice &device, bool force)
+    {
+        if (!force && buffer.size() < CsvFlushBytes)
+            return true;
+        const bool ok = device.write(buffer) == buffer.size();
+        buffer.resize(0);  // 용량 유지
+        return ok;
+    }
+
+private:
+    const LogStore &store;
+    std::vector<QByteArray> cameraNames;
+    std::vector<QByteArray> cameraIps;
+    std::vector<QByteArray> functionNames;
+    TimeFormatter times;
+    QByteArray buffer;
+};
+
+// ---- 열 형식
+
+template <typename T>
+void put(QByteArray &column, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    column.append(bytes, qsizetype(sizeof(T)));
+}
+
+void putFloat(QByteArray &column, float value)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put(column, bits);
+}
+
+void putString(QByteArray &out, const QString &text)
+{
+    const QByteArray utf8 = text.toUtf8().left(0xFFFF);
+    put(out, quint16(utf8.size()));
+    out.append(utf8);
+}
+
+class ColumnarWriter
+{
+public:
+    explicit ColumnarWriter(const LogStore &store)
+        : store(store)
+    {
+        for (int i = 0; i < ColumnCount; ++i)
+            columns[i].reserve(qsizetype(LogExporter::ChunkRows) * Columns[i].width);
+    }
+
+    bool begin(QIODevice &device)
+    {
+        return device.write(Magic, sizeof(Magic)) == qint64(sizeof(Magic));
+    }
+
+    void add(const LogEntry &entry)
+    {
+        QByteArray *c = columns;
+        put(*c++, entry.timestampMs);
+        put(*c++, entry.sourceTimestampMs);
+        put(*c++, entry.cameraId);
+        put(*c++, entry.zone);
+        put(*c++, quint8(entry.function));
+        put(*c++, quint8(entry.event));
+        put(*c++, entry.personCount);
+        put(*c++, entry.helmetCount);
+        put(*c++, entry.vestCount);
+        put(*c++, entry.count);
+        putFloat(*c++, entry.confidence);
+        putFloat(*c++, entry.temperature);
+        put(*c++, entry.light);
+        put(*c++, quint8(entry.buzzerOn));
+        put(*c++, quint8(entry.ledOn));
+        put(*c++, entry.durationMs);
+        put(*c++, entry.imageId);
+        put(*c++, entry.clipId);
+        ++rows;
+
+        cameraIds.insert(entry.cameraId);
+        if (entry.imageId && !imageIds.contains(entry.imageId)) {
+            imageIds.insert(entry.imageId);
+            putStringEntry(images, entry.imageId, store.imagePath(entry));
+            ++imageCount;
+        }
+        if (entry.clipId && !clipIds.contains(entry.clipId)) {
+            clipIds.insert(entry.clipId);
+            putStringEntry(clips, entry.clipId, store.clipPath(entry));
+            ++clipCount;
+        }
+    }
+
+    // 행 묶음 하나 = 지금까지 모은 열들
+    bool flush(QIODevice &device)
+    {
+        if (rows == 0)
+            return true;
+        QByteArray header;
+        put(header, quint32(rows));
+        bool ok = device.write(header) == header.size();
+        for (QByteArray &column : columns) {
+            ok = ok && device.write(column) == column.size();
+            column.resize(0);
+        }
+        totalRows += rows;
+        rows = 0;
+        return ok;
+    }
+
+    bool finish(QIODevice &device)
+    {
+        QByteArray footer;
+        put(footer, quint32(0));
+
+        put(footer, quint32(ColumnCount));
+        for (const Column &column : Columns) {
+            const quint8 length = quint8(std::strlen(column.name));
+            put(footer, length);
+            footer.append(column.name, length);
+            put(footer, quint8(column.type));
+            put(footer, column.width);
+        }
+
+        put(footer, quint32(cameraIds.size()));
+        for (const quint16 id : std::as_const(cameraIds)) {
+            put(footer, id);
+            putString(footer, store.cameraName(id));
+            putString(footer, store.cameraIp(id));
+        }
+        put(footer, imageCount);
+        footer.append(images);
+        put(footer, clipCount);
+        footer.append(clips);
+
+        put(footer, quint64(totalRows));
+        footer.append(Magic, sizeof(Magic));
+        return device.write(footer) == footer.size();
+    }
+
+private:
+    static void putStringEntry(QByteArray &table, quint32 id, const QString &path)
+    {
+        put(table, id);
+        putString(table, path);
+    }
+
+    const LogStore &store;
+    QByteArray columns[ColumnCount];
+    int rows = 0;
+    qint64 totalRows = 0;
+
+    QSet<quint16> cameraIds;
+    QSet<quint32> imageIds;
+    QSet<quint32> clipIds;
+    QByteArray images;
+    QByteArray clips;
+    quint32 imageCount = 0;
+    quint32 clipCount = 0;
+};
+
+} // namespace
+
+bool LogExporter::Filter::accepts(const LogEntry &entry) const
+{
+    return (fromMs <= 0 || entry.timestampMs >= fromMs)
+        && (toMs <= 0 || entry.timestampMs <= toMs)
+        && (cameraId < 0 || entry.cameraId == cameraId)
+        && (function < 0 || int(entry.function) == function);
+}
+
+LogExporter::LogExporter(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(1);
+}
+
+LogExporter::~LogExporter()
+{
+    cancel();
+    pool.waitForDone();
+}
+
+void LogExporter::cancel()
+{
+    cancelled = true;
+}
+
+bool LogExporter::start(const LogStore &store, const Filter &filter, Format format, const QString &path)
+{
+    if (running.exchange(true))
+        return false;
+    cancelled = false;
+
+    // 스냅샷 - 목록/문자열 테이블 모두 암시적 공유, 화면 쪽에서 로그가 추가되면 그쪽이 분리됨
+    const LogStore snapshot = store;
+
+    pool.start([this, snapshot, filter, format, path]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        QSaveFile file(path);
+        qint64 written = 0;
+        QString error;
+        bool ok = file.open(QIODevice::WriteOnly);
+        if (!ok)
+            error = file.errorString();
+
+        // 저장 순서는 시간순이 아님 - 실시간 항목은 앞에 추가(최신이 앞), 동기화된 로그는 응답 순서대로 뒤에 추가
+        // 필터를 통과한 행의 위치만 모아 기록 시각으로 정렬한 뒤 씀 (같은 시각은 저장 역순 유지)
+        const QVector<LogEntry> &entries = snapshot.all();
+        std::vector<int> order;
+        for (int i = int(entries.size()) - 1; i >= 0 && !cancelled; --i) {
+            if (filter.accepts(entries.at(i)))
+                order.push_back(i);
+        }
+        if (cancelled)
+            order.clear();
+        std::stable_sort(order.begin(), order.end(), [&entries](int a, int b) {
+            return entries.at(a).timestampMs < entries.at(b).timestampMs;
+        });
+        const qint64 total = qint64(order.size());
+
+        auto reportProgress = [this, total](qint64 written) {
+            QMetaObject::invokeMethod(this, [this, written, total]() {
+                emit progress(written, total);
+            }, Qt::QueuedConnection);
+        };
+
+        if (ok && format == Format::Csv) {
+            CsvWriter writer(snapshot);
+            for (const int index : order) {
+                writer.add(entries.at(index));
+                if (++written % ChunkRows == 0) {
+                    ok = writer.flush(file, false);
+                    if (!ok || cancelled)
+                        break;
+                    reportProgress(written);
+                }
+            }
+            ok = ok && writer.flush(file, true);
+        } else if (ok) {
+            ColumnarWriter writer(snapshot);
+            ok = writer.begin(file);
+            for (const int index : order) {
+                if (!ok)
+                    break;
+                writer.add(entries.at(index));
+                if (++written % ChunkRows == 0) {
+                    ok = writer.flush(file);
+                    if (cancelled)
+                        break;
+                    reportProgress(written);
+                }
+            }
+            ok = ok && writer.flush(file) && writer.finish(file);
+        }
+
+        const qint64 bytes = file.isOpen() ? file.pos() : 0;
+        QString message;
+        if (cancelled) {
+            ok = false;
+            file.cancelWriting();
+            message = QStringLiteral("취소됨");
+        } else if (!ok || !file.commit()) {
+            ok = false;
+            file.cancelWriting();
+            message = QString("파일 쓰기 실패: %1").arg(error.isEmpty() ? file.errorString() : error);
+        } else {
+            const double seconds = qMax<qint64>(1, timer.elapsed()) / 1000.0;
+            message = QString("%1행 내보냄 (%2초, %3 MB/s)")
+                          .arg(written)
+                          .arg(seconds, 0, 'f', 1)
+                          .arg(bytes / (1024.0 * 1024.0) / seconds, 0, 'f', 1);
+        }
+        if (!cancelled && ok)
+            reportProgress(written);
+        qDebug() << "[LogExporter]" << path << message;
+
+        QMetaObject::invokeMethod(this, [this, ok, written, message]() {
+            running = false;
+            emit finished(ok, written, message);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef LOGEXPORTER_H
+#define LOGEXPORTER_H
+
+#include "logstore.h"
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+
+// 로그 저장소 내보내기 (감사 제출용) - 백그라운드 스레드에서 청크 단위로 파일에 씀
+// 시작 시 LogStore를 값으로 복사 (암시적 공유라 복사 비용 없음, 이후 화면 쪽 추가와 무관한 스냅샷)
+//
+// 행 순서는 기록 시각 오름차순 (필터를 통과한 행을 작업 스레드에서 정렬한 뒤 씀)
+// CSV: UTF-8 (BOM), 한 행 = LogEntry 1건, 시각은 로컬 "yyyy-MM-dd HH:mm:ss.zzz"
+// 열 형식(SSNCOL1): 리틀 엔디언 고정 폭 열을 행 묶음 단위로 기록
+//   "SSNCOL1\0"
+//   행 묶음*: u32 행 수(>0), 이어서 열 순서대로 [행 수 × 열 폭] 바이트
+//   u32 0 (묶음 끝)
+//   열 정의: u32 열 수, 열마다 { u8 이름 길이, 이름, u8 타입(ColumnType), u8 폭 }
+//   문자열 테이블: 카메라 { u32 수, (u16 id, u16 길이, 이름, u16 길이, IP)* },
+//                  이미지/클립 { u32 수, (u32 id, u16 길이, 경로)* } - 내보낸 행이 참조하는 것만
+//   u64 전체 행 수, "SSNCOL1\0"
+class LogExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Format { Csv, Columnar };
+    enum class ColumnType : quint8 { Int, UInt, Float };
+
+    struct Filter {
+        qint64 fromMs = 0;   // 0 = 처음부터
+        qint64 toMs = 0;     // 0 = 끝까지 (포함)
+        int cameraId = -1;   // -1 = 전체
+        int function = -1;   // LogFunction 값, -1 = 전체
+
+        bool accepts(const LogEntry &entry) const;
+    };
+
+    static constexpr int ChunkRows = 64 * 1024;  // 청크마다 파일 쓰기 + 진행률 + 취소 확인
+
+    explicit LogExporter(QObject *parent = nullptr);
+    ~LogExporter() override;  // 진행 중이면 취소 후 완료 대기
+
+    // 이미 실행 중이면 false
+    bool start(const LogStore &store, const Filter &filter, Format format, const QString &path);
+    void cancel();
+    bool isRunning() const { return running.load(); }
+
+signals:
+    void progress(qint64 written, qint64 total);  // total = 필터를 통과한 행 수
+    void finished(bool ok, qint64 rows, const QString &message);  // 취소/실패 시 부분 파일은 남기지 않음
+
+private:
+    QThreadPool pool;
+    std::atomic_bool running { false };
+    std::atomic_bool cancelled { false };
+};
+
+#endif // LOGEXPORTER_H
@@ -1,14 +1,13 @@
 #include "loghistorydialog.h"
+#include "clipbuffer.h"
+#include "exportdialog.h"
 
 #include <QDateTime>
-#include <QTableWidgetItem>
 #include <QMessageBox>
 #include <QPixmap>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
 
-LogHistoryDialog::LogHistoryDialog(QWidget *parent, const QVector<LogEntry>* fullLogs)
-    : QDialog(parent), logListPtr(fullLogs)
+LogHistoryDialog::LogHistoryDialog(QWidget *parent, const LogStore* logStore, CameraHttpClient *httpClient)
+    : QDialog(parent), logStorePtr(logStore), httpClient(httpClient)
 {
     setupUI();
     loadHistoryData();
@@ -24,17 +23,21 @@ void LogHistoryDialog::setupUI()
     QLabel *titleLabel = new QLabel("Complete Safety Alerts");
     titleLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #ff8c00; margin-bottom: 10px;");
 
-    historyTable = new QTableWidget(0, 7);
-    historyTable->setHorizontalHeaderLabels(QStringList()
-                                            << "Streaming Zone" << "Camera" << "Date" << "Time"
-                                            << "Function" << "Event" << "Details");
+    historyModel = new LogTableModel(logStorePtr, this);
+
+    historyTable = new QTableView();
+    historyTable->setModel(historyModel);
+    historyTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    historyTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     historyTable->horizontalHeader()->setStretchLastSection(true);
     historyTable->setAlternatingRowColors(true);
     historyTable->verticalHeader()->setVisible(false);
 
     QHBoxLayout *buttonLayout = new QHBoxLayout();
+    exportButton = new QPushButton("내보내기");
     closeButton = new QPushButton("Close");
     buttonLayout->addStretch();
+    buttonLayout->addWidget(exportButton);
     buttonLayout->addWidget(closeButton);
 
     mainLayout->addWidget(titleLabel);
@@ -42,8 +45,9 @@ void LogHistoryDialog::setupUI()
     mainLayout->addLayout(buttonLayout);
 
     connect(closeButton, &QPushButton::clicked, this, &LogHistoryDialog::onCloseClicked);
+    connect(exportButton, &QPushButton::clicked, this, &LogHistoryDialog::onExportClicked);
 
-    connect(historyTable, &QTableWidget::cellClicked, this, &LogHistoryDialog::onRowClicked);
+    connect(historyTable, &QTableView::clicked, this, &LogHistoryDialog::onRowClicked);
 
     setStyleSheet(R"(
         QDialog {
@@ -53,17 +57,17 @@ void LogHistoryDialog::setupUI()
         QLabel {
             color: white;
         }
-        QTableWidget {
+        QTableView {
             background-color: #404040;
             color: white;
             gridline-color: #555;
             border: 1px solid #555;
             alternate-background-color: #353535;
         }
-        QTableWidget::item {
+        QTableView::item {
             padding: 8px;
         }
-        QTableWidget::item:focus {
+        QTableView::item:focus {
             outline: none;
             border: none;
         }
@@ -90,23 +94,10 @@ void LogHistoryDialog::setupUI()
 
 void LogHistoryDialog::loadHistoryData()
 {
-    if (!logListPtr) return;
-
-    for (int i = 0; i < logListPtr->size(); ++i) {
-        const LogEntry& entry = logListPtr->at(i);
-
-        int row = historyTable->rowCount();
-        historyTable->insertRow(row);
-
-        historyTable->setItem(row, 0, new QTableWidgetItem(QString::number(entry.zone)));  // Streaming Zone
-        historyTable->setItem(row, 1, new QTableWidgetItem(entry.camera));                 // Camera
-        historyTable->setItem(row, 2, new QTableWidgetItem(entry.date));                   // Date
-        historyTable->setItem(row, 3, new QTableWidgetItem(entry.time));                   // Time
-        historyTable->setItem(row, 4, new QTableWidgetItem(entry.function));               // ✅ 고정된 Function 필드
-        historyTable->setItem(row, 5, new QTableWidgetItem(entry.alert));                  // Event
-        historyTable->setItem(row, 6, new QTableWidgetItem(entry.details));                // Details
-    }
+    if (!logStorePtr) return;
 
+    // 문자열 변환은 모델 data()에서 보이는 행에 대해서만 수행
+    historyModel->reload();
     historyTable->resizeColumnsToContents();
 }
 
@@ -115,47 +106,39 @@ void LogHistoryDialog::onCloseClicked()
     accept();
 }
 
-void LogHistoryDialog::onRowClicked(int row, int column)
+void LogHistoryDialog::onExportClicked()
 {
-    if (!logListPtr || row >= logListPtr->size()) return;
+    if (!logStorePtr) return;
 
-    const LogEntry &entry = logListPtr->at(row);
-    if (entry.imagePath.isEmpty()) {
-        QMessageBox::information(this, "이미지 없음", "이 항목에는 이미지가 없습니다.");
-        return;
-    }
+    ExportDialog dialog(logStorePtr, this);
+    dialog.exec();
+}
 
-    // IP 주소 추출
-    QString ip;
-    if (entry.camera.contains("(") && entry.camera.contains(")")) {
-        int start = entry.camera.indexOf('(') + 1;
-        int end = entry.camera.indexOf(')');
-        ip = entry.camera.mid(start, end - start);  // "Camera 1 (192.168.0.54)" → 192.168.0.54
-    } else {
-        ip = "192.168.0.54";  // 기본값
+void LogHistoryDialog::onRowClicked(const QModelIndex &index)
+{
+    const LogEntry *entry = historyModel->entryAt(index.row());
+    if (!logStorePtr || !httpClient || !entry) return;
+
+    const QString imagePath = logStorePtr->imagePath(*entry);
+    const QString clipPath = logStorePtr->clipPath(*entry);
+    if (imagePath.isEmpty()) {
+        if (!clipPath.isEmpty())
+            ClipBuffer::openClip(this, clipPath);  // 이미지 없는 이벤트는 클립 재생
+        else
+            QMessageBox::information(this, "이미지 없음", "이 항목에는 이미지가 없습니다.");
+        return;
     }
 
-    // 이미지 요청 URL 생성
-    QString cleanPath = entry.imagePath;
-    if (cleanPath.startsWith("./"))
-        cleanPath.remove(0, 2);  // "./" 제거
-
-    QString urlStr = QString("http://%1/%2").arg(entry.ip, cleanPath);  // entry.ip 필드 사용!
-    QUrl url(urlStr);
-    QNetworkRequest request(url);
-
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
-    QNetworkReply *reply = manager->get(request);
-
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            QMessageBox::critical(this, "이미지 로딩 실패", reply->errorString());
+    // 카메라 테이블의 IP 사용 - 미리 받아 둔 이미지면 캐시에서 바로 표시
+    httpClient->fetchImage(logStorePtr->cameraIp(entry->cameraId), imagePath, this,
+                           [this, clipPath](const QByteArray &data, const QString &error) {
+        if (!error.isEmpty()) {
+            QMessageBox::critical(this, "이미지 로딩 실패", error);
             return;
         }
 
         QPixmap pix;
-        pix.loadFromData(reply->readAll());
+        pix.loadFromData(data);
         if (pix.isNull()) {
             QMessageBox::warning(this, "이미지 오류", "유효한 이미지가 아닙니다.");
             return;
@@ -170,6 +153,13 @@ void LogHistoryDialog::onRowClicked(int row, int column)
 
         QVBoxLayout *layout = new QVBoxLayout(imgDialog);
         layout->addWidget(imgLabel);
+        if (!clipPath.isEmpty()) {
+            QPushButton *clipButton = new QPushButton("🎞️ 클립 재생");
+            connect(clipButton, &QPushButton::clicked, imgDialog, [imgDialog, clipPath]() {
+                ClipBuffer::openClip(imgDialog, clipPath);
+            });
+            layout->addWidget(clipButton);
+        }
         imgDialog->setLayout(layout);
         imgDialog->setMinimumSize(640, 480);
         imgDialog->exec();
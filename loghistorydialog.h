@@ -1,11 +1,13 @@
 #ifndef LOGHISTORYDIALOG_H
 #define LOGHISTORYDIALOG_H
 
-#include "mainwindow.h"  // LogEntry 구조체 정의 포함
+#include "logstore.h"  // LogEntry / LogStore 정의 포함
+#include "logtablemodel.h"
 #include "camerainfo.h"
+#include "camerahttpclient.h"
 
 #include <QDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -17,18 +19,23 @@ class LogHistoryDialog : public QDialog
     Q_OBJECT
 
 public:
-    explicit LogHistoryDialog(QWidget *parent = nullptr, const QVector<LogEntry>* fullLogs = nullptr);  // ✅ LogEntry로 변경
+    explicit LogHistoryDialog(QWidget *parent = nullptr, const LogStore* logStore = nullptr,
+                              CameraHttpClient *httpClient = nullptr);  // ✅ LogStore로 변경
 
 private slots:
     void onCloseClicked();
-    void onRowClicked(int row, int column);  // 추가
+    void onRowClicked(const QModelIndex &index);  // 추가
+    void onExportClicked();
 
 private:
     void setupUI();
     void loadHistoryData();
 
-    const QVector<LogEntry>* logListPtr = nullptr;  // QPair → LogEntry로 변경
-    QTableWidget *historyTable;
+    const LogStore* logStorePtr = nullptr;
+    CameraHttpClient *httpClient = nullptr;  // MainWindow와 공유 (이미지 캐시)
+    LogTableModel *historyModel;    // 보이는 행만 문자열로 변환
+    QTableView *historyTable;
+    QPushButton *exportButton;      // 기간/카메라/기능 필터 후 CSV·열 형식 파일로
     QPushButton *closeButton;
 };
 
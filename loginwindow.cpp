@@ -1,4 +1,5 @@
 #include "loginwindow.h"
+#include "startuptimeline.h"
 #include "mainwindow.h"
 #include <QApplication>
 #include <QScreen>
@@ -108,10 +109,12 @@ void LoginWindow::onLoginClicked()
     QString password = passwordEdit->text();
 
     if (username == "admin" && password == "admin") {
+        StartupTimeline::mark(StartupMilestone::Login);
+        // 생성자는 화면 구성까지만 - 카메라 연결/로그 동기화는 창이 뜬 뒤 시작 (MainWindow::startNetwork)
+        this->hide();
         mainWindow = new MainWindow();
         mainWindow->show();
         qDebug() << "MainWindow opened.";
-        this->hide();
     } else {
         QMessageBox::warning(this, "Login Failed", "Invalid username or password!");
     }
@@ -0,0 +1,333 @@
+#include "logstore.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QSet>
+
+LogStore::LogStore()
+{
+    cameras.append({ "System", QString() });  // id 0 = System
+    cameraIds.insert(QStringLiteral("System\n"), SystemCameraId);
+}
+
+quint16 LogStore::cameraId(const QString &name, const QString &ip)
+{
+    if (auto cached = cameraIdByIp.constFind(ip); cached != cameraIdByIp.constEnd()
+        && cameras.at(cached.value()).name == name)
+        return cached.value();
+
+    const QString key = name + QLatin1Char('\n') + ip;
+    auto it = cameraIds.constFind(key);
+    if (it != cameraIds.constEnd()) {
+        cameraIdByIp.insert(ip, it.value());
+        return it.value();
+    }
+
+    if (cameras.size() > 0xFFFF) {
+        qWarning() << "[LogStore] 카메라 테이블 한도 초과 →" << name;
+        return SystemCameraId;
+    }
+
+    const quint16 id = static_cast<quint16>(cameras.size());
+    cameras.append({ name, ip });
+    cameraIds.insert(key, id);
+    cameraIdByIp.insert(ip, id);
+    return id;
+}
+
+QString LogStore::cameraName(quint16 id) const
+{
+    return id < cameras.size() ? cameras.at(id).name : QString();
+}
+
+QString LogStore::cameraIp(quint16 id) const
+{
+    return id < cameras.size() ? cameras.at(id).ip : QString();
+}
+
+quint32 LogStore::internImage(const QString &path)
+{
+    if (path.isEmpty())
+        return 0;
+    if (auto it = imageIds.constFind(path); it != imageIds.constEnd())
+        return it.value();
+
+    const quint32 id = nextImageId++;
+    imagePaths.insert(id, path);
+    imageIds.insert(path, id);  // QString 암시적 공유 - 두 테이블이 문자열 한 벌을 같이 씀
+    return id;
+}
+
+QString LogStore::imagePath(const LogEntry &entry) const
+{
+    return entry.imageId ? imagePaths.value(entry.imageId) : QString();
+}
+
+quint32 LogStore::internClip(const QString &path)
+{
+    if (path.isEmpty())
+        return 0;
+    if (auto it = clipIds.constFind(path); it != clipIds.constEnd())
+        return it.value();
+
+    const quint32 id = nextClipId++;
+    clipPaths.insert(id, path);
+    clipIds.insert(path, id);
+    return id;
+}
+
+QString LogStore::clipPath(const LogEntry &entry) const
+{
+    return entry.clipId ? clipPaths.value(entry.clipId) : QString();
+}
+
+int LogStore::indexOf(qint64 timestampMs, quint16 cameraId, LogEvent event) const
+{
+    for (int i = 0; i < entries.size(); ++i) {
+        const LogEntry &entry = entries.at(i);
+        if (entry.timestampMs == timestampMs && entry.cameraId == cameraId && entry.event == event)
+            return i;
+    }
+    return -1;
+}
+
+void LogStore::prepend(const LogEntry &entry)
+{
+    entries.prepend(entry);
+    if (entryLimit > 0 && entries.size() > entryLimit + entryLimit / 16)
+        trimTo(entryLimit);
+}
+
+void LogStore::append(const LogEntry &entry)
+{
+    entries.append(entry);
+    if (entryLimit > 0 && entries.size() > entryLimit + entryLimit / 16)
+        trimTo(entryLimit);
+}
+
+void LogStore::setMaxEntries(int maxEntries)
+{
+    entryLimit = qMax(0, maxEntries);
+    if (entryLimit > 0 && entries.size() > entryLimit)
+        trimTo(entryLimit);
+}
+
+void LogStore::trimTo(int maxEntries)
+{
+    const int dropped = entries.size() - maxEntries;
+    if (dropped <= 0)
+        return;
+    entries.resize(maxEntries);
+    entries.squeeze();
+
+    // 남은 항목이 참조하지 않는 이미지/클립 경로 제거 (클립 파일 자체는 ClipBuffer가 관리)
+    QSet<quint32> liveImages;
+    QSet<quint32> liveClips;
+    for (const LogEntry &entry : std::as_const(entries)) {
+        if (entry.imageId) liveImages.insert(entry.imageId);
+        if (entry.clipId) liveClips.insert(entry.clipId);
+    }
+    for (auto it = imagePaths.begin(); it != imagePaths.end();) {
+        if (liveImages.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        imageIds.remove(it.value());
+        it = imagePaths.erase(it);
+    }
+    for (auto it = clipPaths.begin(); it != clipPaths.end();) {
+        if (liveClips.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        clipIds.remove(it.value());
+        it = clipPaths.erase(it);
+    }
+
+    qDebug() << "[LogStore] 보관 한도" << maxEntries << "초과 - 오래된 로그" << dropped << "건 정리";
+}
+
+qint64 LogStore::memoryUsage() const
+{
+    // QHash 노드/문자열 헤더는 항목당 대략 64바이트로 계산 (역방향 표는 노드만 - 문자열은 공유)
+    qint64 bytes = qint64(entries.capacity()) * sizeof(LogEntry);
+    for (const QString &path : imagePaths)
+        bytes += 64 + 32 + path.size() * 2;
+    for (const QString &path : clipPaths)
+        bytes += 64 + 32 + path.size() * 2;
+    for (const CameraRef &camera : cameras)
+        bytes += 128 + (camera.name.size() + camera.ip.size()) * 4;
+    return bytes;
+}
+
+void LogStore::clear()
+{
+    entries.clear();
+    imagePaths.clear();
+    imageIds.clear();
+    clipPaths.clear();
+    clipIds.clear();
+}
+
+QString LogStore::functionText(LogFunction function)
+{
+    switch (function) {
+    case LogFunction::Raw:    return QStringLiteral("Raw");
+    case LogFunction::Blur:   return QStringLiteral("Blur");
+    case LogFunction::PPE:    return QStringLiteral("PPE");
+    case LogFunction::Night:  return QStringLiteral("Night");
+    case LogFunction::Sound:  return QStringLiteral("Sound");
+    case LogFunction::Fall:   return QStringLiteral("Fall");
+    case LogFunction::Health: return QStringLiteral("Health");
+    }
+    return QString();
+}
+
+QString LogStore::dateText(const LogEntry &entry)
+{
+    if (entry.timestampMs == 0)
+        return QString();
+    return QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString("yyyy-MM-dd");
+}
+
+QString LogStore::timeText(const LogEntry &entry)
+{
+    if (entry.timestampMs == 0)
+        return QString();
+    return QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString("HH:mm:ss");
+}
+
+QString LogStore::eventText(const LogEntry &entry)
+{
+    switch (entry.event) {
+    case LogEvent::ModeEnabled:
+        switch (entry.function) {
+        case LogFunction::Raw:   return QStringLiteral("Raw mode enabled");
+        case LogFunction::Blur:  return QStringLiteral("Blur mode enabled");
+        case LogFunction::PPE:   return QStringLiteral("PPE Detector enabled");
+        case LogFunction::Night: return QStringLiteral("Night Intrusion enabled");
+        case LogFunction::Fall:  return QStringLiteral("Fall Detection enabled");
+        default:                 return QStringLiteral("Mode enabled");
+        }
+    case LogEvent::HelmetMissing:   return QStringLiteral("⛑️ 헬멧 미착용 감지");
+    case LogEvent::VestMissing:     return QStringLiteral("🦺 조끼 미착용 감지");
+    case LogEvent::PpeMissing:      return QStringLiteral("⛑️ 🦺 PPE 미착용 감지");
+    case LogEvent::Trespass:        return QString("🌙 야간 침입 감지 (%1명)").arg(entry.count);
+    case LogEvent::BlurCount:       return QString("🔍 %1명 감지").arg(entry.count);
+    case LogEvent::AnomalyDetected: return QStringLiteral("⚠️ 이상소음 감지됨");
+    case LogEvent::AnomalyCleared:  return QStringLiteral("✅ 이상소음 해제됨");
+    case LogEvent::Fall:            return QStringLiteral("🚨 낙상 감지");
+    case LogEvent::HealthStatus:    return QStringLiteral("✅ 상태 수신");
+    case LogEvent::HealthTimeout:   return QStringLiteral("⚠️ 헬시체크 응답 없음");
+    case LogEvent::HealthNoSocket:  return QStringLiteral("❌ 웹소켓 없음");
+    case LogEvent::StartupReady:    return QStringLiteral("🚀 화면 준비 완료");
+    case LogEvent::ModeChangeFailed: return QStringLiteral("❌ 모드 전환 실패");
+    case LogEvent::ModeRolledBack:  return QStringLiteral("↩️ 모드 롤백");
+    case LogEvent::TlsPinMismatch:  return QStringLiteral("🔒 인증서 불일치");
+    case LogEvent::StreamStalled:   return QStringLiteral("🎥 영상 멈춤");
+    case LogEvent::StreamRecovered: return QStringLiteral("🎥 영상 복구");
+    case LogEvent::StreamHealth:    return QStringLiteral("🎥 영상 상태");
+    case LogEvent::PpeCompliant:    return QStringLiteral("✅ PPE 착용 확인");
+    }
+    return QString();
+}
+
+QString LogStore::detailsText(const LogEntry &entry)
+{
+    const QString sourceTime = entry.sourceTimestampMs
+        ? QDateTime::fromMSecsSinceEpoch(entry.sourceTimestampMs).toString("yyyy-MM-dd HH:mm:ss")
+        : QStringLiteral("-");
+
+    switch (entry.event) {
+    case LogEvent::HelmetMissing:
+    case LogEvent::VestMissing:
+    case LogEvent::PpeMissing:
+    case LogEvent::PpeCompliant:
+        return QString("👷 %1명 | ⛑️ %2명 | 🦺 %3명 | 신뢰도: %4")
+            .arg(entry.personCount).arg(entry.helmetCount).arg(entry.vestCount)
+            .arg(entry.confidence, 0, 'f', 2);
+    case LogEvent::Trespass:
+        return QString("감지 시각: %1 | 침입자 수: %2%3").arg(sourceTime).arg(entry.count)
+            .arg(entry.clipId ? QStringLiteral(" | 🎞️ 클립") : QString());
+    case LogEvent::AnomalyDetected:
+        return QStringLiteral("이상소음 발생");
+    case LogEvent::AnomalyCleared:
+        return QStringLiteral("이상소음 정상 상태");
+    case LogEvent::Fall:
+        return QString("낙상 감지 시각: %1%2").arg(sourceTime)
+            .arg(entry.clipId ? QStringLiteral(" | 🎞️ 클립") : QString());
+    case LogEvent::HealthStatus:
+        return QString("🌡️ 온도: %1°C | 💡 밝기: %2 | 🔔 버저: %3 | 💡 LED: %4")
+            .arg(entry.temperature, 0, 'f', 2)
+            .arg(entry.light)
+            .arg(entry.buzzerOn ? "ON" : "OFF")
+            .arg(entry.ledOn ? "ON" : "OFF");
+    case LogEvent::HealthTimeout:
+        return QStringLiteral("STM 상태 응답이 5초 내 도착하지 않았습니다");
+    case LogEvent::HealthNoSocket:
+        return QStringLiteral("웹소켓 연결이 없어 상태 요청 불가");
+    case LogEvent::StartupReady:
+        return QString("전체 첫 프레임까지 %1 ms (스트림 %2개)").arg(entry.durationMs).arg(entry.count);
+    case LogEvent::ModeChangeFailed:
+        return QString("%1 모드 전환 응답 없음 또는 서버 오류").arg(functionText(entry.function));
+    case LogEvent::ModeRolledBack:
+        return QString("부분 실패로 카메라 %1대를 이전 모드로 복원").arg(entry.count);
+    case LogEvent::TlsPinMismatch:
+        return QStringLiteral("고정된 인증서와 달라 연결을 거부했습니다 (카메라 재등록 시 초기화)");
+    case LogEvent::StreamStalled:
+        return QString("%1 ms 동안 프레임 없음 - 해당 스트림 재시작").arg(entry.durationMs);
+    case LogEvent::StreamRecovered:
+        return QString("중단 %1초 | 재시작 %2회").arg(entry.durationMs / 1000.0, 0, 'f', 1).arg(entry.count);
+    case LogEvent::StreamHealth:
+        return QString("%1 fps | 지터 %2 ms").arg(entry.count).arg(entry.durationMs);
+    default:
+        return QString();
+    }
+}
+
+namespace {
+
+// "yyyy-MM-dd?HH:mm:ss" 19자 (10번째 구분자는 ' ' 또는 ISO 'T') → epoch ms (로컬 시각 기준)
+qint64 timestampFromDigits(const char *text)
+{
+    auto digits = [text](int at, int count, int *value) {
+        int result = 0;
+        for (int i = at; i < at + count; ++i) {
+            if (text[i] < '0' || text[i] > '9')
+                return false;
+            result = result * 10 + (text[i] - '0');
+        }
+        *value = result;
+        return true;
+    };
+
+    int year, month, day, hour, minute, second;
+    if (!digits(0, 4, &year) || text[4] != '-' || !digits(5, 2, &month) || text[7] != '-' || !digits(8, 2, &day)
+        || (text[10] != ' ' && text[10] != 'T')
+        || !digits(11, 2, &hour) || text[13] != ':' || !digits(14, 2, &minute) || text[16] != ':' || !digits(17, 2, &second))
+        return 0;
+
+    const QDate date(year, month, day);
+    const QTime time(hour, minute, second);
+    if (!date.isValid() || !time.isValid())
+        return 0;
+    return QDateTime(date, time).toMSecsSinceEpoch();
+}
+
+} // namespace
+
+qint64 LogStore::parseServerTimestamp(const QString &ts)
+{
+    if (ts.size() < 19)
+        return 0;
+
+    char text[19];
+    for (int i = 0; i < 19; ++i)
+        text[i] = ts.at(i).toLatin1();
+    return timestampFromDigits(text);
+}
+
+qint64 LogStore::parseServerTimestamp(std::string_view ts)
+{
+    return ts.size() < 19 ? 0 : timestampFromDigits(ts.data());
+}
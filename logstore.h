@@ -0,0 +1,89 @@
+#ifndef LOGSTORE_H
+#define LOGSTORE_H
+
+#include "logentry.h"
+
+#include <QVector>
+#include <QHash>
+#include <QString>
+
+#include <string_view>
+
+// 압축된 LogEntry 목록 + 카메라/이미지 경로 문자열 테이블
+// 표시 문자열은 저장하지 않고, 화면에 보이는 행에 대해서만 만들어 씀
+class LogStore
+{
+public:
+    static constexpr quint16 SystemCameraId = 0;
+
+    LogStore();
+
+    // 카메라 이름/IP → 작은 정수 id (처음 보는 카메라면 테이블에 추가)
+    quint16 cameraId(const QString &name, const QString &ip);
+    QString cameraName(quint16 id) const;
+    QString cameraIp(quint16 id) const;
+    int cameraCount() const { return cameras.size(); }  // id는 0 ~ cameraCount() - 1
+
+    // 이미지 경로 → id (빈 경로는 0) - 같은 경로는 같은 id (문자열 한 벌만 보관)
+    quint32 internImage(const QString &path);
+    QString imagePath(const LogEntry &entry) const;
+
+    // 이벤트 클립 파일 경로 → id (빈 경로는 0, 같은 클립에 묶인 이벤트는 같은 id)
+    quint32 internClip(const QString &path);
+    QString clipPath(const LogEntry &entry) const;
+
+    void prepend(const LogEntry &entry);
+    void append(const LogEntry &entry);
+    void clear();
+
+    // 보관 한도 (0 = 무제한) - 넘으면 뒤쪽(오래된) 항목부터 버리고 참조가 끊긴 경로도 정리
+    // 매 추가마다 자르지 않도록 한도의 1/16만큼 넘쳤을 때 한 번에 정리
+    void setMaxEntries(int maxEntries);
+    int maxEntries() const { return entryLimit; }
+    qint64 memoryUsage() const;  // 항목 + 문자열 테이블 대략적 바이트 수
+
+    int size() const { return entries.size(); }
+    const LogEntry &at(int index) const { return entries.at(index); }
+    // 기록 시각 + 카메라 + 이벤트가 같은 항목의 위치 (없으면 -1) - 추가/정리로 위치가 바뀌어도 같은 항목을 찾음
+    // 실시간 항목은 앞쪽에 있으므로 앞에서부터 찾음
+    int indexOf(qint64 timestampMs, quint16 cameraId, LogEvent event) const;
+    const QVector<LogEntry> &all() const { return entries; }
+
+    // 표시용 문자열 생성
+    static QString functionText(LogFunction function);
+    static QString dateText(const LogEntry &entry);
+    static QString timeText(const LogEntry &entry);
+    static QString eventText(const LogEntry &entry);
+    static QString detailsText(const LogEntry &entry);
+
+    // 서버 timestamp 문자열 ("yyyy-MM-dd HH:mm:ss" 또는 ISO) → epoch ms, 실패 시 0
+    // (timestampMs가 0인 항목은 날짜/시각을 빈 문자열로 표시 - 1970-01-01로 보이지 않게)
+    // 수신 프레임의 UTF-8 뷰를 그대로 받는 오버로드는 임시 문자열 없이 자릿수만 읽음
+    static qint64 parseServerTimestamp(const QString &ts);
+    static qint64 parseServerTimestamp(std::string_view ts);
+
+private:
+    void trimTo(int maxEntries);
+
+    struct CameraRef {
+        QString name;
+        QString ip;
+    };
+
+    QVector<LogEntry> entries;
+    int entryLimit = 0;
+
+    QVector<CameraRef> cameras;            // index = cameraId
+    QHash<QString, quint16> cameraIds;     // "name\nip" → cameraId
+    QHash<QString, quint16> cameraIdByIp;  // 이벤트마다 키 문자열을 만들지 않도록 IP별 마지막 id
+
+    QHash<quint32, QString> imagePaths;    // imageId → 경로
+    QHash<QString, quint32> imageIds;      // 경로 → imageId (중복 제거, trimTo에서 함께 정리)
+    quint32 nextImageId = 1;
+
+    QHash<quint32, QString> clipPaths;     // clipId → 로컬 파일 경로
+    QHash<QString, quint32> clipIds;       // 경로 → clipId
+    quint32 nextClipId = 1;
+};
+
+#endif // LOGSTORE_H
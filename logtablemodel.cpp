@@ -0,0 +1,63 @@
+#include "logtablemodel.h"
+
+LogTableModel::LogTableModel(const LogStore *store, QObject *parent)
+    : QAbstractTableModel(parent), store(store)
+{
+    reload();
+}
+
+void LogTableModel::reload()
+{
+    beginResetModel();
+    snapshot = store ? store->all() : QVector<LogEntry>();
+    endResetModel();
+}
+
+const LogEntry *LogTableModel::entryAt(int row) const
+{
+    if (row < 0 || row >= snapshot.size())
+        return nullptr;
+    return &snapshot.at(row);
+}
+
+int LogTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(snapshot.size());
+}
+
+int LogTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 7;
+}
+
+QVariant LogTableModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid())
+        return QVariant();
+
+    const LogEntry *entry = entryAt(index.row());
+    if (!entry)
+        return QVariant();
+
+    switch (index.column()) {
+    case 0: return QString::number(entry->zone);                              // Streaming Zone
+    case 1: return store ? store->cameraName(entry->cameraId) : QString();    // Camera
+    case 2: return LogStore::dateText(*entry);                                // Date
+    case 3: return LogStore::timeText(*entry);                                // Time
+    case 4: return LogStore::functionText(entry->function);                   // Function
+    case 5: return LogStore::eventText(*entry);                               // Event
+    case 6: return LogStore::detailsText(*entry);                             // Details
+    }
+    return QVariant();
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QVariant();
+
+    static const QStringList headers = {
+        "Streaming Zone", "Camera", "Date", "Time", "Function", "Event", "Details"
+    };
+    return section >= 0 && section < headers.size() ? QVariant(headers.at(section)) : QVariant();
+}
@@ -0,0 +1,29 @@
+#ifndef LOGTABLEMODEL_H
+#define LOGTABLEMODEL_H
+
+#include "logstore.h"
+
+#include <QAbstractTableModel>
+
+// LogStore 스냅샷을 보여주는 모델 - 화면에 보이는 셀만 data()에서 문자열로 변환
+class LogTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit LogTableModel(const LogStore *store, QObject *parent = nullptr);
+
+    void reload();  // 현재 LogStore 내용으로 스냅샷 갱신
+    const LogEntry *entryAt(int row) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    const LogStore *store = nullptr;
+    QVector<LogEntry> snapshot;  // 암시적 공유 - 복사 비용 없음
+};
+
+#endif // LOGTABLEMODEL_H
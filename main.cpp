@@ -1,14 +1,38 @@
 #include <QApplication>
 #include "loginwindow.h"
+#include "appoptions.h"
+#include "activitykernel.h"
+#include "ingestbench.h"
+#include "startuptimeline.h"
+
+#include <QTextStream>
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
+    StartupTimeline::start();  // 로그인 → 첫 프레임 등 시작 구간 측정 기준
 
     // Set application properties
     app.setApplicationName("QtClientSSN Camera Monitoring System");
     app.setApplicationVersion("1.0");
 
+    // 실행 옵션 (--record / --replay / --replay-speed / --replay-loop / --gateway / --bench-activity / --bench-ingest / --kiosk / --memory-budget-mb)
+    const AppOptions &options = AppOptions::parse(app);
+
+    if (options.benchActivity) {
+        // 썸네일 크기 (ActivityAnalyzer 기본) + 720p 전체 크기 참고치
+        QTextStream out(stdout);
+        out << ActivityKernel::benchmark(64, 48, 200000) << "\n";
+        out << ActivityKernel::benchmark(1280, 720, 2000) << "\n";
+        return 0;
+    }
+
+    if (options.benchIngest) {
+        QTextStream out(stdout);
+        out << IngestBench::run(200000) << "\n";
+        return 0;
+    }
+
     // Create and show login window
     LoginWindow loginWindow;
     loginWindow.show();
@@ -1,6 +1,12 @@
 #include "mainwindow.h"
+#include "appoptions.h"
 #include "cameralistdialog.h"
 #include "loghistorydialog.h"
+#include "cameraregistry.h"
+#include "diagnosticsdialog.h"
+#include "statsdialog.h"
+#include "startuptimeline.h"
+#include "alertpanel.h"
 
 // UI 관련 위젯
 #include <QLabel>
@@ -8,6 +14,7 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QScrollArea>
+#include <QInputDialog>
 
 // 알림창
 #include <QMessageBox>
@@ -21,21 +28,145 @@
 
 // 네트워크 요청 처리
 #include <QNetworkReply>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QVideoSink>
 
 // 주기적인 작업용
 #include <QTimer>
+#include <QUrlQuery>
+
+namespace {
+
+// 서버 모드 문자열 → 로그 기능 구분
+LogFunction functionForMode(const QString &mode)
+{
+    if (mode == "blur") return LogFunction::Blur;
+    if (mode == "detect") return LogFunction::PPE;
+    if (mode == "trespass") return LogFunction::Night;
+    if (mode == "fall") return LogFunction::Fall;
+    return LogFunction::Raw;
+}
+
+} // namespace
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
+    // REST API 통신용 (ONVIF SOAP 요청도 공유)
+    networkManager = new QNetworkAccessManager(this);
+    onvifClient = new OnvifClient(networkManager, this);
+
+    // ✅ 카메라 TLS - 인증서는 최초 연결 때 고정하고 레지스트리에 저장
+    cameraTls = new CameraTls(this);
+    cameraTls->attach(networkManager);
+    connect(cameraTls, &CameraTls::pinned, this, [this](const QString &host, const QString &fingerprint) {
+        if (CameraInfo *camera = findCameraByIp(host); camera && camera->tlsFingerprint != fingerprint) {
+            camera->tlsFingerprint = fingerprint;
+            scheduleRegistrySave();
+        }
+    });
+    connect(cameraTls, &CameraTls::pinMismatch, this, [this](const QString &host) {
+        if (tlsMismatchLogged.contains(host))
+            return;
+        tlsMismatchLogged.insert(host);
+        const CameraInfo *camera = findCameraByIp(host);
+        addLogEntry(makeLogEntry(camera ? camera->name : host, host, LogFunction::Health, LogEvent::TlsPinMismatch));
+    });
+
+    // ✅ 카메라 HTTP 요청은 모두 httpClient 경유 (카메라별 동시 요청 제한, HTTP/2, 이미지 캐시)
+    httpClient = new CameraHttpClient(networkManager, cameraTls, this);
+
     videoPlayerManager = new VideoPlayerManager(this);
+    videoPlayerManager->setOnvifClient(onvifClient);
+    connect(videoPlayerManager, &VideoPlayerManager::firstFrame, this, &MainWindow::onStreamFirstFrame);
+
+    // ✅ 영상 스트림 상태 - 멈춤/복구를 STM 헬시 체크와 같은 로그(Health)로
+    StreamHealthMonitor *streamHealth = videoPlayerManager->streamHealth();
+    connect(streamHealth, &StreamHealthMonitor::stalled, this, [this](const QString &id, qint64 silenceMs) {
+        logStreamHealth(id, LogEvent::StreamStalled, quint32(silenceMs), 0);
+    });
+    connect(streamHealth, &StreamHealthMonitor::recovered, this, [this](const QString &id, qint64 downtimeMs, int restarts) {
+        logStreamHealth(id, LogEvent::StreamRecovered, quint32(downtimeMs), restarts);
+    });
+
+    connect(videoPlayerManager, &VideoPlayerManager::snapshotReady, this, &MainWindow::saveSnapshot);
+    connect(videoPlayerManager, &VideoPlayerManager::snapshotsFinished, this, [this](int requested, int succeeded) {
+        qDebug() << "[스냅샷] 완료" << succeeded << "/" << requested;
+        if (requested == 0)
+            QMessageBox::information(this, "스냅샷", "재생 중인 화면이 없습니다.");
+        else
+            QMessageBox::information(this, "스냅샷", QString("%1장 저장됨\n%2").arg(snapshotFiles.size()).arg(snapshotFiles.join("\n")));
+        snapshotFiles.clear();
+    });
+
+    // ✅ 이벤트 클립 - 타일 프레임을 샘플링해 카메라별 이벤트 전 영상 보관
+    clipBuffer = new ClipBuffer(this);
+    connect(videoPlayerManager, &VideoPlayerManager::tileFrame, clipBuffer, &ClipBuffer::addFrame);
+
+    // ✅ 카메라별 모드 제어 - 동시 전송 후 ack 대기, 부분 실패 시 롤백
+    modeController = new ModeController([this](const QString &ip, const QString &mode) {
+        const CameraInfo *camera = findCameraByIp(ip);
+        return camera && sendModeChangeRequest(mode, *camera);
+    }, this);
+    connect(modeController, &ModeController::stateChanged, this, &MainWindow::onModeStateChanged);
+    connect(modeController, &ModeController::modeApplied, this, &MainWindow::onModeApplied);
+    connect(modeController, &ModeController::cameraModeAcked, this,
+            [this](const QString &ip, const QString &mode, const QString &previousMode) {
+        // 실제로 모드가 바뀐 카메라만 processed 스트림 재연결 (최초 적용, 같은 모드 재적용은 제외)
+        if (!previousMode.isEmpty() && previousMode != mode)
+            videoPlayerManager->restartStream(ip);
+    });
+
+    // ✅ 수신 메시지는 큐를 거쳐 시간 예산 안에서 디스패치
+    ingestQueue = new IngestQueue([this](const QString &ip, const EventFrame &frame) {
+        if (eventDispatcher.dispatch(ip, frame))
+            StartupTimeline::mark(StartupMilestone::FirstEvent);
+    }, this);
+
+    // ✅ 서버 이벤트 타입별 핸들러 등록 + 에스컬레이션 규칙 (escalation_rules.json)
+    setupEventHandlers();
+    ruleEngine.setRules(RuleEngine::loadRules());
+
+    // ✅ 저장된 카메라 레지스트리 복원 (변경 시 디바운스 저장)
+    registrySaveTimer = new QTimer(this);
+    registrySaveTimer->setSingleShot(true);
+    registrySaveTimer->setInterval(500);
+    connect(registrySaveTimer, &QTimer::timeout, this, [this]() { CameraRegistry::save(cameraList); });
+
+    cameraList = CameraRegistry::load();
+    startupTimer.start();
+
+    // ✅ 게이트웨이 모드 - 설정 시 카메라 웹소켓 대신 로컬 게이트웨이 하나로 연결
+    const AppOptions &options = AppOptions::current();
+    gatewayUrl = options.gatewayUrl;
+    if (!gatewayUrl.isEmpty())
+        qDebug() << "[Gateway] 게이트웨이 모드:" << gatewayUrl.toString();
+
+    // ✅ 이벤트 기록 / 재생 - 재생 중에는 카메라 연결 없이 기록된 메시지만 처리
+    replayMode = options.isReplay();
+    if (!options.recordPath.isEmpty()) {
+        eventRecorder = new EventRecorder(this);
+        eventRecorder->open(options.recordPath);
+    }
 
     setupUI();
-    setWindowTitle("Smart SafetyNet");
-    showMaximized();  // ✅ 전체 화면으로 시작
+    setWindowTitle(replayMode ? "Smart SafetyNet (재생)" : "Smart SafetyNet");
 
-    // REST API 통신용
-    networkManager = new QNetworkAccessManager(this);
+    // ✅ 셸(빈 그리드/로그/기능 패널)을 먼저 띄우고, 카메라 연결/스트림/로그 동기화는 이벤트 루프 진입 후 시작
+    QTimer::singleShot(0, this, &MainWindow::startNetwork);
+    if (replayMode)
+        QTimer::singleShot(0, this, &MainWindow::startReplay);  // 창이 뜬 뒤 시작
+
+    // ✅ 키오스크 - 몇 주씩 무인 실행되므로 캐시 전체를 하나의 메모리 예산으로 묶음
+    if (options.memoryBudgetMb > 0)
+        setupMemoryBudget(options.memoryBudgetMb);
+
+    if (options.kiosk)
+        showFullScreen();
+    else
+        showMaximized();  // ✅ 전체 화면으로 시작
 
     // mainwindow의 스타일 시트 설정 : 전체 윈도우 스타일에 적용 - 다크모드, 버튼/테이블/라벨 전체 통일 디자인
     setStyleSheet(R"(
@@ -56,7 +187,11 @@ MainWindow::MainWindow(QWidget *parent)
 
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow()
+{
+    if (registrySaveTimer->isActive())
+        CameraRegistry::save(cameraList);  // 대기 중인 변경사항 저장
+}
 
 void MainWindow::setupUI() {
     centralWidget = new QWidget(this);
@@ -72,8 +207,7 @@ void MainWindow::setupUI() {
     setupLogSection();
     setupFunctionPanel();
     setupMainLayout();
-
-    refreshVideoGrid();
+    // refreshVideoGrid()는 창이 뜬 뒤 startNetwork()에서
 }
 
 void MainWindow::setupTopBar() {
@@ -91,7 +225,7 @@ void MainWindow::setupTopBar() {
 
 void MainWindow::setupOnvifSection()
 {
-    onvifPlayer = new QMediaPlayer(this);
+    onvifPlayer = videoPlayerManager->playerPool()->acquire();  // 그리드와 같은 풀에서 관리
     onvifVideoItem = new QGraphicsVideoItem();
     onvifVideoItem->setSize(QSizeF(640, 360));
 
@@ -102,9 +236,27 @@ void MainWindow::setupOnvifSection()
     onvifView->setFixedSize(640, 360);
     onvifView->setStyleSheet("background-color: black; border: none; margin: 0px; padding: 0px;");
 
-    onvifPlayer->setVideoOutput(onvifVideoItem);
-    onvifPlayer->setSource(QUrl("rtsp://192.168.0.35:554/0/onvif/profile2/media.smp"));
-    onvifPlayer->play();
+    if (onvifPlayer) {
+        onvifPlayer->setVideoOutput(onvifVideoItem);  // 소스는 카메라 레지스트리의 ONVIF 카메라에서 선택
+
+        // 상단 ONVIF 뷰도 그리드와 같은 스트림 감시 - 멈추면 이 플레이어만 재시작
+        StreamHealthMonitor *streamHealth = videoPlayerManager->streamHealth();
+        connect(onvifVideoItem->videoSink(), &QVideoSink::videoFrameChanged, this, [this, streamHealth]() {
+            if (!onvifStreamId.isEmpty())
+                streamHealth->frameArrived(onvifStreamId);
+        });
+        connect(onvifPlayer, &QMediaPlayer::errorOccurred, this, [this, streamHealth](QMediaPlayer::Error, const QString &message) {
+            if (!onvifStreamId.isEmpty())
+                streamHealth->reportError(onvifStreamId, message);
+        });
+        connect(streamHealth, &StreamHealthMonitor::restartRequested, this, [this](const QString &id) {
+            if (id != onvifStreamId || onvifStreamUrl.isEmpty())
+                return;
+            onvifPlayer->stop();
+            onvifPlayer->setSource(QUrl(onvifStreamUrl));
+            onvifPlayer->play();
+        });
+    }
 
     onvifSection = new QWidget();
     onvifSection->setFixedHeight(400);  // 360 + label 여유
@@ -119,6 +271,24 @@ void MainWindow::setupOnvifSection()
     labelLayout->addStretch();  // 선택사항: 오른쪽 정렬용
     qDebug() << "ONVIF height:" << label->sizeHint().height();
 
+    // ✅ 레지스트리에 등록된 ONVIF 카메라 중 상단 뷰에 표시할 카메라 선택
+    onvifCameraComboBox = new QComboBox();
+    onvifCameraComboBox->setMinimumWidth(160);
+    connect(onvifCameraComboBox, &QComboBox::currentIndexChanged, this, [this](int) {
+        playSelectedOnvifCamera();
+    });
+    labelLayout->addWidget(onvifCameraComboBox);
+
+    // 프로파일 조회가 끝나면 상단 뷰 갱신 (그리드는 VideoPlayerManager가 직접 갱신)
+    connect(onvifClient, &OnvifClient::profilesReady, this, [this](const QString &ip) {
+        if (onvifCameraComboBox->currentData().toString() == ip)
+            playSelectedOnvifCamera();
+    });
+    connect(onvifClient, &OnvifClient::discoveryFailed, this, [this](const QString &ip) {
+        if (onvifCameraComboBox->currentData().toString() == ip)
+            QTimer::singleShot(onvifClient->retryDelayMs(ip), Qt::PreciseTimer, this, &MainWindow::playSelectedOnvifCamera);
+    });
+
     onvifLayout->addLayout(labelLayout);
     onvifLayout->addWidget(onvifView);
 
@@ -126,6 +296,212 @@ void MainWindow::setupOnvifSection()
 
 }
 
+void MainWindow::updateOnvifSection()
+{
+    const QString previousIp = onvifCameraComboBox->currentData().toString();
+
+    onvifCameraComboBox->blockSignals(true);
+    onvifCameraComboBox->clear();
+    for (const CameraInfo &camera : cameraList) {
+        if (camera.isOnvif())
+            onvifCameraComboBox->addItem(camera.name, camera.ip);
+    }
+    if (onvifCameraComboBox->count() == 0)
+        onvifCameraComboBox->addItem("ONVIF 카메라 없음", QString());
+
+    int index = onvifCameraComboBox->findData(previousIp);
+    onvifCameraComboBox->setCurrentIndex(index >= 0 ? index : 0);
+    onvifCameraComboBox->blockSignals(false);
+
+    playSelectedOnvifCamera();
+}
+
+void MainWindow::playSelectedOnvifCamera()
+{
+    if (!onvifPlayer)
+        return;
+
+    const CameraInfo *camera = findCameraByIp(onvifCameraComboBox->currentData().toString());
+    if (!camera || !camera->isOnvif()) {
+        onvifPlayer->stop();
+        onvifPlayer->setSource(QUrl());
+        onvifStreamUrl.clear();
+        watchOnvifStream(QString());
+        return;
+    }
+
+    if (!onvifClient->hasProfiles(camera->ip)) {
+        onvifClient->discover(*camera);  // 완료 시 profilesReady → 다시 호출됨
+
+        // 저장된 프로파일이 있으면 조회를 기다리지 않고 바로 재생
+        if (!camera->preferredStreamUri.isEmpty() && onvifStreamUrl != camera->preferredStreamUri) {
+            onvifPlayer->setSource(QUrl(camera->onvifPlaybackUrl(camera->preferredStreamUri)));
+            onvifPlayer->play();
+            onvifStreamUrl = camera->preferredStreamUri;
+            watchOnvifStream(camera->ip);
+        }
+        return;
+    }
+
+    // 뷰 크기를 채우는 가장 낮은 프로파일 선택
+    OnvifProfile profile = OnvifClient::selectProfile(onvifClient->profiles(camera->ip), onvifView->size());
+
+    if (CameraInfo *stored = findCameraByIp(camera->ip); stored && stored->preferredStreamUri != profile.streamUri) {
+        stored->preferredProfile = profile.token;
+        stored->preferredStreamUri = profile.streamUri;
+        scheduleRegistrySave();
+    }
+
+    if (profile.streamUri == onvifStreamUrl && onvifPlayer->playbackState() == QMediaPlayer::PlayingState)
+        return;
+
+    onvifPlayer->stop();
+    onvifPlayer->setSource(QUrl(camera->onvifPlaybackUrl(profile.streamUri)));
+    onvifPlayer->play();
+    onvifStreamUrl = profile.streamUri;
+    watchOnvifStream(camera->ip);
+
+    qDebug() << "[ONVIF] 프로파일 선택:" << profile.name << profile.resolution;
+}
+
+void MainWindow::setupMemoryBudget(int budgetMb)
+{
+    memoryBudget = new MemoryBudget(qint64(budgetMb) * 1024 * 1024, this);
+
+    // 예산 비율 합계 ~40% - 나머지는 Qt / 디코더 / 위젯 몫
+    memoryBudget->registerCache("로그", 10, [this]() { return logStore.memoryUsage(); },
+                                [this](qint64 limitBytes) {
+        const qint64 perEntry = logStore.size() > 0
+            ? qMax<qint64>(sizeof(LogEntry), logStore.memoryUsage() / logStore.size())
+            : qint64(sizeof(LogEntry));
+        logStore.setMaxEntries(static_cast<int>(qMax<qint64>(1000, limitBytes / perEntry)));
+    });
+    memoryBudget->registerCache("이미지 캐시", 8, [this]() { return httpClient->memoryUsage(); },
+                                [this](qint64 limitBytes) { httpClient->setImageCacheBytes(limitBytes); });
+    memoryBudget->registerCache("이벤트 클립", 20, [this]() { return clipBuffer->memoryUsage(); },
+                                [this](qint64 limitBytes) { clipBuffer->setMemoryLimit(limitBytes); });
+    memoryBudget->registerCache("카메라 상태", 1, [this]() {
+        const qint64 keys = recentBlurLogKeys.size() + anomalyActive.size() + healthCheckRequestTime.size()
+                          + healthCheckResponded.size() + tlsMismatchLogged.size() + socketMap.size();
+        return keys * 96 + statsAggregator.memoryUsage();  // 키 문자열 + 해시 노드 대략치, 통계 버킷은 카메라당 고정
+    }, [this](qint64) { pruneCameraState(); });
+    memoryBudget->enforce();
+
+    connect(memoryBudget, &MemoryBudget::budgetExceeded, this, [this](qint64 residentBytes, qint64 budgetBytes) {
+        qWarning().noquote() << "[MemoryBudget] 예산 초과" << residentBytes / (1024 * 1024) << "/"
+                             << budgetBytes / (1024 * 1024) << "MB\n" << memoryBudget->statsText();
+    });
+}
+
+QString MainWindow::ppeTallyText() const
+{
+    if (ppeTally.isEmpty())
+        return QString("PPE 감지 없음");
+
+    QString text;
+    for (auto it = ppeTally.cbegin(); it != ppeTally.cend(); ++it) {
+        const PpeTally &tally = it.value();
+        text += QString("%1: %2건 | 착용 %3 | 헬멧 %4 | 조끼 %5 | 모두 %6\n")
+                    .arg(logStore.cameraName(it.key()), -12)
+                    .arg(tally.total())
+                    .arg(tally.compliant)
+                    .arg(tally.helmetMissing)
+                    .arg(tally.vestMissing)
+                    .arg(tally.bothMissing);
+    }
+    return text.trimmed();
+}
+
+void MainWindow::pruneCameraState()
+{
+    QSet<QString> ips;
+    QSet<QString> names;
+    for (const CameraInfo &camera : std::as_const(cameraList)) {
+        ips.insert(camera.ip);
+        names.insert(camera.name);
+    }
+
+    for (auto it = anomalyActive.begin(); it != anomalyActive.end();)
+        it = names.contains(it.key()) ? std::next(it) : anomalyActive.erase(it);
+    for (auto it = healthCheckRequestTime.begin(); it != healthCheckRequestTime.end();)
+        it = ips.contains(it.key()) ? std::next(it) : healthCheckRequestTime.erase(it);
+    for (auto it = healthCheckResponded.begin(); it != healthCheckResponded.end();)
+        it = ips.contains(*it) ? std::next(it) : healthCheckResponded.erase(it);
+    for (auto it = tlsMismatchLogged.begin(); it != tlsMismatchLogged.end();)
+        it = ips.contains(*it) ? std::next(it) : tlsMismatchLogged.erase(it);
+    for (auto it = logSyncCursors.begin(); it != logSyncCursors.end();)
+        it = ips.contains(it.key()) ? std::next(it) : logSyncCursors.erase(it);
+
+    // 삭제된 카메라의 모드 상태 (진행 중 batch에서도 빠져 modeApplied가 그 카메라를 기다리지 않음)
+    for (const QString &ip : modeController->cameras()) {
+        if (!ips.contains(ip))
+            modeController->removeCamera(ip);
+    }
+
+    // 규칙 윈도우 / 수신 큐 / PPE 판정 건수는 소켓과 무관하게 IP 기준 (게이트웨이 모드에는 socketMap이 비어 있음)
+    for (const QString &ip : ruleEngine.cameras()) {
+        if (!ips.contains(ip))
+            ruleEngine.removeCamera(ip);
+    }
+    for (const QString &ip : ingestQueue->cameras()) {
+        if (!ips.contains(ip))
+            ingestQueue->removeCamera(ip);
+    }
+    for (auto it = ppeTally.begin(); it != ppeTally.end();)
+        it = ips.contains(logStore.cameraIp(it.key())) ? std::next(it) : ppeTally.erase(it);
+
+    // 게이트웨이 모드 - 삭제된 카메라는 구독 해제 (게이트웨이가 업스트림 연결을 닫음)
+    unsubscribeGatewayCameras();
+
+    // 삭제된 카메라의 웹소켓은 닫고 해제 (재연결 타이머/시그널 연결도 함께 사라짐)
+    for (auto it = socketMap.begin(); it != socketMap.end();) {
+        if (ips.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        qDebug() << "[WebSocket] 삭제된 카메라 소켓 정리:" << it.key();
+        QWebSocket *socket = it.value();
+        socket->disconnect(this);
+        socket->close();
+        socket->deleteLater();
+        it = socketMap.erase(it);
+    }
+}
+
+void MainWindow::watchOnvifStream(const QString &ip)
+{
+    StreamHealthMonitor *streamHealth = videoPlayerManager->streamHealth();
+    if (!onvifStreamId.isEmpty())
+        streamHealth->unwatch(onvifStreamId);
+    onvifStreamId = ip.isEmpty() ? QString() : "view:" + ip;
+    if (!onvifStreamId.isEmpty())
+        streamHealth->watch(onvifStreamId);
+}
+
+void MainWindow::logStreamHealth(const QString &id, LogEvent event, quint32 durationMs, int count)
+{
+    const QString ip = id.startsWith("view:") ? id.mid(5) : id;
+    const CameraInfo *camera = findCameraByIp(ip);
+    LogEntry entry = makeLogEntry(camera ? camera->name : ip, ip, LogFunction::Health, event);
+    entry.durationMs = durationMs;
+    entry.count = toLogCount(count);
+    addLogEntry(entry);
+}
+
+const CameraInfo *MainWindow::findCameraByIp(const QString &ip) const
+{
+    for (const CameraInfo &camera : cameraList) {
+        if (camera.ip.trimmed() == ip.trimmed())  // 공백 방지
+            return &camera;
+    }
+    return nullptr;
+}
+
+CameraInfo *MainWindow::findCameraByIp(const QString &ip)
+{
+    return const_cast<CameraInfo *>(std::as_const(*this).findCameraByIp(ip));
+}
+
 void MainWindow::setupPiVideoSection()
 {
     QLabel *streamingLabel = new QLabel("Video Streaming");
@@ -134,11 +510,39 @@ void MainWindow::setupPiVideoSection()
     cameraListButton = new QPushButton("카메라 리스트");
     connect(cameraListButton, &QPushButton::clicked, this, &MainWindow::onCameraListClicked);
 
+    // ✅ 그리드 레이아웃 선택 + 페이지 이동
+    gridLayoutComboBox = new QComboBox();
+    gridLayoutComboBox->addItems({"1x1", "2x2", "3x3", "4x4", "사용자 지정..."});
+    gridLayoutComboBox->setCurrentIndex(1);  // 기본 2x2
+    connect(gridLayoutComboBox, &QComboBox::activated, this, &MainWindow::onGridLayoutSelected);
+
+    prevPageButton = new QPushButton("◀");
+    nextPageButton = new QPushButton("▶");
+    prevPageButton->setFixedWidth(32);
+    nextPageButton->setFixedWidth(32);
+    pageLabel = new QLabel("1 / 1");
+
+    connect(prevPageButton, &QPushButton::clicked, this, [this]() {
+        videoPlayerManager->setPage(videoPlayerManager->page() - 1);
+    });
+    connect(nextPageButton, &QPushButton::clicked, this, [this]() {
+        videoPlayerManager->setPage(videoPlayerManager->page() + 1);
+    });
+    connect(videoPlayerManager, &VideoPlayerManager::pageChanged, this, [this](int page, int pageCount) {
+        pageLabel->setText(QString("%1 / %2").arg(page + 1).arg(pageCount));
+        prevPageButton->setEnabled(page > 0);
+        nextPageButton->setEnabled(page + 1 < pageCount);
+    });
+
     streamingHeaderLayout = new QHBoxLayout();
     streamingHeaderLayout->setContentsMargins(0, 0, 0, 0);  // ✅ 좌우 여백 제거
     streamingHeaderLayout->setSpacing(5);                  // ✅ 라벨-버튼 간격 줄임
     streamingHeaderLayout->addWidget(streamingLabel);
     streamingHeaderLayout->addStretch();
+    streamingHeaderLayout->addWidget(gridLayoutComboBox);
+    streamingHeaderLayout->addWidget(prevPageButton);
+    streamingHeaderLayout->addWidget(pageLabel);
+    streamingHeaderLayout->addWidget(nextPageButton);
     streamingHeaderLayout->addWidget(cameraListButton);
 
     videoArea = new QWidget();
@@ -151,8 +555,38 @@ void MainWindow::setupPiVideoSection()
     scrollArea = new QScrollArea();
     scrollArea->setWidgetResizable(true);
     scrollArea->setWidget(videoArea);
-    scrollArea->setFixedWidth(2 * 320 + 20);  // scroll bar 고려 여유 포함
+    scrollArea->setFixedWidth(640 + 20);  // scroll bar 고려 여유 포함
     scrollArea->setFrameStyle(QFrame::NoFrame);
+
+    videoPlayerManager->setGridWidth(640);  // 타일 크기는 레이아웃(행 x 열)에 맞춰 자동 계산
+}
+
+void MainWindow::onGridLayoutSelected(int index)
+{
+    static const int presets[][2] = { {1, 1}, {2, 2}, {3, 3}, {4, 4} };
+
+    if (index >= 0 && index < 4) {
+        videoPlayerManager->setGridLayout(presets[index][0], presets[index][1]);
+        return;
+    }
+
+    // 사용자 지정: "행x열" 입력
+    bool ok = false;
+    QString current = QString("%1x%2").arg(videoPlayerManager->gridRows()).arg(videoPlayerManager->gridColumns());
+    QString text = QInputDialog::getText(this, "사용자 지정 레이아웃", "행x열 (최대 8x8):",
+                                         QLineEdit::Normal, current, &ok);
+    if (!ok)
+        return;
+
+    QStringList parts = text.toLower().split('x');
+    int rows = parts.size() == 2 ? parts[0].trimmed().toInt() : 0;
+    int columns = parts.size() == 2 ? parts[1].trimmed().toInt() : 0;
+    if (rows < 1 || columns < 1 || rows > 8 || columns > 8) {
+        QMessageBox::warning(this, "입력 오류", "1x1 ~ 8x8 범위로 입력해주세요.");
+        return;
+    }
+
+    videoPlayerManager->setGridLayout(rows, columns);
 }
 
 
@@ -181,8 +615,18 @@ void MainWindow::setupLogSection() {
     QPushButton *logHistoryButton = new QPushButton("전체 로그 보기");
     connect(logHistoryButton, &QPushButton::clicked, this, &MainWindow::onLogHistoryClicked);
 
+    // 수신 폭주로 버리거나 병합한 이벤트 수 (발생 전에는 숨김)
+    ingestShedLabel = new QLabel();
+    ingestShedLabel->setStyleSheet("color: #ffae42;");
+    ingestShedLabel->hide();
+    connect(ingestQueue, &IngestQueue::shedCountChanged, this, [this](quint64 dropped, quint64 coalesced) {
+        ingestShedLabel->setText(QString("⚠️ 과부하: 버림 %1 / 병합 %2").arg(dropped).arg(coalesced));
+        ingestShedLabel->show();
+    });
+
     QHBoxLayout *logHeaderLayout = new QHBoxLayout();
     logHeaderLayout->addWidget(alertLabel);
+    logHeaderLayout->addWidget(ingestShedLabel);
     logHeaderLayout->addStretch();
     logHeaderLayout->addWidget(logHistoryButton);
 
@@ -227,114 +671,93 @@ void MainWindow::setupFunctionPanel() {
     nightIntrusionCheckBox = new QCheckBox("Night Intrusion");
     fallDetectionCheckBox = new QCheckBox("Fall Detection");
 
-    // ✅ Raw 체크박스
-    connect(rawCheckBox, &QCheckBox::toggled, this, [=](bool checked) {
-        if (checked) {
-            blurCheckBox->blockSignals(true); blurCheckBox->setChecked(false); blurCheckBox->blockSignals(false);
-            ppeDetectorCheckBox->blockSignals(true); ppeDetectorCheckBox->setChecked(false); ppeDetectorCheckBox->blockSignals(false);
-            nightIntrusionCheckBox->blockSignals(true); nightIntrusionCheckBox->setChecked(false); nightIntrusionCheckBox->blockSignals(false);
-            fallDetectionCheckBox->blockSignals(true); fallDetectionCheckBox->setChecked(false); fallDetectionCheckBox->blockSignals(false);
-
-            for (const CameraInfo &camera : cameraList)
-                sendModeChangeRequest("raw", camera);
-            switchStreamForAllPlayers("processed");
-            addLogEntry("System", "Raw", "Raw mode enabled", "", "", "");
-        }
-    });
-
-    // ✅ Blur 체크박스
-    connect(blurCheckBox, &QCheckBox::toggled, this, [=](bool checked) {
-        if (checked) {
-            rawCheckBox->blockSignals(true); rawCheckBox->setChecked(false); rawCheckBox->blockSignals(false);
-            ppeDetectorCheckBox->blockSignals(true); ppeDetectorCheckBox->setChecked(false); ppeDetectorCheckBox->blockSignals(false);
-            nightIntrusionCheckBox->blockSignals(true); nightIntrusionCheckBox->setChecked(false); nightIntrusionCheckBox->blockSignals(false);
-            fallDetectionCheckBox->blockSignals(true); fallDetectionCheckBox->setChecked(false); fallDetectionCheckBox->blockSignals(false);
-
-            for (const CameraInfo &camera : cameraList)
-                sendModeChangeRequest("blur", camera);
-            switchStreamForAllPlayers("processed");
-            addLogEntry("System", "Blur", "Blur mode enabled", "", "", "");
-        } else {
-            if (!rawCheckBox->isChecked() && !ppeDetectorCheckBox->isChecked()
-                && !nightIntrusionCheckBox->isChecked() && !fallDetectionCheckBox->isChecked()) {
-                rawCheckBox->setChecked(true);
+    modeCheckBoxes = {
+        { "raw", rawCheckBox },
+        { "blur", blurCheckBox },
+        { "detect", ppeDetectorCheckBox },
+        { "trespass", nightIntrusionCheckBox },
+        { "fall", fallDetectionCheckBox },
+    };
+
+    // ✅ 모드 체크박스 - 하나만 선택, 선택 시 대상 카메라에 적용
+    for (auto it = modeCheckBoxes.cbegin(); it != modeCheckBoxes.cend(); ++it) {
+        const QString mode = it.key();
+        QCheckBox *box = it.value();
+        connect(box, &QCheckBox::toggled, this, [=](bool checked) {
+            if (checked) {
+                for (QCheckBox *other : std::as_const(modeCheckBoxes)) {
+                    if (other == box) continue;
+                    other->blockSignals(true); other->setChecked(false); other->blockSignals(false);
+                }
+                applyModeFromPanel(mode);
+                return;
             }
-        }
-    });
 
-    // ✅ PPE Detector 체크박스
-    connect(ppeDetectorCheckBox, &QCheckBox::toggled, this, [=](bool checked) {
-        if (checked) {
-            rawCheckBox->blockSignals(true); rawCheckBox->setChecked(false); rawCheckBox->blockSignals(false);
-            blurCheckBox->blockSignals(true); blurCheckBox->setChecked(false); blurCheckBox->blockSignals(false);
-            nightIntrusionCheckBox->blockSignals(true); nightIntrusionCheckBox->setChecked(false); nightIntrusionCheckBox->blockSignals(false);
-            fallDetectionCheckBox->blockSignals(true); fallDetectionCheckBox->setChecked(false); fallDetectionCheckBox->blockSignals(false);
-
-            for (const CameraInfo &camera : cameraList)
-                sendModeChangeRequest("detect", camera);
-            switchStreamForAllPlayers("processed");
-            addLogEntry("System", "PPE", "PPE Detector enabled", "", "", "");
-        } else {
-            if (!rawCheckBox->isChecked() && !blurCheckBox->isChecked()
-                && !nightIntrusionCheckBox->isChecked() && !fallDetectionCheckBox->isChecked()) {
-                rawCheckBox->setChecked(true);
+            // 선택 해제로 아무 모드도 없으면 raw 모드로
+            for (QCheckBox *other : std::as_const(modeCheckBoxes)) {
+                if (other->isChecked()) return;
             }
-        }
-    });
-
-    // ✅ Night Intrusion 체크박스
-    connect(nightIntrusionCheckBox, &QCheckBox::toggled, this, [=](bool checked) {
-        if (checked) {
-            rawCheckBox->blockSignals(true); rawCheckBox->setChecked(false); rawCheckBox->blockSignals(false);
-            blurCheckBox->blockSignals(true); blurCheckBox->setChecked(false); blurCheckBox->blockSignals(false);
-            ppeDetectorCheckBox->blockSignals(true); ppeDetectorCheckBox->setChecked(false); ppeDetectorCheckBox->blockSignals(false);
-            fallDetectionCheckBox->blockSignals(true); fallDetectionCheckBox->setChecked(false); fallDetectionCheckBox->blockSignals(false);
-
-            for (const CameraInfo &camera : cameraList)
-                sendModeChangeRequest("trespass", camera);
-            switchStreamForAllPlayers("processed");
-            addLogEntry("System", "Night", "Night Intrusion enabled", "", "", "");
-        } else {
-            if (!rawCheckBox->isChecked() && !blurCheckBox->isChecked()
-                && !ppeDetectorCheckBox->isChecked() && !fallDetectionCheckBox->isChecked()) {
+            if (box == rawCheckBox) {
+                rawCheckBox->blockSignals(true); rawCheckBox->setChecked(true); rawCheckBox->blockSignals(false);
+            } else {
                 rawCheckBox->setChecked(true);
             }
-        }
-    });
+        });
+    }
 
-    // ✅ Fall Detection 체크박스
-    connect(fallDetectionCheckBox, &QCheckBox::toggled, this, [=](bool checked) {
-        if (checked) {
-            rawCheckBox->blockSignals(true); rawCheckBox->setChecked(false); rawCheckBox->blockSignals(false);
-            blurCheckBox->blockSignals(true); blurCheckBox->setChecked(false); blurCheckBox->blockSignals(false);
-            ppeDetectorCheckBox->blockSignals(true); ppeDetectorCheckBox->setChecked(false); ppeDetectorCheckBox->blockSignals(false);
-            nightIntrusionCheckBox->blockSignals(true); nightIntrusionCheckBox->setChecked(false); nightIntrusionCheckBox->blockSignals(false);
-
-            for (const CameraInfo &camera : cameraList)
-                sendModeChangeRequest("fall", camera);
-            switchStreamForAllPlayers("processed");
-            addLogEntry("System", "Fall", "Fall Detection enabled", "", "", "");
-        } else {
-            if (!rawCheckBox->isChecked() && !blurCheckBox->isChecked()
-                && !ppeDetectorCheckBox->isChecked() && !nightIntrusionCheckBox->isChecked()) {
-                rawCheckBox->setChecked(true);
-            }
-        }
-    });
+    // ✅ 모드 적용 대상 (전체 / 개별 카메라)
+    modeTargetComboBox = new QComboBox();
+    connect(modeTargetComboBox, &QComboBox::currentIndexChanged, this, [this]() { updateModeCheckBoxes(); });
+
+    // ✅ 카메라별 모드 상태 (요청 중 / 확인됨 / 실패)
+    modeStatusTable = new QTableWidget(0, 2);
+    modeStatusTable->setHorizontalHeaderLabels({"카메라", "모드"});
+    modeStatusTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    modeStatusTable->verticalHeader()->setVisible(false);
+    modeStatusTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    modeStatusTable->setSelectionMode(QAbstractItemView::NoSelection);
+    modeStatusTable->setFixedHeight(160);
 
     QPushButton *healthCheckButton = new QPushButton("헬시 체크");
     connect(healthCheckButton, &QPushButton::clicked, this, &MainWindow::performHealthCheck);
 
+    // ✅ 화면 움직임이 있는 타일에 테두리 표시 (클라이언트 프레임 차이 기반, 기본 꺼짐)
+    QCheckBox *activityCheckBox = new QCheckBox("활동 표시");
+    connect(activityCheckBox, &QCheckBox::toggled, this, &MainWindow::setActivityOverlayEnabled);
+
+    // ✅ 포커스 모드 - 알림/활동이 있는 카메라를 큰 화면으로, 나머지는 썸네일
+    QCheckBox *focusModeCheckBox = new QCheckBox("포커스 모드");
+    connect(focusModeCheckBox, &QCheckBox::toggled, videoPlayerManager, &VideoPlayerManager::setFocusMode);
+
+    // ✅ 스냅샷 - 적용 대상 카메라(전체면 재생 중인 모든 타일)의 현재 화면 저장
+    QPushButton *snapshotButton = new QPushButton("📸 스냅샷");
+    connect(snapshotButton, &QPushButton::clicked, this, &MainWindow::onSnapshotClicked);
+
+    // ✅ 카메라별 통계 (위반/낙상/침입/이상소음 - 최근 1시간/24시간)
+    QPushButton *statsButton = new QPushButton("📊 통계");
+    connect(statsButton, &QPushButton::clicked, this, &MainWindow::onStatsClicked);
+
+    QPushButton *diagnosticsButton = new QPushButton("진단");
+    connect(diagnosticsButton, &QPushButton::clicked, this, &MainWindow::onDiagnosticsClicked);
+
     QVBoxLayout *functionLayout = new QVBoxLayout();
     functionLayout->addWidget(functionLabelButton);
+    functionLayout->addWidget(new QLabel("적용 대상"));
+    functionLayout->addWidget(modeTargetComboBox);
     functionLayout->addWidget(rawCheckBox);
     functionLayout->addWidget(blurCheckBox);
     functionLayout->addWidget(ppeDetectorCheckBox);
     functionLayout->addWidget(nightIntrusionCheckBox);
     functionLayout->addWidget(fallDetectionCheckBox);
+    functionLayout->addWidget(modeStatusTable);
+    functionLayout->addWidget(activityCheckBox);
+    functionLayout->addWidget(focusModeCheckBox);
     functionLayout->addStretch();
 
     functionLayout->addWidget(healthCheckButton);
+    functionLayout->addWidget(snapshotButton);
+    functionLayout->addWidget(statsButton);
+    functionLayout->addWidget(diagnosticsButton);
 
     functionSection = new QWidget();
     functionSection->setLayout(functionLayout);
@@ -407,134 +830,101 @@ void MainWindow::refreshVideoGrid()
         return;
     }
 
-    // 화면 크기 조정
-    int total = std::max(4, static_cast<int>(cameraList.size()));
-    int columns = 2;
-    int rows = (total + 1) / 2;
-    videoArea->setMinimumSize(columns * 320, rows * 240);
-
     // ✅ 스트림 suffix는 항상 processed 고정
     QString streamSuffix = "processed";
 
-    // ✅ 아무 모드도 체크되지 않은 경우 → raw 모드 적용 및 서버에 먼저 전송
-    bool isRawMode = false;
-    if (!cameraList.isEmpty()
-        && !rawCheckBox->isChecked()
-        && !blurCheckBox->isChecked()
-        && !ppeDetectorCheckBox->isChecked()
-        && !nightIntrusionCheckBox->isChecked()
-        && !fallDetectionCheckBox->isChecked()) {
-
-        rawCheckBox->blockSignals(true);
-        rawCheckBox->setChecked(true);
-        rawCheckBox->blockSignals(false);
+    // ✅ 마지막 모드가 없는 카메라는 raw 모드로 시작 (소켓 연결 시 적용)
+    for (CameraInfo &camera : cameraList) {
+        if (camera.isOnvif() || !camera.lastMode.isEmpty()) continue;
+        camera.lastMode = "raw";
+    }
 
-        for (const CameraInfo &camera : cameraList)
-            sendModeChangeRequest("raw", camera);  // ✅ 먼저 서버에 raw 모드 요청
+    updateModeTargetComboBox();
+    updateModeCheckBoxes();
+    updateModeStatusTable();
+    pruneCameraState();
 
-        isRawMode = true;
+    if (replayMode) {
+        // 재생 중 - 카메라 연결/로그 동기화 없이 그리드만 구성
+        videoPlayerManager->setupVideoGrid(videoGridLayout, cameraList, streamSuffix);
+        return;
     }
 
-    // ✅ 스트리밍 구성: 항상 processed 스트림 사용
-    videoPlayerManager->setupVideoGrid(videoGridLayout, cameraList, streamSuffix);
-
-    // ✅ 카메라 리스트가 비어 있으면 체크박스 초기화
-    if (cameraList.isEmpty()) {
-        rawCheckBox->blockSignals(true);
-        blurCheckBox->blockSignals(true);
-        ppeDetectorCheckBox->blockSignals(true);
-        nightIntrusionCheckBox->blockSignals(true);
-        fallDetectionCheckBox->blockSignals(true);
+    // ✅ 저장된 인증서 고정 반영 + REST 연결 미리 맺기 (첫 로그 동기화가 핸드셰이크를 기다리지 않도록)
+    for (const CameraInfo &camera : cameraList) {
+        if (camera.isOnvif()) continue;
+        cameraTls->setPin(camera.ip, camera.tlsFingerprint);
+        cameraTls->warmUp(networkManager, camera.ip, 8443);
+    }
 
-        rawCheckBox->setChecked(false);
-        blurCheckBox->setChecked(false);
-        ppeDetectorCheckBox->setChecked(false);
-        nightIntrusionCheckBox->setChecked(false);
-        fallDetectionCheckBox->setChecked(false);
+    // ✅ 웹소켓(TLS 핸드셰이크)을 먼저 시작 - 스트림/로그 동기화와 병렬 진행
+    setupWebSocketConnections();
 
-        rawCheckBox->blockSignals(false);
-        blurCheckBox->blockSignals(false);
-        ppeDetectorCheckBox->blockSignals(false);
-        nightIntrusionCheckBox->blockSignals(false);
-        fallDetectionCheckBox->blockSignals(false);
-    }
+    // ✅ 로그 동기화 요청도 플레이어 생성(GUI 스레드 작업) 전에 보내 두어 응답 대기와 겹치게
+    loadInitialLogs();       // 초기 로그 불러오기 (실행 중 재동기화는 sync cursor 이후만)
 
-    // ✅ 로그 출력은 실제 적용 이후로
-    if (isRawMode) {
-        addLogEntry("System", "Raw", "Raw mode enabled", "", "", "");
+    // ✅ 스트리밍 구성: 항상 processed 스트림 사용 (현재 페이지 타일만 재생, 타일은 재사용)
+    videoPlayerManager->setupVideoGrid(videoGridLayout, cameraList, streamSuffix);
+    // 헬시 체크는 카메라별 소켓 연결 시점에 요청 (onSocketConnected)
+
+    // 시작 직후 첫 갱신에서만 전체 첫 프레임 시간 측정
+    if (!startupReported && startupPendingStreams.isEmpty()) {
+        for (const QString &ip : videoPlayerManager->liveCameraIps())
+            startupPendingStreams.insert(ip);
+        if (startupPendingStreams.isEmpty()) {
+            startupReported = true;
+        } else {
+            startupStreamCount = startupPendingStreams.size();
+            QTimer::singleShot(30000, this, [this]() { reportStartupReady(); });
+        }
     }
 
-    setupWebSocketConnections();
-    loadInitialLogs();       // 초기 로그 불러오기
-    performHealthCheck();    // 상태 체크
+    scheduleRegistrySave();
 
     if (onvifFrame) {
         onvifFrame->show();
         onvifFrame->raise();
     }
 
-    if (onvifPlayer && onvifPlayer->playbackState() != QMediaPlayer::PlayingState) {
-        onvifPlayer->play();
-        qDebug() << "[ONVIF] 강제 재생 재요청됨";
-    }
-
-    QTimer::singleShot(200, this, [this]() {
-        if (onvifFrame) {
-            onvifFrame->show();
-            onvifFrame->raise();  // 혹시 다른 것에 가려졌다면
-        }
-
-        onvifPlayer = new QMediaPlayer(this);
-        onvifPlayer->setVideoOutput(onvifVideo);  // 기존 video 위젯 유지
-        onvifPlayer->setSource(QUrl("rtsp://192.168.0.35:554/0/onvif/profile2/media.smp"));
-        onvifPlayer->play();
-
-        qDebug() << "[ONVIF] 완전 새로 생성 후 재생됨";
-    });
+    // ✅ ONVIF 플레이어는 풀에서 한 번만 받아 재사용 (갱신마다 새로 만들지 않음)
+    updateOnvifSection();
 }
 
-void MainWindow::switchStreamForAllPlayers(const QString &suffix)
+LogEntry MainWindow::makeLogEntry(const QString &cameraName, const QString &ip,
+                                  LogFunction function, LogEvent event)
 {
-    if (videoPlayerManager)
-        videoPlayerManager->switchStreamForAllPlayers(cameraList, suffix);
-}
+    LogEntry entry;
+    entry.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    entry.cameraId = logStore.cameraId(cameraName, ip);
+    entry.function = function;
+    entry.event = event;
 
-void MainWindow::addLogEntry(const QString &cameraName,
-                             const QString &function,
-                             const QString &event,
-                             const QString &imagePath,
-                             const QString &details,
-                             const QString &ip)
-{
-    QString date = QDate::currentDate().toString("yyyy-MM-dd");
-    QString time = QTime::currentTime().toString("HH:mm:ss");
-
-    int zone = -1;
     for (int i = 0; i < cameraList.size(); ++i) {
         if (cameraList[i].name == cameraName) {
-            zone = i + 1;
+            entry.zone = static_cast<qint16>(i + 1);
             break;
         }
     }
+    return entry;
+}
 
+void MainWindow::addLogEntry(const LogEntry &entry)
+{
+    // 화면에 보이는 20행만 문자열로 변환
+    // 행 번호는 저장소 위치와 다름 (동기화 로그는 뒤에 추가, 한도 초과 시 정리) - 항목 식별값을 행에 보관
+    QTableWidgetItem *cameraItem = new QTableWidgetItem(logStore.cameraName(entry.cameraId));
+    cameraItem->setData(LogTimestampRole, entry.timestampMs);
+    cameraItem->setData(LogCameraRole, entry.cameraId);
+    cameraItem->setData(LogEventRole, static_cast<int>(entry.event));
     logTable->insertRow(0);
-    logTable->setItem(0, 0, new QTableWidgetItem(cameraName));
-    logTable->setItem(0, 1, new QTableWidgetItem(date));
-    logTable->setItem(0, 2, new QTableWidgetItem(time));
-    logTable->setItem(0, 3, new QTableWidgetItem(function));
-    logTable->setItem(0, 4, new QTableWidgetItem(event));
-
-    fullLogEntries.prepend({
-        cameraName,
-        function,
-        event,
-        imagePath,
-        details,
-        date,
-        time,
-        zone,
-        ip
-    });
+    logTable->setItem(0, 0, cameraItem);
+    logTable->setItem(0, 1, new QTableWidgetItem(LogStore::dateText(entry)));
+    logTable->setItem(0, 2, new QTableWidgetItem(LogStore::timeText(entry)));
+    logTable->setItem(0, 3, new QTableWidgetItem(LogStore::functionText(entry.function)));
+    logTable->setItem(0, 4, new QTableWidgetItem(LogStore::eventText(entry)));
+
+    logStore.prepend(entry);
+    statsAggregator.record(entry);
 
     if (logTable->rowCount() > 20)
         logTable->removeRow(logTable->rowCount() - 1);
@@ -543,99 +933,222 @@ void MainWindow::addLogEntry(const QString &cameraName,
 
 void MainWindow::onLogHistoryClicked()
 {
-    LogHistoryDialog dialog(this, &fullLogEntries);  // 로그 목록 전달
+    LogHistoryDialog dialog(this, &logStore, httpClient);  // 로그 저장소 + 이미지 요청 클라이언트 전달
     dialog.exec();
 }
 
-void MainWindow::sendModeChangeRequest(const QString &mode, const CameraInfo &camera)
+bool MainWindow::sendModeChangeRequest(const QString &mode, const CameraInfo &camera)
 {
+    if (camera.isOnvif())
+        return false;  // ONVIF 카메라는 분석 서버 없음
+
     if (camera.ip.isEmpty()) {
         qWarning() << "[모드 변경] 카메라 IP 없음 →" << camera.name;
-        return;
-    }
-
-    if (!socketMap.contains(camera.ip)) {
-        qWarning() << "[모드 변경] WebSocket 연결 없음 →" << camera.name;
-        return;
+        return false;
     }
 
-    QWebSocket *socket = socketMap[camera.ip];
-    if (socket->state() != QAbstractSocket::ConnectedState) {
-        qWarning() << "[모드 변경] WebSocket 비연결 상태 →" << camera.name;
-        return;
-    }
-
-    // ✅ WebSocket 메시지 생성
+    // ✅ WebSocket 메시지 생성 (응답은 onSocketMessageReceived → ModeController)
     QJsonObject payload;
     payload["type"] = "set_mode";
     payload["mode"] = mode;
 
     QJsonDocument doc(payload);
     QString message = doc.toJson(QJsonDocument::Compact);
-    socket->sendTextMessage(message);
+    if (!sendCameraMessage(camera.ip, message)) {
+        qWarning() << "[모드 변경] WebSocket 비연결 상태 →" << camera.name;
+        return false;
+    }
 
-    qDebug() << "[WebSocket] 모드 변경 메시지 전송됨:" << message;
+    qDebug() << "[WebSocket] 모드 변경 메시지 전송됨:" << camera.ip << message;
+    return true;
+}
 
-    // ✅ WebSocket 응답 메시지 처리 (이 socket만을 위한 임시 슬롯)
-    connect(socket, &QWebSocket::textMessageReceived, this, [=](const QString &msg) {
-        QJsonDocument respDoc = QJsonDocument::fromJson(msg.toUtf8());
-        if (!respDoc.isObject()) return;
+QStringList MainWindow::modeTargetIps() const
+{
+    const QString selected = modeTargetComboBox->currentData().toString();
+    if (!selected.isEmpty())
+        return { selected };
 
-        QJsonObject obj = respDoc.object();
-        QString type = obj["type"].toString();
+    QStringList ips;
+    for (const CameraInfo &camera : cameraList) {
+        if (!camera.isOnvif())
+            ips.append(camera.ip);
+    }
+    return ips;
+}
 
-        if (type == "mode_change_ack") {
-            QString status = obj["status"].toString();
-            QString serverMessage = obj["message"].toString();
+void MainWindow::applyModeFromPanel(const QString &mode)
+{
+    const QStringList ips = modeTargetIps();
+    if (ips.isEmpty())
+        return;
 
-            if (status == "error") {
-                qWarning() << "[모드 변경 실패]" << serverMessage;
-                QMessageBox::warning(this, "모드 변경 실패", serverMessage);
-            } else {
-                qDebug() << "[모드 변경 성공 응답]" << serverMessage;
-            }
+    // 요청 모드를 먼저 기록 - 연결 전인 카메라는 소켓 연결 시 적용됨
+    for (const QString &ip : ips) {
+        if (CameraInfo *stored = findCameraByIp(ip); stored && stored->lastMode != mode) {
+            stored->lastMode = mode;
+            scheduleRegistrySave();
         }
-    });
+    }
+    modeController->applyMode(mode, ips);
 }
 
-void MainWindow::onAlertItemClicked(int row, int column)
+void MainWindow::updateModeTargetComboBox()
 {
-    if (row >= fullLogEntries.size()) return;
+    const QString selected = modeTargetComboBox->currentData().toString();
 
-    const LogEntry &entry = fullLogEntries.at(row);
-    if (entry.imagePath.isEmpty()) {
-        QMessageBox::information(this, "이미지 없음", "이 항목에는 이미지가 없습니다.");
+    modeTargetComboBox->blockSignals(true);
+    modeTargetComboBox->clear();
+    modeTargetComboBox->addItem("전체 카메라", QString());
+    for (const CameraInfo &camera : cameraList) {
+        if (!camera.isOnvif())
+            modeTargetComboBox->addItem(camera.name, camera.ip);
+    }
+    modeTargetComboBox->setCurrentIndex(qMax(0, modeTargetComboBox->findData(selected)));
+    modeTargetComboBox->blockSignals(false);
+}
+
+void MainWindow::updateModeCheckBoxes()
+{
+    // 대상 카메라의 요청 모드가 모두 같을 때만 해당 체크박스 표시
+    QString mode;
+    bool uniform = true;
+    for (const QString &ip : modeTargetIps()) {
+        QString cameraMode = modeController->state(ip).desired;
+        if (cameraMode.isEmpty()) {
+            const CameraInfo *camera = findCameraByIp(ip);
+            cameraMode = camera ? camera->lastMode : QString();
+        }
+        if (cameraMode.isEmpty() || (!mode.isEmpty() && cameraMode != mode)) {
+            uniform = false;
+            break;
+        }
+        mode = cameraMode;
+    }
+
+    for (auto it = modeCheckBoxes.cbegin(); it != modeCheckBoxes.cend(); ++it) {
+        it.value()->blockSignals(true);
+        it.value()->setChecked(uniform && it.key() == mode);
+        it.value()->blockSignals(false);
+    }
+}
+
+void MainWindow::updateModeStatusTable()
+{
+    modeStatusTable->setRowCount(0);
+    for (const CameraInfo &camera : cameraList) {
+        if (camera.isOnvif()) continue;
+
+        const ModeController::CameraModeState state = modeController->state(camera.ip);
+        QString status;
+        if (state.pending)
+            status = QString("⏳ → %1").arg(LogStore::functionText(functionForMode(state.desired)));
+        else if (!state.error.isEmpty())
+            status = QString("❌ %1").arg(state.error);
+        else if (!state.acked.isEmpty() && state.acked == state.desired)
+            status = QString("✅ %1").arg(LogStore::functionText(functionForMode(state.acked)));
+        else if (!state.desired.isEmpty() || !camera.lastMode.isEmpty())
+            status = QString("🔌 연결 대기 → %1").arg(LogStore::functionText(functionForMode(
+                state.desired.isEmpty() ? camera.lastMode : state.desired)));
+        else
+            status = "-";
+
+        const int row = modeStatusTable->rowCount();
+        modeStatusTable->insertRow(row);
+        modeStatusTable->setItem(row, 0, new QTableWidgetItem(camera.name));
+        QTableWidgetItem *statusItem = new QTableWidgetItem(status);
+        if (!state.error.isEmpty())
+            statusItem->setToolTip(QString("요청: %1 / 확인: %2").arg(state.desired, state.acked));
+        modeStatusTable->setItem(row, 1, statusItem);
+    }
+}
+
+void MainWindow::onModeStateChanged(const QString &ip)
+{
+    // 롤백 등으로 요청 모드가 바뀌면 레지스트리에도 반영
+    const QString desired = modeController->state(ip).desired;
+    if (CameraInfo *stored = findCameraByIp(ip); stored && !desired.isEmpty() && stored->lastMode != desired) {
+        stored->lastMode = desired;
+        scheduleRegistrySave();
+    }
+
+    // 한 번의 fan-out에서 여러 카메라 상태가 바뀌므로 화면 갱신은 묶어서 한 번만
+    if (modeStatusRefreshQueued)
         return;
+    modeStatusRefreshQueued = true;
+    QTimer::singleShot(0, this, [this]() {
+        modeStatusRefreshQueued = false;
+        updateModeStatusTable();
+        updateModeCheckBoxes();
+    });
+}
+
+void MainWindow::onModeApplied(const QString &mode, const QStringList &succeeded,
+                               const QStringList &failed, bool rolledBack)
+{
+    const LogFunction function = functionForMode(mode);
+
+    for (const QString &ip : failed) {
+        const CameraInfo *camera = findCameraByIp(ip);
+        addLogEntry(makeLogEntry(camera ? camera->name : ip, ip, function, LogEvent::ModeChangeFailed));
     }
 
-    QString ip = entry.ip;
-    if (ip.isEmpty()) {
-        QMessageBox::warning(this, "IP 없음", "카메라 IP가 없습니다.");
+    if (rolledBack) {
+        LogEntry entry = makeLogEntry("System", "", function, LogEvent::ModeRolledBack);
+        entry.count = toLogCount(succeeded.size());
+        addLogEntry(entry);
         return;
     }
 
-    // 상대 경로일 경우 "./" 제거
-    QString imagePath = entry.imagePath;
-    if (imagePath.startsWith("../"))
-        imagePath = imagePath.mid(3);
+    if (succeeded.size() == 1) {
+        const CameraInfo *camera = findCameraByIp(succeeded.first());
+        addLogEntry(makeLogEntry(camera ? camera->name : succeeded.first(), succeeded.first(),
+                                 function, LogEvent::ModeEnabled));
+    } else if (!succeeded.isEmpty()) {
+        addLogEntry(makeLogEntry("System", "", function, LogEvent::ModeEnabled));
+    }
+}
 
-    QString urlStr = QString("http://%1/%2").arg(ip, imagePath);
+void MainWindow::onAlertItemClicked(int row, int column)
+{
+    const QTableWidgetItem *cameraItem = logTable->item(row, 0);
+    if (!cameraItem) return;
+
+    const int index = logStore.indexOf(cameraItem->data(LogTimestampRole).toLongLong(),
+                                       static_cast<quint16>(cameraItem->data(LogCameraRole).toUInt()),
+                                       static_cast<LogEvent>(cameraItem->data(LogEventRole).toInt()));
+    if (index < 0) {
+        QMessageBox::information(this, "로그 없음", "보관 한도를 넘어 정리된 항목입니다.");
+        return;
+    }
+    const LogEntry &entry = logStore.at(index);
+    QString imagePath = logStore.imagePath(entry);
+    const QString clipPath = logStore.clipPath(entry);
+    if (imagePath.isEmpty()) {
+        if (!clipPath.isEmpty())
+            ClipBuffer::openClip(this, clipPath);  // 낙상 등 이미지 없는 이벤트는 클립 재생
+        else
+            QMessageBox::information(this, "이미지 없음", "이 항목에는 이미지가 없습니다.");
+        return;
+    }
 
-    qDebug() << "[이미지 요청 URL]" << urlStr;
+    QString ip = logStore.cameraIp(entry.cameraId);
+    if (ip.isEmpty()) {
+        QMessageBox::warning(this, "IP 없음", "카메라 IP가 없습니다.");
+        return;
+    }
 
-    QUrl url(urlStr);
-    QNetworkRequest request(url);
-    QNetworkReply *reply = networkManager->get(request);
+    qDebug() << "[이미지 요청 URL]" << CameraHttpClient::imageUrl(ip, imagePath).toString();
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
-            QMessageBox::critical(this, "이미지 로딩 실패", reply->errorString());
+    // 같은 이미지를 다시 열면 캐시에서 바로 표시
+    httpClient->fetchImage(ip, imagePath, this, [this, clipPath](const QByteArray &data, const QString &error) {
+        if (!error.isEmpty()) {
+            QMessageBox::critical(this, "이미지 로딩 실패", error);
             return;
         }
 
         QPixmap pix;
-        pix.loadFromData(reply->readAll());
+        pix.loadFromData(data);
         if (pix.isNull()) {
             QMessageBox::warning(this, "이미지 오류", "유효한 이미지가 아닙니다.");
             return;
@@ -648,6 +1161,13 @@ void MainWindow::onAlertItemClicked(int row, int column)
 
         QVBoxLayout *layout = new QVBoxLayout(imgDialog);
         layout->addWidget(imgLabel);
+        if (!clipPath.isEmpty()) {
+            QPushButton *clipButton = new QPushButton("🎞️ 클립 재생");
+            connect(clipButton, &QPushButton::clicked, imgDialog, [imgDialog, clipPath]() {
+                ClipBuffer::openClip(imgDialog, clipPath);
+            });
+            layout->addWidget(clipButton);
+        }
         imgDialog->setLayout(layout);
         imgDialog->setMinimumSize(640, 480);
         imgDialog->exec();
@@ -669,14 +1189,46 @@ void MainWindow::onCameraListClicked()
 
 void MainWindow::setupWebSocketConnections()
 {
+    if (!gatewayUrl.isEmpty()) {
+        // ✅ 게이트웨이 모드 - 연결 하나로 모든 카메라 이벤트 수신, 카메라 목록은 구독 메시지로 전달
+        if (!gatewaySocket) {
+            gatewaySocket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+            connect(gatewaySocket, &QWebSocket::connected, this, [this]() {
+                qDebug() << "[Gateway] 연결됨";
+                subscribeGatewayCameras();
+            });
+            connect(gatewaySocket, &QWebSocket::textMessageReceived, this, &MainWindow::onGatewayMessage);
+
+            // 끊김/연결 실패 모두 3초 후 재연결 (타이머 하나라 중복 시도 없음)
+            QTimer *reconnectTimer = new QTimer(gatewaySocket);
+            reconnectTimer->setSingleShot(true);
+            reconnectTimer->setInterval(3000);
+            connect(reconnectTimer, &QTimer::timeout, this, [this]() { gatewaySocket->open(gatewayUrl); });
+
+            connect(gatewaySocket, &QWebSocket::disconnected, this, [this, reconnectTimer]() {
+                qWarning() << "[Gateway] 연결 끊김 - 3초 후 재연결";
+                gatewayConnectedCameras.clear();
+                reconnectTimer->start();
+            });
+            connect(gatewaySocket, &QWebSocket::errorOccurred, this, [this, reconnectTimer](QAbstractSocket::SocketError error) {
+                qWarning() << "[Gateway] 오류:" << error;
+                if (gatewaySocket->state() == QAbstractSocket::UnconnectedState)
+                    reconnectTimer->start();
+            });
+            gatewaySocket->open(gatewayUrl);
+        } else {
+            subscribeGatewayCameras();
+        }
+        return;
+    }
+
     for (const CameraInfo &camera : cameraList) {
+        if (camera.isOnvif()) continue;                // ONVIF 카메라는 웹소켓 서버 없음
         if (socketMap.contains(camera.ip)) continue;  // 이미 연결된 경우 생략
 
         QWebSocket *socket = new QWebSocket();
 
-        connect(socket, &QWebSocket::sslErrors, this, [socket](const QList<QSslError> &) {
-            socket->ignoreSslErrors();
-        });
+        cameraTls->attach(socket, camera.ip);  // 고정 인증서 검증 + 세션 티켓 저장 (적용은 open 직전)
 
         connect(socket, &QWebSocket::connected, this, &MainWindow::onSocketConnected);
         connect(socket, &QWebSocket::disconnected, this, &MainWindow::onSocketDisconnected);
@@ -687,28 +1239,32 @@ void MainWindow::setupWebSocketConnections()
         connect(socket, &QWebSocket::textMessageReceived,
                 this, &MainWindow::onSocketMessageReceived);
 
-        QString wsUrl = QString("wss://%1:8443/ws").arg(camera.ip);
-        socket->open(QUrl(wsUrl));
+        // ✅ 끊김/연결 실패 모두 일정 시간 후 재연결 (소켓당 타이머 하나라 중복 시도 없음, 소켓과 함께 삭제)
+        QTimer *reconnectTimer = new QTimer(socket);
+        reconnectTimer->setSingleShot(true);
+        reconnectTimer->setInterval(CameraReconnectMs);
+        const QString ip = camera.ip;
+        connect(reconnectTimer, &QTimer::timeout, this, [this, socket, ip]() { openCameraSocket(socket, ip); });
+        connect(socket, &QWebSocket::disconnected, this, [reconnectTimer]() { reconnectTimer->start(); });
+        connect(socket, &QWebSocket::errorOccurred, this, [socket, reconnectTimer]() {
+            if (socket->state() == QAbstractSocket::UnconnectedState)
+                reconnectTimer->start();  // 연결 실패는 disconnected 없이 끝날 수 있음
+        });
+
         socketMap[camera.ip] = socket;
+        openCameraSocket(socket, camera.ip);
     }
 }
 
-void MainWindow::onSocketMessageReceived(const QString &message)
+void MainWindow::openCameraSocket(QWebSocket *socket, const QString &ip)
 {
-    qDebug() << "[WebSocket 수신 메시지]" << message;
-
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (!doc.isObject()) {
-        qWarning() << "[WebSocket 메시지] JSON 파싱 실패";
-        return;
-    }
-
-    QJsonObject obj = doc.object();
-    QString type = obj["type"].toString();
-    QJsonObject data = obj["data"].toObject();
-
-    qDebug() << "📨 [WebSocket 타입]" << type;
+    // open()마다 설정을 다시 적용해야 이전 연결에서 받은 세션 티켓을 재연결에 씀
+    cameraTls->applyConfiguration(socket, ip);
+    socket->open(QUrl(QString("wss://%1:8443/ws").arg(ip)));
+}
 
+void MainWindow::onSocketMessageReceived(const QString &message)
+{
     QString ipSender;
     QWebSocket *senderSocket = qobject_cast<QWebSocket*>(sender());
     for (auto it = socketMap.begin(); it != socketMap.end(); ++it) {
@@ -723,197 +1279,447 @@ void MainWindow::onSocketMessageReceived(const QString &message)
         return;
     }
 
-    const CameraInfo *cameraPtr = nullptr;
-    for (int i = 0; i < cameraList.size(); ++i) {
-        if (cameraList[i].ip.trimmed() == ipSender.trimmed()) {  // 공백 방지
-            cameraPtr = &cameraList[i];
-            break;
-        }
-    }
+    handleCameraMessage(ipSender, message);
+}
+
+void MainWindow::handleCameraMessage(const QString &ip, const QString &message)
+{
+    // 메시지마다 원문을 찍지 않음 (초당 수백 건이면 로그 출력이 수신 처리보다 느림) - 필요하면 --record로 기록
+    // UTF-8 변환 한 번 - 기록과 수신 큐가 같은 버퍼 공유, 파싱은 큐 처리 턴의 아레나에서
+    const QByteArray json = message.toUtf8();
+    if (eventRecorder)
+        eventRecorder->record(ip, json);
 
-    if (!cameraPtr) {
-        qWarning() << "[WebSocket] CameraInfo 찾기 실패 for IP:" << ipSender;
+    ingestQueue->enqueue(ip, json);
+}
+
+void MainWindow::setupEventHandlers()
+{
+    // 핸들러 멤버 함수를 (ip, 이벤트) 콜백으로 감싸고 CameraInfo 조회를 한 곳에서 처리
+    auto forCamera = [this](auto method) {
+        return [this, method](const QString &ip, const auto &event) {
+            const CameraInfo *camera = findCameraByIp(ip);
+            if (!camera) {
+                qWarning() << "[WebSocket] CameraInfo 찾기 실패 for IP:" << ip;
+                return;
+            }
+            (this->*method)(*camera, event);
+        };
+    };
+
+    // 새 서버 이벤트 타입은 구조체(serverevents.h) + 핸들러를 여기 등록만 하면 됨
+    eventDispatcher.registerHandler<DetectionEvent>("new_detection", forCamera(&MainWindow::handleDetection));
+    eventDispatcher.registerHandler<CountEvent>("new_trespass", forCamera(&MainWindow::handleTrespass));
+    eventDispatcher.registerHandler<CountEvent>("new_blur", forCamera(&MainWindow::handleBlur));
+    eventDispatcher.registerHandler<AnomalyEvent>("anomaly_status", forCamera(&MainWindow::handleAnomaly));
+    eventDispatcher.registerHandler<CountEvent>("new_fall", forCamera(&MainWindow::handleFall));
+    eventDispatcher.registerHandler<StmStatusEvent>("stm_status_update", forCamera(&MainWindow::handleStmStatus));
+    eventDispatcher.registerHandler<ModeAckEvent>("mode_change_ack", forCamera(&MainWindow::handleModeAck));
+
+    // 과부하 시 처리 순서/버림 기준 - 등록하지 않은 타입은 High
+    ingestQueue->setPriority("new_detection", IngestQueue::Priority::Normal);
+    ingestQueue->setPriority("new_blur", IngestQueue::Priority::Low);
+}
+
+void MainWindow::handleDetection(const CameraInfo &camera, const DetectionEvent &event)
+{
+    const QString imagePath = EventFrame::toQString(event.imagePath);  // 로그에 남기는 문자열만 복사
+
+    LogEntry entry = makeLogEntry(camera.name, camera.ip, LogFunction::PPE, LogEvent::PpeCompliant);
+    entry.sourceTimestampMs = LogStore::parseServerTimestamp(event.timestamp);
+    entry.personCount = toLogCount(event.personCount);
+    entry.helmetCount = toLogCount(event.helmetCount);
+    entry.vestCount = toLogCount(event.vestCount);
+    entry.confidence = static_cast<float>(event.confidence);
+    entry.imageId = logStore.internImage(imagePath);
+
+    // ✅ 착용/미착용 판정은 PpeClassifier 한 곳에서 (로그 동기화와 같은 규칙)
+    const PpeResult result = PpeClassifier::classify(entry.personCount, entry.helmetCount, entry.vestCount);
+    entry.event = PpeClassifier::logEvent(result);
+    ppeTally[entry.cameraId].add(result);
+
+    // PPE 위반 에스컬레이션 (기본: 60초 내 4회) - 모두 착용이면 에스컬레이션 없음
+    if (PpeClassifier::isViolation(result))
+        entry.clipId = escalate(camera, RuleEngine::Event::Ppe, imagePath);
+
+    qDebug() << "[PPE 이벤트]" << LogStore::eventText(entry) << "IP:" << camera.ip;
+    addLogEntry(entry);
+}
+
+void MainWindow::handleTrespass(const CameraInfo &camera, const CountEvent &event)
+{
+    if (event.count <= 0)
+        return;
+
+    LogEntry entry = makeLogEntry(camera.name, camera.ip, LogFunction::Night, LogEvent::Trespass);
+    entry.sourceTimestampMs = LogStore::parseServerTimestamp(event.timestamp);
+    entry.count = toLogCount(event.count);
+    entry.clipId = escalate(camera, RuleEngine::Event::Trespass);
+    addLogEntry(entry);
+}
+
+void MainWindow::handleBlur(const CameraInfo &camera, const CountEvent &event)
+{
+    // 중복 키 = 카메라 id + 서버 시각 (시각을 읽지 못하면 원문 해시) - 문자열 키를 만들지 않음
+    const qint64 sourceMs = LogStore::parseServerTimestamp(event.timestamp);
+    const quint64 stamp = sourceMs ? quint64(sourceMs)
+                                   : quint64(qHash(QByteArrayView(event.timestamp.data(), qsizetype(event.timestamp.size()))));
+    const quint64 key = (quint64(logStore.cameraId(camera.name, camera.ip)) << 48) ^ stamp;
+    if (recentBlurLogKeys.contains(key)) {
+        qDebug() << "[BLUR 중복 무시]" << camera.name << QLatin1String(event.timestamp.data(), qsizetype(event.timestamp.size()));
         return;
     }
-    const CameraInfo &camera = *cameraPtr;
 
-    if (type == "new_detection") {
-        int person = data["person_count"].toInt();
-        int helmet = data["helmet_count"].toInt();
-        int vest = data["safety_vest_count"].toInt();
-        double conf = data["avg_confidence"].toDouble();
-        QString imagePath = data["image_path"].toString();
-        QString ts = data["timestamp"].toString();
+    qDebug() << "[Blur 이벤트]" << event.count << "명 IP:" << camera.ip;
 
-        QString event;
-        QString details = QString("👷 %1명 | ⛑️ %2명 | 🦺 %3명 | 신뢰도: %4")
-                              .arg(person).arg(helmet).arg(vest).arg(conf, 0, 'f', 2);
+    LogEntry entry = makeLogEntry(camera.name, camera.ip, LogFunction::Blur, LogEvent::BlurCount);
+    entry.sourceTimestampMs = sourceMs;
+    entry.count = toLogCount(event.count);
+    addLogEntry(entry);
+    recentBlurLogKeys.insert(key);
+    recentBlurLogOrder.enqueue(key);
+    if (recentBlurLogOrder.size() > MaxRecentBlurKeys)
+        recentBlurLogKeys.remove(recentBlurLogOrder.dequeue());
+}
 
-        // ✅ 기존 PPE 감지 처리
-        if (helmet < person && vest >= person)
-            event = "⛑️ 헬멧 미착용 감지";
-        else if (vest < person && helmet >= person)
-            event = "🦺 조끼 미착용 감지";
-        else
-            event = "⛑️ 🦺 PPE 미착용 감지";
-
-        qDebug() << "[PPE 이벤트]" << event << "IP:" << camera.ip;
-
-        // PPE 알람 연속 횟수 추적
-        if (event.contains("미착용")) {
-            int count = ppeViolationStreakMap[camera.name] + 1;
-            ppeViolationStreakMap[camera.name] = count;
-
-            if (count >= 4) {
-                QMessageBox *popup = new QMessageBox(this);
-                popup->setIcon(QMessageBox::Warning);
-                popup->setWindowTitle("지속적인 PPE 위반");
-                popup->setText(QString("%1 카메라에서 PPE 미착용이 연속 4회 감지되었습니다!").arg(camera.name));
-                popup->setStandardButtons(QMessageBox::Ok);
-                popup->setModal(false);         // ✅ 비모달 설정
-
-                if (!imagePath.isEmpty()) {
-                    QString cleanPath = imagePath;
-                    if (cleanPath.startsWith("../"))
-                        cleanPath = cleanPath.mid(3);  // 상대경로 정리
-
-                    QString urlStr = QString("http://%1/%2").arg(camera.ip, cleanPath);
-                    QUrl url(urlStr);
-                    QNetworkRequest request(url);
-
-                    QNetworkAccessManager *manager = new QNetworkAccessManager(popup);  // 팝업에 소속
-                    QNetworkReply *reply = manager->get(request);
-
-                    connect(reply, &QNetworkReply::finished, popup, [=]() {
-                        reply->deleteLater();
-                        QPixmap pix;
-                        pix.loadFromData(reply->readAll());
-                        if (!pix.isNull()) {
-                            QLabel *imgLabel = new QLabel();
-                            imgLabel->setPixmap(pix.scaled(400, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-                            popup->layout()->addWidget(imgLabel);
-                            popup->adjustSize();  // 이미지 포함 크기 자동 조정
-                        }
-                    });
-                }
+void MainWindow::handleAnomaly(const CameraInfo &camera, const AnomalyEvent &event)
+{
+    qDebug() << "[이상소음 상태]" << QLatin1String(event.status.data(), qsizetype(event.status.size()))
+             << "at" << QLatin1String(event.timestamp.data(), qsizetype(event.timestamp.size()));
 
-                popup->show();                  // ✅ show()만 사용하여 non-blocking
+    const bool wasDetected = anomalyActive.value(camera.name);
+    const bool detected = event.status == "detected";
 
-                ppeViolationStreakMap[camera.name] = 0;  // 리셋
-            }
+    if (detected && !wasDetected) {
+        LogEntry entry = makeLogEntry(camera.name, camera.ip, LogFunction::Sound, LogEvent::AnomalyDetected);
+        entry.clipId = escalate(camera, RuleEngine::Event::Anomaly);
+        addLogEntry(entry);
+    }
+    else if (event.status == "cleared" && wasDetected) {
+        addLogEntry(makeLogEntry(camera.name, camera.ip, LogFunction::Sound, LogEvent::AnomalyCleared));
+    }
 
-        } else {
-            ppeViolationStreakMap[camera.name] = 0;
-        }
+    anomalyActive.insert(camera.name, detected);
+}
 
-        addLogEntry(camera.name, "PPE", event, imagePath, details, camera.ip);
+void MainWindow::handleFall(const CameraInfo &camera, const CountEvent &event)
+{
+    if (event.count <= 0)
+        return;
+
+    LogEntry entry = makeLogEntry(camera.name, camera.ip, LogFunction::Fall, LogEvent::Fall);
+    entry.sourceTimestampMs = LogStore::parseServerTimestamp(event.timestamp);
+    entry.count = toLogCount(event.count);
+    entry.clipId = escalate(camera, RuleEngine::Event::Fall);  // 낙상은 이미지가 없어 클립이 유일한 영상
+    addLogEntry(entry);
+}
+
+void MainWindow::handleStmStatus(const CameraInfo &camera, const StmStatusEvent &event)
+{
+    qDebug() << "[STM 상태 응답 수신]" << camera.ip << event.temperature << event.light;
+
+    healthCheckResponded.insert(camera.ip);  // ✅ 응답 확인 기록
+
+    LogEntry entry = makeLogEntry(camera.name, camera.ip, LogFunction::Health, LogEvent::HealthStatus);
+    entry.temperature = static_cast<float>(event.temperature);
+    entry.light = toLogCount(event.light);
+    entry.buzzerOn = event.buzzerOn;
+    entry.ledOn = event.ledOn;
+    addLogEntry(entry);
+}
+
+void MainWindow::handleModeAck(const CameraInfo &camera, const ModeAckEvent &event)
+{
+    const QString status = EventFrame::toQString(event.status);
+    const QString mode = EventFrame::toQString(event.mode);
+    const QString message = EventFrame::toQString(event.message);
+
+    if (status == "error")
+        qWarning() << "[모드 변경 실패]" << camera.ip << message;
+    else
+        qDebug() << "[모드 변경 성공 응답]" << camera.ip << mode;
+    modeController->handleAck(camera.ip, mode, status, message);
+}
+
+quint32 MainWindow::escalate(const CameraInfo &camera, RuleEngine::Event event, const QString &imagePath)
+{
+    RuleEngine::Escalation escalation;
+    if (!ruleEngine.record(camera.ip, event, QDateTime::currentMSecsSinceEpoch(), &escalation))
+        return 0;
+
+    QString what;
+    switch (event) {
+    case RuleEngine::Event::Ppe:      what = "PPE 미착용"; break;
+    case RuleEngine::Event::Trespass: what = "야간 침입"; break;
+    case RuleEngine::Event::Fall:     what = "낙상"; break;
+    case RuleEngine::Event::Anomaly:  what = "이상소음"; break;
+    case RuleEngine::Event::Count:    return 0;
     }
 
-    else if (type == "new_trespass") {
-        QString ts = data["timestamp"].toString();
-        int count = data["count"].toInt();
+    QString text;
+    if (escalation.count <= 1)
+        text = QString("%1 카메라에서 %2이(가) 감지되었습니다!").arg(camera.name, what);
+    else if (escalation.windowMs > 0)
+        text = QString("%1 카메라에서 %2이(가) %3초 내 %4회 감지되었습니다!")
+                   .arg(camera.name, what).arg(escalation.windowMs / 1000).arg(escalation.count);
+    else
+        text = QString("%1 카메라에서 %2이(가) %3회 감지되었습니다!").arg(camera.name, what).arg(escalation.count);
+
+    QUrl imageUrl;
+    if (!imagePath.isEmpty())
+        imageUrl = CameraHttpClient::imageUrl(camera.ip, imagePath);
+
+    // 팝업을 쌓지 않고 하나의 비모달 패널에 모음 (썸네일은 httpClient 캐시 공유)
+    if (!alertPanel)
+        alertPanel = new AlertPanel(httpClient, this);
+    alertPanel->raiseAlert(camera.ip + "/" + RuleEngine::eventName(event), camera.name, text, imageUrl);
+    StartupTimeline::mark(StartupMilestone::FirstAlert);
+    videoPlayerManager->focusCamera(camera.ip, VideoPlayerManager::FocusReason::Alert);  // 포커스 모드일 때만 적용
+
+    // 이벤트 전/후 클립 저장 (재생 중인 카메라만 - 파일은 PostEventMs 후 완성)
+    return logStore.internClip(clipBuffer->saveClip(camera.ip, RuleEngine::eventName(event)));
+}
 
-        if (count > 0) {
-            QString event = QString("🌙 야간 침입 감지 (%1명)").arg(count);
-            QString details = QString("감지 시각: %1 | 침입자 수: %2").arg(ts).arg(count);
+void MainWindow::setActivityOverlayEnabled(bool enabled)
+{
+    if (!activityAnalyzer) {
+        activityAnalyzer = new ActivityAnalyzer(this);
+        connect(activityAnalyzer, &ActivityAnalyzer::activityChanged,
+                videoPlayerManager, &VideoPlayerManager::setTileActivity);
+        // 활동이 최고 단계면 포커스 모드 주 화면 후보 (알림보다 낮은 우선순위)
+        connect(activityAnalyzer, &ActivityAnalyzer::activityChanged, this, [this](const QString &ip, double level) {
+            if (level >= 1.0)
+                videoPlayerManager->focusCamera(ip, VideoPlayerManager::FocusReason::Activity);
+        });
+    }
 
-            addLogEntry(camera.name, "Night", event, "", details, camera.ip);
-        }
+    if (enabled) {
+        connect(videoPlayerManager, &VideoPlayerManager::tileFrame, activityAnalyzer,
+                &ActivityAnalyzer::addFrame, Qt::UniqueConnection);
+    } else {
+        disconnect(videoPlayerManager, &VideoPlayerManager::tileFrame, activityAnalyzer, &ActivityAnalyzer::addFrame);
+        activityAnalyzer->reset();
+        videoPlayerManager->clearTileActivity();
     }
+}
 
-    else if (type == "new_blur") {
-        QString ts = data["timestamp"].toString();
-        QString key = camera.name + "_" + ts;
-        if (recentBlurLogKeys.contains(key)) {
-            qDebug() << "[BLUR 중복 무시]" << key;
-            return;
-        }
+void MainWindow::onSnapshotClicked()
+{
+    const QString selected = modeTargetComboBox->currentData().toString();
+    snapshotFiles.clear();
+    if (selected.isEmpty())
+        videoPlayerManager->captureAll();
+    else
+        videoPlayerManager->captureSnapshots({ selected });
+}
+
+void MainWindow::saveSnapshot(const QString &ip, const QByteArray &jpeg, qint64 capturedMs)
+{
+    if (jpeg.isEmpty()) {
+        qWarning() << "[스냅샷] 압축 실패:" << ip;
+        return;
+    }
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::PicturesLocation) + "/SmartSafetyNet";
+    QDir().mkpath(dir);
+    const QString path = QString("%1/%2_%3.jpg")
+                             .arg(dir, QString(ip).replace(':', '_'),
+                                  QDateTime::fromMSecsSinceEpoch(capturedMs).toString("yyyyMMdd_HHmmss_zzz"));
 
-        int count = data["count"].toInt();
-        QString event = QString("🔍 %1명 감지").arg(count);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(jpeg) != jpeg.size()) {
+        qWarning() << "[스냅샷] 저장 실패:" << path << file.errorString();
+        return;
+    }
+    snapshotFiles.append(path);
+}
 
-        qDebug() << "[Blur 이벤트]" << event << "IP:" << camera.ip;
+void MainWindow::onStatsClicked()
+{
+    if (!statsDialog)
+        statsDialog = new StatsDialog(&statsAggregator, &logStore, this);
+    statsDialog->show();
+    statsDialog->raise();
+    statsDialog->activateWindow();
+}
 
-        addLogEntry(camera.name, "Blur", event, "", "", camera.ip);
-        // addLogEntry(camera, "Blur", event, "", "");
-        recentBlurLogKeys.insert(key);
+void MainWindow::onDiagnosticsClicked()
+{
+    if (!diagnosticsDialog) {
+        diagnosticsDialog = new DiagnosticsDialog(this);
+        diagnosticsDialog->addSection("시작 타임라인", []() { return StartupTimeline::text(); });
+        diagnosticsDialog->addSection("수신 큐", [this]() { return ingestQueue->statsText(); });
+        diagnosticsDialog->addSection("이벤트 디스패치", [this]() {
+            return eventDispatcher.statsText() + QString("\n로그 동기화 (REST): %1건 | %2")
+                .arg(restDetectionSchema.decoded).arg(restDetectionSchema.text());
+        });
+        diagnosticsDialog->addSection("PPE 판정", [this]() { return ppeTallyText(); });
+        diagnosticsDialog->addSection("에스컬레이션 규칙", [this]() { return ruleEngine.statsText(); });
+        diagnosticsDialog->addSection("TLS", [this]() { return cameraTls->statsText(); });
+        diagnosticsDialog->addSection("HTTP", [this]() { return httpClient->statsText(); });
+        diagnosticsDialog->addSection("이벤트 클립", [this]() { return clipBuffer->statsText(); });
+        diagnosticsDialog->addSection("활동 감지", [this]() {
+            return activityAnalyzer ? activityAnalyzer->statsText() : QString("꺼짐");
+        });
+        diagnosticsDialog->addSection("기록 / 재생", [this]() {
+            if (eventReplayer)
+                return eventReplayer->statsText();
+            return eventRecorder ? eventRecorder->statsText() : QString("기록 안 함");
+        });
+        diagnosticsDialog->addSection("메모리", [this]() {
+            return memoryBudget ? memoryBudget->statsText()
+                                : QString("예산 없음 (--kiosk / --memory-budget-mb) | RSS %1 MB")
+                                      .arg(MemoryBudget::residentBytes() / (1024 * 1024));
+        });
+        diagnosticsDialog->addSection("영상 스트림", [this]() { return videoPlayerManager->streamHealth()->statsText(); });
+        diagnosticsDialog->addSection("플레이어 풀", [this]() {
+            const PlayerPool *pool = videoPlayerManager->playerPool();
+            return QString("재생 중 %1 / 최대 %2 | 대기 %3")
+                .arg(pool->activeCount()).arg(pool->maxActive()).arg(pool->idleCount());
+        });
     }
-    else if (type == "anomaly_status") {
-        QString status = data["status"].toString();
-        QString timestamp = data["timestamp"].toString();
 
-        qDebug() << "[이상소음 상태]" << status << "at" << timestamp;
+    diagnosticsDialog->show();
+    diagnosticsDialog->raise();
+    diagnosticsDialog->activateWindow();
+}
 
-        if (status == "detected" && lastAnomalyStatus[camera.name] != "detected") {
-            addLogEntry(camera.name, "Sound", "⚠️ 이상소음 감지됨", "", "이상소음 발생", camera.ip);
-        }
-        else if (status == "cleared" && lastAnomalyStatus[camera.name] == "detected") {
-            addLogEntry(camera.name, "Sound", "✅ 이상소음 해제됨", "", "이상소음 정상 상태", camera.ip);
-        }
 
-        lastAnomalyStatus[camera.name] = status;
+void MainWindow::onSocketConnected() {
+    qDebug() << "[웹소켓] 연결됨";
+
+    QWebSocket *socket = qobject_cast<QWebSocket*>(sender());
+    if (!socket || socket->state() != QAbstractSocket::ConnectedState)
+        return;  // 인증서 지문 불일치로 CameraTls가 이미 끊은 연결
+    onCameraConnected(socketMap.key(socket));
+}
+
+void MainWindow::onCameraConnected(const QString &ip)
+{
+    const CameraInfo *camera = findCameraByIp(ip);
+    if (!camera)
+        return;
+    StartupTimeline::mark(StartupMilestone::FirstConnection);
+
+    // ✅ 연결되자마자 마지막 모드 적용 + 상태 체크
+    modeController->applyMode(camera->lastMode.isEmpty() ? "raw" : camera->lastMode, { ip });
+    requestHealthCheck(*camera);
+}
+
+bool MainWindow::sendCameraMessage(const QString &ip, const QString &message)
+{
+    if (gatewaySocket) {
+        if (gatewaySocket->state() != QAbstractSocket::ConnectedState || !gatewayConnectedCameras.contains(ip))
+            return false;
+
+        // {"camera": ip, "msg": 원본} 으로 감싸 게이트웨이가 해당 카메라로 전달
+        QJsonObject frame;
+        frame["camera"] = ip;
+        frame["msg"] = QJsonDocument::fromJson(message.toUtf8()).object();
+        gatewaySocket->sendTextMessage(QJsonDocument(frame).toJson(QJsonDocument::Compact));
+        return true;
     }
-    else if (type == "new_fall") {
-        QString ts = data["timestamp"].toString();
-        int count = data["count"].toInt();
 
-        if (count > 0) {
-            QString event = "🚨 낙상 감지";
-            QString details = QString("낙상 감지 시각: %1").arg(ts);
+    QWebSocket *socket = socketMap.value(ip);
+    if (!socket || socket->state() != QAbstractSocket::ConnectedState)
+        return false;
+    socket->sendTextMessage(message);
+    return true;
+}
+
+void MainWindow::subscribeGatewayCameras()
+{
+    if (!gatewaySocket || gatewaySocket->state() != QAbstractSocket::ConnectedState)
+        return;
 
-            addLogEntry(camera.name, "Fall", event, "", details, camera.ip);
+    unsubscribeGatewayCameras();  // 끊긴 동안 삭제된 카메라
 
-            /*
-            // (선택) 팝업 알림도 추가 가능
-            QMessageBox *popup = new QMessageBox(this);
-            popup->setIcon(QMessageBox::Warning);
-            popup->setWindowTitle("낙상 감지");
-            popup->setText(QString("%1 카메라에서 낙상이 감지되었습니다!\n시각: %2").arg(camera.name, ts));
-            popup->setStandardButtons(QMessageBox::Ok);
-            popup->setModal(false);
-            popup->show();
-            */
-        }
+    QJsonArray cameras;
+    for (const CameraInfo &camera : cameraList) {
+        if (camera.isOnvif()) continue;
+        gatewaySubscribedCameras.insert(camera.ip);
+        QJsonObject entry;
+        entry["camera"] = camera.ip;
+        entry["url"] = QString("wss://%1:8443/ws").arg(camera.ip);
+        if (!camera.tlsFingerprint.isEmpty())
+            entry["tls_fingerprint"] = camera.tlsFingerprint;  // 게이트웨이 레지스트리에 없는 카메라도 같은 지문으로 고정
+        cameras.append(entry);
     }
-    else if (type == "stm_status_update") {
-        qDebug() << "[STM 상태 응답 수신]" << data;
-        double temp = data["temperature"].toDouble();
-        int light = data["light"].toInt();
-        bool buzzer = data["buzzer_on"].toBool();
-        bool led = data["led_on"].toBool();
-
-        QString details = QString("🌡️ 온도: %1°C | 💡 밝기: %2 | 🔔 버저: %3 | 💡 LED: %4")
-                              .arg(temp, 0, 'f', 2)
-                              .arg(light)
-                              .arg(buzzer ? "ON" : "OFF")
-                              .arg(led ? "ON" : "OFF");
-
-        healthCheckResponded.insert(camera.ip);  // ✅ 응답 확인 기록
-        addLogEntry(camera.name, "Health", "✅ 상태 수신", "", details, camera.ip);
-    }
-    else if (type == "mode_change_ack") {
-        QString status = obj["status"].toString();
-        QString mode = obj["mode"].toString();
-        QString message = obj["message"].toString();
-
-        if (status == "error") {
-            qWarning() << "[모드 변경 실패]" << message;
-            QMessageBox::warning(this, "모드 변경 실패", message);
-        } else {
-            qDebug() << "[모드 변경 성공 응답]" << mode;
+
+    QJsonObject subscribe;
+    subscribe["type"] = "gateway_subscribe";
+    subscribe["cameras"] = cameras;
+    gatewaySocket->sendTextMessage(QJsonDocument(subscribe).toJson(QJsonDocument::Compact));
+}
+
+void MainWindow::unsubscribeGatewayCameras()
+{
+    if (!gatewaySocket || gatewaySocket->state() != QAbstractSocket::ConnectedState)
+        return;  // 다시 연결되면 subscribeGatewayCameras에서 정리
+
+    QJsonArray removed;
+    for (auto it = gatewaySubscribedCameras.begin(); it != gatewaySubscribedCameras.end();) {
+        const CameraInfo *camera = findCameraByIp(*it);
+        if (camera && !camera->isOnvif()) {
+            ++it;
+            continue;
         }
+        removed.append(*it);
+        gatewayConnectedCameras.remove(*it);
+        it = gatewaySubscribedCameras.erase(it);
     }
-    else {
-        qWarning() << "[WebSocket] 알 수 없는 타입 수신:" << type;
-    }
+    if (removed.isEmpty())
+        return;
+
+    QJsonObject unsubscribe;
+    unsubscribe["type"] = "gateway_unsubscribe";
+    unsubscribe["cameras"] = removed;
+    gatewaySocket->sendTextMessage(QJsonDocument(unsubscribe).toJson(QJsonDocument::Compact));
 }
 
+void MainWindow::onGatewayMessage(const QString &frame)
+{
+    // 봉투({type, camera, msg})만 토큰화 - 카메라 메시지는 원문 범위를 잘라 수신 큐로
+    const QByteArray json = frame.toUtf8();
+    alignas(std::max_align_t) std::byte arenaBuffer[1024];
+    std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer));
+    EventFrame envelope(&arena);
+    if (!envelope.parse(std::string_view(json.constData(), size_t(json.size())))) {
+        qWarning() << "[Gateway] 메시지 파싱 실패";
+        return;
+    }
+
+    const QString ip = EventFrame::toQString(envelope.text("camera"));
+    // 목록에 없는 카메라 (삭제 직후, 게이트웨이 자체 레지스트리의 카메라) - 수신 큐/기록에 넣지 않음
+    if (!findCameraByIp(ip))
+        return;
 
-void MainWindow::onSocketConnected() {
-    qDebug() << "[웹소켓] 연결됨";
+    if (envelope.type() == "gateway_status") {
+        if (envelope.boolean("connected")) {
+            if (!gatewayConnectedCameras.contains(ip)) {
+                gatewayConnectedCameras.insert(ip);
+                qDebug() << "[Gateway] 카메라 연결됨:" << ip;
+                onCameraConnected(ip);
+            }
+        } else {
+            gatewayConnectedCameras.remove(ip);
+        }
+        return;
+    }
+
+    // 카메라 메시지 원문만 복사 (다시 직렬화하지 않음)
+    const EventFrame::Field *msg = envelope.find("msg");
+    if (!msg || msg->kind != EventFrame::Kind::Object) {
+        qWarning() << "[Gateway] msg 없음:" << ip;
+        return;
+    }
+    const QByteArray message(msg->value.data(), qsizetype(msg->value.size()));
+    if (eventRecorder)
+        eventRecorder->record(ip, message);
+    ingestQueue->enqueue(ip, message);
 }
 void MainWindow::onSocketDisconnected() {
-    qDebug() << "[웹소켓] 해제됨";
+    qDebug() << "[웹소켓] 해제됨 -" << CameraReconnectMs << "ms 후 재연결";
 }
 void MainWindow::onSocketErrorOccurred(QAbstractSocket::SocketError error) {
     qDebug() << "[웹소켓 오류]" << error;
@@ -921,88 +1727,254 @@ void MainWindow::onSocketErrorOccurred(QAbstractSocket::SocketError error) {
 
 void MainWindow::loadInitialLogs()
 {
-    fullLogEntries.clear();  // 기존 로그 초기화
-
+    // ✅ 같은 실행 안에서의 재동기화는 카메라별 sync cursor 이후 로그만 가져옴
+    // cursor는 저장하지 않음 (LogStore가 메모리뿐이라 재시작하면 이전 기록이 없음 → 첫 동기화는 전체 조회)
     for (const CameraInfo &camera : cameraList) {
-        QString urlPPE = QString("https://%1:8443/api/detections").arg(camera.ip);  // HTTPS 수정도 반영
-
-        QNetworkRequest reqPPE{QUrl(urlPPE)};
-        QNetworkReply *replyPPE = networkManager->get(reqPPE);
-        replyPPE->ignoreSslErrors();  // 자가서명 무시
-
-        connect(replyPPE, &QNetworkReply::finished, this, [=]() {
-            replyPPE->deleteLater();
+        if (camera.isOnvif()) continue;
+
+        QUrl urlPPE(QString("https://%1:8443/api/detections").arg(camera.ip));  // HTTPS 수정도 반영
+        if (auto synced = logSyncCursors.constFind(camera.ip); synced != logSyncCursors.constEnd() && synced->newestMs > 0) {
+            // since가 초과/이상 어느 쪽이어도 cursor와 같은 초의 행이 오도록 1초 앞부터 (겹친 행은 아래에서 거름)
+            QUrlQuery query;
+            query.addQueryItem("since", QDateTime::fromMSecsSinceEpoch(synced->newestMs - 1000).toString("yyyy-MM-dd HH:mm:ss"));
+            urlPPE.setQuery(query);
+        }
 
+        // 카메라별 동시 요청 제한 + 연결 재사용은 httpClient가 처리 (TLS 설정도 CameraTls 기준)
+        httpClient->get(urlPPE, this, [=](QNetworkReply *replyPPE) {
             if (replyPPE->error() != QNetworkReply::NoError) {
                 qWarning() << "[로그 요청 실패]" << camera.ip << ":" << replyPPE->errorString();
                 return;
             }
 
-            QByteArray raw = replyPPE->readAll();
-
-            QJsonDocument doc = QJsonDocument::fromJson(raw);
-            if (!doc.isObject()) {
+            const QByteArray raw = replyPPE->readAll();
+            const qint64 receivedMs = QDateTime::currentMSecsSinceEpoch();
+            StartupTimeline::mark(StartupMilestone::FirstLogSync);
+
+            // 응답 전체를 한 아레나에서 토큰화 - 원소마다 DetectionEvent 스키마로 디코딩 (실시간 경로와 같은 스키마)
+            alignas(std::max_align_t) std::byte arenaBuffer[4096];
+            std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer));
+            EventFrame response(&arena);
+            const EventFrame::Field *detections = nullptr;
+            if (response.parse(std::string_view(raw.constData(), size_t(raw.size()))))
+                detections = response.find("detections");
+            if (!detections || detections->kind != EventFrame::Kind::Array) {
                 qWarning() << "[JSON 파싱 실패]" << camera.ip;
                 return;
             }
 
-            QJsonArray arr = doc["detections"].toArray();
-
-            for (const QJsonValue &val : arr) {
-                QJsonObject obj = val.toObject();
-                int person = obj["person_count"].toInt();
-                int helmet = obj["helmet_count"].toInt();
-                int vest = obj["safety_vest_count"].toInt();
-                double conf = obj["avg_confidence"].toDouble();
-                QString ts = obj["timestamp"].toString();
-                QString imgPath = obj["image_path"].toString();
-
-                QString event;
-                if (helmet < person && vest >= person)
-                    event = "⛑️ 헬멧 미착용 감지";
-                else if (vest < person && helmet >= person)
-                    event = "🦺 조끼 미착용 감지";
-                else
-                    event = "⛑️ 🦺 PPE 미착용 감지";
-
-                QString detail = QString("👷 %1명 | ⛑️ %2명 | 🦺 %3명 | 신뢰도: %4")
-                                     .arg(person).arg(helmet).arg(vest).arg(conf, 0, 'f', 2);
-
-                fullLogEntries.append({
-                    camera.name, "PPE", event, imgPath, detail,
-                    ts.left(10), ts.mid(11, 8),
-                    static_cast<int>(cameraList.indexOf(camera)) + 1, camera.ip
-                });
+            // cursor는 응답 시점 값 기준 (동기화 요청이 겹쳐도 같은 행을 두 번 넣지 않음)
+            LogSyncCursor &cursor = logSyncCursors[camera.ip];
+            const qint64 cursorMs = cursor.newestMs;
+            qint64 newestMs = cursorMs;
+            QSet<size_t> newestRows;  // newestMs와 같은 초의 행
+            QStringList recentImages;
+            EventFrame row(&arena);
+            size_t offset = 0;
+            std::string_view element;
+
+            // 판정은 응답 전체를 모은 뒤 한 번에 - 인원/헬멧/조끼 수는 열 단위 배열로
+            const quint16 cameraId = logStore.cameraId(camera.name, camera.ip);
+            QVector<LogEntry> entries;
+            QVector<quint16> persons, helmets, vests;
+
+            while (EventFrame::nextElement(detections->value, &offset, &element)) {
+                const size_t rowKey = qHash(QByteArrayView(element.data(), qsizetype(element.size())));
+                DecodeReport report;
+                if (!row.parse(element)) {
+                    report.missing = 1;  // 객체가 아닌 원소 - 불일치로 집계
+                    restDetectionSchema.add(report);
+                    continue;
+                }
+                const DetectionEvent detection = decodeEvent<DetectionEvent>(row, &report, EventFrame::Scope::Top);
+                if (restDetectionSchema.add(report)) {
+                    qWarning() << "[로그 동기화] 스키마 불일치:" << camera.ip
+                               << "필드 누락" << report.missing << "타입 불일치" << report.wrongType << "(이후는 집계만)";
+                }
+
+                LogEntry entry;
+                entry.sourceTimestampMs = LogStore::parseServerTimestamp(detection.timestamp);
+                if (entry.sourceTimestampMs == 0) {
+                    // 시각을 못 읽은 행 - 시각 비교 대신 원문 해시로 중복 제거
+                    if (cursor.undatedRows.contains(rowKey))
+                        continue;
+                    cursor.undatedRows.insert(rowKey);
+                } else {
+                    // 서버 시각은 초 단위 - cursor보다 이전 초만 버리고, 같은 초는 이미 받은 행(원문 해시)만 거름
+                    if (entry.sourceTimestampMs < cursorMs
+                        || (entry.sourceTimestampMs == cursorMs && cursor.newestRows.contains(rowKey)))
+                        continue;
+                    if (entry.sourceTimestampMs > newestMs) {
+                        newestMs = entry.sourceTimestampMs;
+                        newestRows.clear();
+                    }
+                    if (entry.sourceTimestampMs == newestMs)
+                        newestRows.insert(rowKey);
+                }
+                // 시각을 못 읽은 행은 수신 시각으로 기록 (1970-01-01로 표시/정렬되지 않게, 감지 시각은 "-")
+                entry.timestampMs = entry.sourceTimestampMs ? entry.sourceTimestampMs : receivedMs;
+                entry.cameraId = cameraId;
+                entry.zone = static_cast<qint16>(cameraList.indexOf(camera) + 1);
+                entry.function = LogFunction::PPE;
+                entry.personCount = toLogCount(detection.personCount);
+                entry.helmetCount = toLogCount(detection.helmetCount);
+                entry.vestCount = toLogCount(detection.vestCount);
+                entry.confidence = static_cast<float>(detection.confidence);
+                const QString imgPath = EventFrame::toQString(detection.imagePath);
+                entry.imageId = logStore.internImage(imgPath);
+                if (!imgPath.isEmpty())
+                    recentImages.append(imgPath);
+
+                entries.append(entry);
+                persons.append(entry.personCount);
+                helmets.append(entry.helmetCount);
+                vests.append(entry.vestCount);
+            }
+
+            QVector<PpeResult> results(entries.size());
+            ppeTally[cameraId] += PpeClassifier::classify(persons.constData(), helmets.constData(), vests.constData(),
+                                                          entries.size(), results.data());
+            for (qsizetype i = 0; i < entries.size(); ++i) {
+                entries[i].event = PpeClassifier::logEvent(results.at(i));
+                logStore.append(entries.at(i));
+                statsAggregator.record(entries.at(i));
             }
 
-        });
+            // 최근 감지 이미지 몇 장은 미리 받아 둠 (로그 기록에서 열 때 대기 없음)
+            const int firstPrefetch = qMax(0, static_cast<int>(recentImages.size()) - PrefetchImagesPerCamera);
+            for (int i = firstPrefetch; i < recentImages.size(); ++i)
+                httpClient->prefetchImage(camera.ip, recentImages.at(i));
+
+            if (newestMs > cursorMs) {
+                cursor.newestMs = newestMs;
+                cursor.newestRows = newestRows;
+            } else {
+                cursor.newestRows.unite(newestRows);  // 같은 초에 새로 들어온 행
+            }
+        }, CameraHttpClient::Priority::Normal);
     }
 }
 
 void MainWindow::performHealthCheck()
 {
-    healthCheckResponded.clear();
     for (const CameraInfo &camera : cameraList) {
-        if (socketMap.contains(camera.ip)) {
-            QWebSocket *socket = socketMap[camera.ip];
-            QJsonObject req;
-            req["type"] = "request_stm_status";
-            QJsonDocument doc(req);
-            socket->sendTextMessage(doc.toJson(QJsonDocument::Compact));
-
-            healthCheckRequestTime[camera.ip] = QDateTime::currentDateTime();
-            qDebug() << "[헬시체크 요청 전송]" << camera.ip;
-
-            // ✅ 5초 후 응답 없으면 경고 로그 추가
-            QTimer::singleShot(5000, this, [=]() {
-                if (!healthCheckResponded.contains(camera.ip)) {
-                    addLogEntry(camera.name, "Health", "⚠️ 헬시체크 응답 없음", "", "STM 상태 응답이 5초 내 도착하지 않았습니다", camera.ip);
-                }
-            });
-        } else {
-            addLogEntry(camera.name, "Health", "❌ 웹소켓 없음", "", "웹소켓 연결이 없어 상태 요청 불가", camera.ip);
-        }
+        if (camera.isOnvif()) continue;
+        requestHealthCheck(camera);
+    }
+
+    // 영상 스트림 상태도 함께 기록 (멈춘 스트림은 이미 StreamStalled로 기록됨)
+    for (const StreamHealthMonitor::Snapshot &snapshot : videoPlayerManager->streamHealth()->snapshots()) {
+        if (snapshot.state == StreamHealthMonitor::State::Live)
+            logStreamHealth(snapshot.id, LogEvent::StreamHealth, quint32(qRound(snapshot.jitterMs)), qRound(snapshot.fps));
     }
 }
 
+void MainWindow::requestHealthCheck(const CameraInfo &camera)
+{
+    healthCheckResponded.remove(camera.ip);
+
+    QJsonObject req;
+    req["type"] = "request_stm_status";
+    QJsonDocument doc(req);
+
+    if (sendCameraMessage(camera.ip, doc.toJson(QJsonDocument::Compact))) {
+        healthCheckRequestTime[camera.ip] = QDateTime::currentDateTime();
+        qDebug() << "[헬시체크 요청 전송]" << camera.ip;
+
+        // ✅ 5초 후 응답 없으면 경고 로그 추가
+        QTimer::singleShot(5000, this, [=]() {
+            if (!healthCheckResponded.contains(camera.ip)) {
+                addLogEntry(makeLogEntry(camera.name, camera.ip, LogFunction::Health, LogEvent::HealthTimeout));
+            }
+        });
+    } else {
+        addLogEntry(makeLogEntry(camera.name, camera.ip, LogFunction::Health, LogEvent::HealthNoSocket));
+    }
+}
 
+void MainWindow::scheduleRegistrySave()
+{
+    if (replayMode)
+        return;  // 재생용 임시 카메라/커서는 저장하지 않음
+    registrySaveTimer->start();
+}
+
+void MainWindow::startReplay()
+{
+    const AppOptions &options = AppOptions::current();
+    eventReplayer = new EventReplayer(this);
+    if (!eventReplayer->load(options.replayPath)) {
+        QMessageBox::warning(this, "재생 실패", "기록 파일을 열 수 없습니다:\n" + options.replayPath);
+        return;
+    }
+
+    // 레지스트리에 없는 카메라는 재생 동안만 임시로 추가
+    bool added = false;
+    for (const QString &ip : eventReplayer->cameras()) {
+        if (findCameraByIp(ip))
+            continue;
+        CameraInfo camera;
+        camera.name = QString("Replay %1").arg(ip);
+        camera.ip = ip;
+        cameraList.append(camera);
+        added = true;
+    }
+    if (added)
+        refreshVideoGrid();
+
+    // 실시간 수신과 같은 경로 (onSocketMessageReceived → handleCameraMessage)
+    connect(eventReplayer, &EventReplayer::messageReceived, this, &MainWindow::handleCameraMessage);
+    connect(eventReplayer, &EventReplayer::finished, this, [this]() {
+        // 회귀 비교용 - 처리량과 이벤트 타입별 처리 시간
+        qDebug().noquote() << "[Replay]" << eventReplayer->statsText();
+        qDebug().noquote() << "[Replay] 디스패치 통계\n" << eventDispatcher.statsText();
+        if (memoryBudget)
+            qDebug().noquote() << "[Replay] 메모리\n" << memoryBudget->statsText();
+
+        // 장기 부하 - 같은 기록을 계속 반복 (재생 루프 밖에서 다시 시작)
+        if (AppOptions::current().replayLoop)
+            QTimer::singleShot(0, this, [this]() { eventReplayer->start(AppOptions::current().replaySpeed); });
+    });
+    eventReplayer->start(options.replaySpeed);
+}
+
+void MainWindow::startNetwork()
+{
+    StartupTimeline::mark(StartupMilestone::ShellShown);
+
+    // 웹소켓/TLS 예열/로그 동기화 요청을 먼저 내보낸 뒤 그리드 플레이어 구성 (모두 비동기 - 응답은 병렬로 도착)
+    refreshVideoGrid();
+    StartupTimeline::mark(StartupMilestone::GridReady);
+}
+
+void MainWindow::onStreamFirstFrame(const QString &ip)
+{
+    StartupTimeline::mark(StartupMilestone::FirstFrame);
+    if (startupReported || !startupPendingStreams.remove(ip))
+        return;
+
+    qDebug() << "[시작] 첫 프레임:" << ip << startupTimer.elapsed() << "ms";
+    if (startupPendingStreams.isEmpty())
+        reportStartupReady();
+}
+
+void MainWindow::reportStartupReady()
+{
+    if (startupReported)
+        return;
+    startupReported = true;
+
+    const int ready = startupStreamCount - static_cast<int>(startupPendingStreams.size());
+    if (!startupPendingStreams.isEmpty())
+        qWarning() << "[시작] 30초 내 첫 프레임 없음:" << startupPendingStreams.values();
+    startupPendingStreams.clear();
+
+    LogEntry entry = makeLogEntry("System", "", LogFunction::Health, LogEvent::StartupReady);
+    entry.durationMs = static_cast<quint32>(startupTimer.elapsed());
+    entry.count = toLogCount(ready);
+    if (ready == startupStreamCount)
+        StartupTimeline::mark(StartupMilestone::AllFrames);  // 시간 초과로 끝난 경우는 "모든 프레임"이 아님
+    addLogEntry(entry);
+
+    qDebug() << "[시작] 전체 그리드 첫 프레임까지" << entry.durationMs << "ms, 스트림" << ready << "/" << startupStreamCount;
+}
@@ -3,6 +3,22 @@
 
 #include "videoplayermanager.h"
 #include "camerainfo.h"
+#include "logstore.h"
+#include "onvifclient.h"
+#include "modecontroller.h"
+#include "eventdispatcher.h"
+#include "serverevents.h"
+#include "ppeclassifier.h"
+#include "statsaggregator.h"
+#include "ruleengine.h"
+#include "ingestqueue.h"
+#include "cameratls.h"
+#include "camerahttpclient.h"
+#include "eventrecorder.h"
+#include "eventreplayer.h"
+#include "clipbuffer.h"
+#include "activityanalyzer.h"
+#include "memorybudget.h"
 
 #include <QMainWindow>
 #include <QVector>
@@ -13,6 +29,7 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QTableWidget>
 #include <QMediaPlayer>
 #include <QVideoWidget>
@@ -20,26 +37,18 @@
 #include <QSet>  // 이 줄 추가!
 #include <QWebSocket>
 #include <QMap>
+#include <QHash>
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QGraphicsVideoItem>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QTimer>
 
 class CameraListDialog;
-
-// logentry.h 또는 mainwindow.h 내부 등 구조체 선언부에 아래처럼 추가
-struct LogEntry {
-    QString camera;
-    QString function;   // 명시적 필드 추가
-    QString alert;
-    QString imagePath;
-    QString details;
-    QString date;
-    QString time;
-    int zone;  // 실제 스트리밍 영역 번호
-    QString ip; // IP 필드 추가
-
-};
-
+class DiagnosticsDialog;
+class StatsDialog;
+class AlertPanel;
 
 class MainWindow : public QMainWindow
 {
@@ -51,16 +60,24 @@ public:
 
     void setupOnvifSection();
     void refreshVideoGrid();
-    QSet<QString> recentBlurLogKeys;  // 중복 Blur 로그 방지용 키
+
+    // 카메라 서버 메시지 1건 처리 (JSON 파싱 → 타입별 핸들러)
+    void handleCameraMessage(const QString &ip, const QString &message);
+    QSet<quint64> recentBlurLogKeys;  // 중복 Blur 로그 방지용 키 (카메라 id + 서버 시각)
+    QQueue<quint64> recentBlurLogOrder;  // 오래된 키부터 제거 (MaxRecentBlurKeys개 유지)
+    static constexpr int MaxRecentBlurKeys = 512;
 
 
 
 private slots:
     void onCameraListClicked();
     void onLogHistoryClicked();
-    void sendModeChangeRequest(const QString &mode, const CameraInfo &camera);
+    bool sendModeChangeRequest(const QString &mode, const CameraInfo &camera);
     void onAlertItemClicked(int row, int column);
     void performHealthCheck();
+    void onDiagnosticsClicked();
+    void onStatsClicked();
+    void onSnapshotClicked();
 
 private:
     void setupUI();
@@ -70,12 +87,27 @@ private:
     void setupLogSection();
     void setupFunctionPanel();
     void setupMainLayout();
-    void addLogEntry(const QString &cameraName,
-                     const QString &function,
-                     const QString &event,
-                     const QString &imagePath,
-                     const QString &details,
-                     const QString &ip);
+    void updateOnvifSection();
+    void playSelectedOnvifCamera();
+    const CameraInfo *findCameraByIp(const QString &ip) const;
+    CameraInfo *findCameraByIp(const QString &ip);
+    QStringList modeTargetIps() const;
+    void applyModeFromPanel(const QString &mode);
+    void updateModeTargetComboBox();
+    void updateModeCheckBoxes();
+    void updateModeStatusTable();
+    void onModeStateChanged(const QString &ip);
+    void onModeApplied(const QString &mode, const QStringList &succeeded,
+                       const QStringList &failed, bool rolledBack);
+    void scheduleRegistrySave();
+    void requestHealthCheck(const CameraInfo &camera);
+    void onStreamFirstFrame(const QString &ip);
+    void reportStartupReady();
+    void startNetwork();  // 창 표시 직후 한 번 - 카메라 연결/스트림/로그 동기화 시작
+    void onGridLayoutSelected(int index);
+    LogEntry makeLogEntry(const QString &cameraName, const QString &ip,
+                          LogFunction function, LogEvent event);
+    void addLogEntry(const LogEntry &entry);
     void loadInitialLogs();
 
     QHBoxLayout *topLayout;
@@ -86,24 +118,93 @@ private:
     QHBoxLayout *streamingHeaderLayout;  // setupPiVideoSection에서 구성 후 공유
 
     void setupWebSocketConnections();
+    void openCameraSocket(QWebSocket *socket, const QString &ip);  // 최초 연결 / 재연결 공통 (TLS 설정 먼저 적용)
+    bool sendCameraMessage(const QString &ip, const QString &message);  // 직접 연결 / 게이트웨이 공통
+    void onCameraConnected(const QString &ip);
+    void onGatewayMessage(const QString &frame);
+    void subscribeGatewayCameras();
+    void unsubscribeGatewayCameras();  // 구독했지만 목록에서 빠진 카메라
     void onSocketConnected();
     void onSocketDisconnected();
     void onSocketMessageReceived(const QString &message);
     void onSocketErrorOccurred(QAbstractSocket::SocketError error);
 
-    QMap<QString, int> ppeViolationStreakMap;
+    // 서버 이벤트 타입별 핸들러 (setupEventHandlers에서 디스패처에 등록)
+    void setupEventHandlers();
+    void handleDetection(const CameraInfo &camera, const DetectionEvent &event);
+    void handleTrespass(const CameraInfo &camera, const CountEvent &event);
+    void handleBlur(const CameraInfo &camera, const CountEvent &event);
+    void handleAnomaly(const CameraInfo &camera, const AnomalyEvent &event);
+    void handleFall(const CameraInfo &camera, const CountEvent &event);
+    void handleStmStatus(const CameraInfo &camera, const StmStatusEvent &event);
+    void handleModeAck(const CameraInfo &camera, const ModeAckEvent &event);
+
+    EventDispatcher eventDispatcher;
+    SchemaStats restDetectionSchema;  // loadInitialLogs 응답 원소의 스키마 불일치 집계
+    // 카메라별 로그 동기화 위치 - 이번 실행 동안만 (LogStore가 저장되지 않으므로 재시작하면 전체 조회)
+    struct LogSyncCursor {
+        qint64 newestMs = 0;        // 가져온 가장 최근 감지 시각 (서버 시각은 초 단위)
+        QSet<size_t> newestRows;    // newestMs와 같은 초에 이미 받은 행 (원문 해시)
+        QSet<size_t> undatedRows;   // 시각을 못 읽은 행 (원문 해시)
+    };
+    QHash<QString, LogSyncCursor> logSyncCursors;
+    IngestQueue *ingestQueue = nullptr;   // 카메라별 수신 큐 (우선순위 + 과부하 시 병합/버림)
+    QLabel *ingestShedLabel;              // 버림/병합 건수 표시
+    DiagnosticsDialog *diagnosticsDialog = nullptr;  // 처음 열 때 생성
+    StatsAggregator statsAggregator;       // 로그 1건마다 O(1) 누적 (분/시간 버킷)
+    StatsDialog *statsDialog = nullptr;    // 처음 열 때 생성
+
+    // 이벤트 기록 (--record) / 카메라 없이 기록 재생 (--replay)
+    void startReplay();
+    EventRecorder *eventRecorder = nullptr;
+    EventReplayer *eventReplayer = nullptr;
+    bool replayMode = false;
+
+    // 에스컬레이션 규칙 평가 → 통합 알림 패널 + 이벤트 클립 저장 (반환: LogEntry::clipId, 0 = 없음)
+    quint32 escalate(const CameraInfo &camera, RuleEngine::Event event, const QString &imagePath = QString());
+    ClipBuffer *clipBuffer = nullptr;  // 재생 중인 타일의 이벤트 전 영상
+
+    void saveSnapshot(const QString &ip, const QByteArray &jpeg, qint64 capturedMs);
+
+    // 타일 활동량 테두리 (기능 패널 체크박스로 켜고 끔)
+    void setActivityOverlayEnabled(bool enabled);
+    ActivityAnalyzer *activityAnalyzer = nullptr;
+    QStringList snapshotFiles;  // 진행 중인 스냅샷 요청에서 저장된 파일
+    RuleEngine ruleEngine;
+    AlertPanel *alertPanel = nullptr;  // 첫 알림 때 생성
+
+    // 키오스크 메모리 예산 (--kiosk / --memory-budget-mb) - 없으면 캐시별 기본 한도만
+    MemoryBudget *memoryBudget = nullptr;
+    void setupMemoryBudget(int budgetMb);
+    void pruneCameraState();  // 목록에서 빠진 카메라의 상태/소켓 정리
 
     QMap<QString, QDateTime> healthCheckRequestTime;  // IP → 요청 보낸 시각
     QSet<QString> healthCheckResponded;
 
     VideoPlayerManager *videoPlayerManager = nullptr;
 
+    QTimer *registrySaveTimer = nullptr;   // CameraRegistry 디바운스 저장
+
+    // 시작 시 전체 그리드 첫 프레임 시간 측정
+    QElapsedTimer startupTimer;
+    QSet<QString> startupPendingStreams;
+    int startupStreamCount = 0;
+    bool startupReported = false;
+
     QVector<CameraInfo> cameraList;
     QVector<QMediaPlayer*> players;
     QVector<QVideoWidget*> videoWidgets;
-    QVector<LogEntry> fullLogEntries;
-    QMap<QString, QString> lastAnomalyStatus;
+    LogStore logStore;  // 압축 로그 저장소 (전체 로그)
+    QHash<QString, bool> anomalyActive;  // 카메라 이름 → 마지막 상태가 detected
+    QHash<quint16, PpeTally> ppeTally;   // LogStore 카메라 id → PPE 판정 건수 (실시간 + 동기화)
+    QString ppeTallyText() const;        // 진단 창 표시용
 
+    OnvifClient *onvifClient = nullptr;
+    QComboBox *onvifCameraComboBox;   // 상단 ONVIF 뷰에 표시할 카메라
+    QString onvifStreamUrl;           // 현재 재생 중인 ONVIF 프로파일 URI
+    QString onvifStreamId;            // 스트림 상태 감시 id ("view:<ip>", 그리드 타일과 구분)
+    void watchOnvifStream(const QString &ip);
+    void logStreamHealth(const QString &id, LogEvent event, quint32 durationMs, int count);
     QMediaPlayer* onvifPlayer = nullptr;
     QVideoWidget* onvifVideo = nullptr;
     QWidget* onvifFrame = nullptr;
@@ -115,23 +216,46 @@ private:
     QTableWidget *logTable;
 
     QPushButton *cameraListButton;
+    QComboBox *gridLayoutComboBox;   // 1x1 / 2x2 / 3x3 / 4x4 / 사용자 지정
+    QPushButton *prevPageButton;
+    QPushButton *nextPageButton;
+    QLabel *pageLabel;
 
     QCheckBox *rawCheckBox;
     QCheckBox *blurCheckBox;
     QCheckBox *ppeDetectorCheckBox;
     QCheckBox *nightIntrusionCheckBox;
     QCheckBox *fallDetectionCheckBox;  // 🔍 낙상 감지 모드
+    QMap<QString, QCheckBox*> modeCheckBoxes;  // 모드 문자열 → 체크박스
+
+    ModeController *modeController = nullptr;
+    QComboBox *modeTargetComboBox;   // 전체 카메라 / 개별 카메라
+    QTableWidget *modeStatusTable;   // 카메라별 요청/확인 모드
+    bool modeStatusRefreshQueued = false;
 
     QMap<QString, QString> lastPpeTimestamps;
     QMap<QString, QString> lastBlurTimestamps;
 
-    void switchStreamForAllPlayers(const QString &suffix);
-
     CameraListDialog *cameraListDialog = nullptr;
     QNetworkAccessManager *networkManager;
+    CameraTls *cameraTls = nullptr;          // 세션 재사용 + 인증서 지문 고정 (REST / 웹소켓 공용)
+    QSet<QString> tlsMismatchLogged;        // 불일치 로그는 카메라당 한 번
+    CameraHttpClient *httpClient = nullptr;  // REST / 감지 이미지 요청 (카메라별 동시 요청 제한 + 이미지 캐시)
+    // 실시간 로그 테이블 행 → LogStore 항목 식별 (첫 열 아이템 데이터)
+    static constexpr int LogTimestampRole = Qt::UserRole;
+    static constexpr int LogCameraRole = Qt::UserRole + 1;
+    static constexpr int LogEventRole = Qt::UserRole + 2;
+    static constexpr int CameraReconnectMs = 3000;     // 직접 연결 웹소켓 끊김/실패 후 재연결 대기
+    static constexpr int PrefetchImagesPerCamera = 4;  // 로그 동기화 후 미리 받을 최근 이미지 수
 
     QMap<QString, QWebSocket*> socketMap;  // IP → QWebSocket*
 
+    // 게이트웨이 모드 (--gateway 또는 SSN_GATEWAY_URL) - 카메라별 소켓 대신 로컬 게이트웨이 연결 하나
+    QUrl gatewayUrl;
+    QWebSocket *gatewaySocket = nullptr;
+    QSet<QString> gatewayConnectedCameras;  // 게이트웨이가 알려준 카메라 연결 상태
+    QSet<QString> gatewaySubscribedCameras; // 게이트웨이에 구독한 카메라 (삭제 시 구독 해제)
+
     QGraphicsView *onvifView;
     QGraphicsScene *onvifScene;
     QGraphicsVideoItem *onvifVideoItem;
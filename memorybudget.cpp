@@ -0,0 +1,140 @@
+#include "memorybudget.h"
+
+#include <QDebug>
+#include <QFile>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+MemoryBudget::MemoryBudget(qint64 budgetBytes, QObject *parent)
+    : QObject(parent), budget(budgetBytes)
+{
+    historyKb.resize(HistorySamples);
+
+    sampleTimer.setInterval(SampleIntervalMs);
+    connect(&sampleTimer, &QTimer::timeout, this, &MemoryBudget::sample);
+    sampleTimer.start();
+
+    qDebug() << "[MemoryBudget] 예산" << budget / (1024 * 1024) << "MB";
+}
+
+void MemoryBudget::registerCache(const QString &name, int sharePercent, UsageFn usage, EnforceFn enforce)
+{
+    Cache cache;
+    cache.name = name;
+    cache.sharePercent = qBound(1, sharePercent, 100);
+    cache.usage = std::move(usage);
+    cache.enforce = std::move(enforce);
+    caches.append(std::move(cache));
+}
+
+void MemoryBudget::enforce()
+{
+    applyLimits(false);
+}
+
+void MemoryBudget::applyLimits(bool underPressure)
+{
+    for (Cache &cache : caches) {
+        cache.limitBytes = budget * cache.sharePercent / 100;
+        if (underPressure)
+            cache.limitBytes /= 2;
+        cache.enforce(cache.limitBytes);
+    }
+}
+
+void MemoryBudget::sample()
+{
+    const qint64 rss = residentBytes();
+    if (rss > 0) {
+        historyKb[historyNext] = static_cast<quint32>(qMin<qint64>(rss / 1024, 0xFFFFFFFF));
+        historyNext = (historyNext + 1) % HistorySamples;
+        historyCount = qMin(historyCount + 1, HistorySamples);
+        peakBytes = qMax(peakBytes, rss);
+    }
+
+    const bool underPressure = rss > budget;
+    if (underPressure) {
+        ++pressureCount;
+        qWarning() << "[MemoryBudget] RSS" << rss / (1024 * 1024) << "MB > 예산" << budget / (1024 * 1024)
+                   << "MB - 캐시 한도 절반 적용";
+        emit budgetExceeded(rss, budget);
+    }
+    applyLimits(underPressure);
+}
+
+double MemoryBudget::growthBytesPerDay() const
+{
+    if (historyCount < MinTrendSamples)
+        return 0.0;
+
+    // 최소제곱 기울기 (x = 샘플 순번, 가장 오래된 샘플부터)
+    const int first = historyCount < HistorySamples ? 0 : historyNext;
+    const double n = historyCount;
+    double sumX = 0.0, sumY = 0.0, sumXY = 0.0, sumXX = 0.0;
+    for (int i = 0; i < historyCount; ++i) {
+        const double y = historyKb.at((first + i) % HistorySamples) * 1024.0;
+        sumX += i;
+        sumY += y;
+        sumXY += i * y;
+        sumXX += double(i) * i;
+    }
+    const double denominator = n * sumXX - sumX * sumX;
+    if (denominator <= 0.0)
+        return 0.0;
+    const double bytesPerSample = (n * sumXY - sumX * sumY) / denominator;
+    return bytesPerSample * (24.0 * 60 * 60 * 1000 / SampleIntervalMs);
+}
+
+QString MemoryBudget::statsText() const
+{
+    const qint64 rss = residentBytes();
+    QString text = QString("RSS %1 MB / 예산 %2 MB | 최대 %3 MB | 추이 %4 MB/일 (%5분) | 초과 %6회\n")
+                       .arg(rss / (1024 * 1024))
+                       .arg(budget / (1024 * 1024))
+                       .arg(peakBytes / (1024 * 1024))
+                       .arg(growthBytesPerDay() / (1024 * 1024), 0, 'f', 1)
+                       .arg(historyCount * (SampleIntervalMs / 60000))
+                       .arg(pressureCount);
+    for (const Cache &cache : caches) {
+        text += QString("%1: %2 / %3 KB (%4%)\n")
+                    .arg(cache.name)
+                    .arg(cache.usage() / 1024)
+                    .arg(cache.limitBytes / 1024)
+                    .arg(cache.sharePercent);
+    }
+    return text.trimmed();
+}
+
+qint64 MemoryBudget::residentBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return static_cast<qint64>(counters.WorkingSetSize);
+    return 0;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+        return static_cast<qint64>(info.resident_size);
+    return 0;
+#elif defined(Q_OS_LINUX)
+    // /proc/self/statm: size resident shared ... (페이지 단위)
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return 0;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return 0;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
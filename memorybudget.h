@@ -0,0 +1,64 @@
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+
+// 키오스크(장기 무인 실행)용 전체 메모리 예산
+// - 서브시스템은 캐시를 등록만 하고 (이름, 예산 비율, 사용량, 한도 적용) 한도는 각자 지킴
+// - SampleIntervalMs마다 RSS를 기록해 최근 7일 추이(하루 증가량)를 보관
+// - RSS가 예산을 넘으면 그 주기에는 모든 캐시 한도를 절반으로 적용
+class MemoryBudget : public QObject
+{
+    Q_OBJECT
+
+public:
+    using UsageFn = std::function<qint64()>;                  // 현재 사용량 (바이트)
+    using EnforceFn = std::function<void(qint64 limitBytes)>; // 한도 적용
+
+    explicit MemoryBudget(qint64 budgetBytes, QObject *parent = nullptr);
+
+    void registerCache(const QString &name, int sharePercent, UsageFn usage, EnforceFn enforce);
+    void enforce();  // 등록 직후 / 예산 변경 시 바로 적용 (평소에는 샘플링 주기마다)
+
+    qint64 budgetBytes() const { return budget; }
+    double growthBytesPerDay() const;  // RSS 추이 기울기 (샘플이 1시간 미만이면 0)
+    QString statsText() const;         // 진단 창 표시용
+
+    static qint64 residentBytes();     // 현재 프로세스 RSS (알 수 없으면 0)
+
+    static constexpr int SampleIntervalMs = 60 * 1000;
+    static constexpr int HistorySamples = 7 * 24 * 60;  // 7일 (분 단위, KB로 보관 - 약 40 KB)
+    static constexpr int MinTrendSamples = 60;
+
+signals:
+    void budgetExceeded(qint64 residentBytes, qint64 budgetBytes);
+
+private:
+    struct Cache {
+        QString name;
+        int sharePercent = 0;
+        UsageFn usage;
+        EnforceFn enforce;
+        qint64 limitBytes = 0;
+    };
+
+    void sample();
+    void applyLimits(bool underPressure);
+
+    qint64 budget;
+    QVector<Cache> caches;
+    QTimer sampleTimer;
+
+    QVector<quint32> historyKb;  // 링 버퍼 - RSS KB
+    int historyNext = 0;
+    int historyCount = 0;
+    qint64 peakBytes = 0;
+    quint64 pressureCount = 0;
+};
+
+#endif // MEMORYBUDGET_H
@@ -0,0 +1,183 @@
+#include "modecontroller.h"
+
+#include <QDebug>
+
+ModeController::ModeController(Sender sender, QObject *parent)
+    : QObject(parent), sender(std::move(sender))
+{
+}
+
+void ModeController::applyMode(const QString &mode, const QStringList &ips)
+{
+    if (mode.isEmpty() || ips.isEmpty())
+        return;
+    startBatch(mode, ips, false);
+}
+
+int ModeController::startBatch(const QString &mode, const QStringList &ips, bool isRollback,
+                               const QHash<QString, QString> &rollbackModes)
+{
+    const int batchId = nextBatchId++;
+    Batch &batch = batches[batchId];
+    batch.mode = mode;
+    batch.isRollback = isRollback;
+
+    batch.deadline = new QTimer(this);
+    batch.deadline->setSingleShot(true);
+    connect(batch.deadline, &QTimer::timeout, this, [this, batchId]() {
+        auto it = batches.find(batchId);
+        if (it == batches.end())
+            return;
+        const QStringList timedOut = it->pending.values();
+        for (const QString &ip : timedOut)
+            resolve(batchId, ip, false, "응답 시간 초과");
+    });
+
+    // 이전 요청이 진행 중인 카메라는 새 요청으로 대체 (이전 batch에서는 제외)
+    QList<int> supersededBatches;
+    for (const QString &ip : ips) {
+        if (auto previous = batchOfCamera.find(ip); previous != batchOfCamera.end()) {
+            if (auto old = batches.find(previous.value()); old != batches.end()) {
+                old->pending.remove(ip);
+                if (old->pending.isEmpty())
+                    supersededBatches.append(previous.value());
+            }
+        }
+        batchOfCamera.insert(ip, batchId);
+
+        CameraModeState &state = states[ip];
+        batch.previousAcked.insert(ip, state.acked);
+        state.desired = isRollback ? rollbackModes.value(ip) : mode;
+        state.pending = true;
+        state.error.clear();
+        batch.pending.insert(ip);
+        emit stateChanged(ip);
+    }
+
+    for (int oldBatchId : std::as_const(supersededBatches))
+        finishBatch(oldBatchId);
+
+    // 모든 대상에 먼저 전송하고 응답은 한 번의 기한으로 함께 기다림
+    // 연결 전인 카메라는 실패가 아닌 대기 - 소켓 연결 시 요청 모드가 다시 적용됨
+    for (const QString &ip : ips) {
+        const QString targetMode = isRollback ? rollbackModes.value(ip) : mode;
+        if (!sender(ip, targetMode))
+            resolve(batchId, ip, false, QString());
+    }
+
+    if (batches.contains(batchId))
+        batches[batchId].deadline->start(ackTimeoutMs);
+    return batchId;
+}
+
+void ModeController::handleAck(const QString &ip, const QString &mode, const QString &status, const QString &message)
+{
+    const int batchId = batchOfCamera.value(ip, 0);
+    auto it = batches.find(batchId);
+    if (it == batches.end() || !it->pending.contains(ip)) {
+        // 요청 없이 도착한 ack - 확인 모드만 갱신
+        if (status != "error" && !mode.isEmpty()) {
+            states[ip].acked = mode;
+            emit stateChanged(ip);
+        }
+        return;
+    }
+
+    if (status == "error") {
+        resolve(batchId, ip, false, message.isEmpty() ? QStringLiteral("서버 오류") : message);
+        return;
+    }
+
+    // 서버가 mode를 생략하면 요청한 모드로 간주
+    const QString expected = states.value(ip).desired;
+    if (!mode.isEmpty() && mode != expected) {
+        qDebug() << "[모드 제어] 이전 요청의 ack 무시:" << ip << mode;
+        return;
+    }
+    resolve(batchId, ip, true, QString());
+}
+
+void ModeController::resolve(int batchId, const QString &ip, bool ok, const QString &error)
+{
+    auto it = batches.find(batchId);
+    if (it == batches.end() || !it->pending.remove(ip))
+        return;
+
+    CameraModeState &state = states[ip];
+    state.pending = false;
+    if (ok) {
+        const QString previous = state.acked;
+        state.acked = state.desired;
+        state.error.clear();
+        it->succeeded.append(ip);
+        emit cameraModeAcked(ip, state.acked, previous);
+    } else if (error.isEmpty()) {
+        state.error.clear();
+        qDebug() << "[모드 제어] 연결 대기:" << ip << state.desired;
+    } else {
+        state.error = error;
+        it->failed.append(ip);
+        qWarning() << "[모드 제어] 전환 실패:" << ip << state.desired << "-" << error;
+    }
+    emit stateChanged(ip);
+
+    if (it->pending.isEmpty())
+        finishBatch(batchId);
+}
+
+void ModeController::finishBatch(int batchId)
+{
+    Batch batch = batches.take(batchId);
+    batch.deadline->deleteLater();
+
+    for (auto it = batchOfCamera.begin(); it != batchOfCamera.end();) {
+        if (it.value() == batchId)
+            it = batchOfCamera.erase(it);
+        else
+            ++it;
+    }
+
+    // 일부만 실패하면 성공한 카메라를 이전 모드로 되돌려 사이트 전체를 같은 상태로 유지
+    bool rolledBack = false;
+    if (!batch.isRollback && rollbackOnPartialFailure
+        && !batch.failed.isEmpty() && !batch.succeeded.isEmpty()) {
+        QHash<QString, QString> rollbackModes;
+        QStringList targets;
+        for (const QString &ip : std::as_const(batch.succeeded)) {
+            const QString previous = batch.previousAcked.value(ip);
+            if (previous.isEmpty() || previous == batch.mode)
+                continue;  // 이전 확인 모드를 모르면 되돌릴 수 없음
+            if (batchOfCamera.contains(ip))
+                continue;  // 이후 요청이 이미 진행 중
+            rollbackModes.insert(ip, previous);
+            targets.append(ip);
+        }
+        // 실패한 카메라는 원래 모드를 유지하는 것으로 간주
+        for (const QString &ip : std::as_const(batch.failed)) {
+            const QString previous = batch.previousAcked.value(ip);
+            if (previous.isEmpty())
+                continue;
+            states[ip].desired = previous;
+            emit stateChanged(ip);
+        }
+        if (!targets.isEmpty()) {
+            qWarning() << "[모드 제어] 부분 실패 → 롤백:" << targets;
+            startBatch(QString(), targets, true, rollbackModes);
+            rolledBack = true;
+        }
+    }
+
+    if (!batch.isRollback)
+        emit modeApplied(batch.mode, batch.succeeded, batch.failed, rolledBack);
+}
+
+void ModeController::removeCamera(const QString &ip)
+{
+    const int batchId = batchOfCamera.take(ip);
+    if (auto it = batches.find(batchId); it != batches.end()) {
+        it->pending.remove(ip);
+        if (it->pending.isEmpty())
+            finishBatch(batchId);
+    }
+    states.remove(ip);
+}
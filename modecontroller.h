@@ -0,0 +1,72 @@
+#ifndef MODECONTROLLER_H
+#define MODECONTROLLER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+#include <functional>
+
+// 카메라별 모드 상태 관리 - set_mode 동시 전송, 기한 내 mode_change_ack 대기, 부분 실패 시 롤백
+class ModeController : public QObject
+{
+    Q_OBJECT
+
+public:
+    // set_mode 메시지 전송 함수 (전송 불가 시 false)
+    using Sender = std::function<bool(const QString &ip, const QString &mode)>;
+
+    struct CameraModeState {
+        QString desired;    // 마지막으로 요청한 모드
+        QString acked;      // 서버가 확인한 모드
+        bool pending = false;
+        QString error;      // 마지막 실패 사유
+    };
+
+    explicit ModeController(Sender sender, QObject *parent = nullptr);
+
+    void setAckTimeout(int ms) { ackTimeoutMs = ms; }
+    void setRollbackOnPartialFailure(bool enabled) { rollbackOnPartialFailure = enabled; }
+
+    // 대상 카메라 전체에 동시에 전송 - 결과는 modeApplied로 한 번에 보고
+    void applyMode(const QString &mode, const QStringList &ips);
+    void handleAck(const QString &ip, const QString &mode, const QString &status, const QString &message);
+
+    CameraModeState state(const QString &ip) const { return states.value(ip); }
+    QStringList cameras() const { return states.keys(); }  // 상태를 가진 카메라 (삭제된 카메라 정리용)
+    void removeCamera(const QString &ip);
+
+signals:
+    void stateChanged(const QString &ip);
+    void cameraModeAcked(const QString &ip, const QString &mode, const QString &previousMode);
+    void modeApplied(const QString &mode, const QStringList &succeeded,
+                     const QStringList &failed, bool rolledBack);
+
+private:
+    struct Batch {
+        QString mode;
+        QSet<QString> pending;
+        QStringList succeeded;
+        QStringList failed;
+        QHash<QString, QString> previousAcked;  // 롤백용
+        QTimer *deadline = nullptr;
+        bool isRollback = false;
+    };
+
+    int startBatch(const QString &mode, const QStringList &ips, bool isRollback,
+                   const QHash<QString, QString> &rollbackModes = {});
+    void resolve(int batchId, const QString &ip, bool ok, const QString &error);  // !ok && error 없음 = 연결 대기
+    void finishBatch(int batchId);
+
+    Sender sender;
+    QHash<QString, CameraModeState> states;
+    QHash<int, Batch> batches;
+    QHash<QString, int> batchOfCamera;  // IP → 진행 중 batch (새 요청이 이전 요청을 대체)
+    int nextBatchId = 1;
+    int ackTimeoutMs = 5000;
+    bool rollbackOnPartialFailure = true;
+};
+
+#endif // MODECONTROLLER_H
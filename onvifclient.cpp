@@ -0,0 +1,271 @@
+#include "onvifclient.h"
+
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QXmlStreamReader>
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QDateTime>
+#include <QDebug>
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+const QString DeviceNs = QStringLiteral("http://www.onvif.org/ver10/device/wsdl");
+const QString MediaNs = QStringLiteral("http://www.onvif.org/ver10/media/wsdl");
+
+QString parseMediaXAddr(const QByteArray &xml)
+{
+    QXmlStreamReader reader(xml);
+    bool inMedia = false;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            if (reader.name() == QLatin1String("Media"))
+                inMedia = true;
+            else if (inMedia && reader.name() == QLatin1String("XAddr"))
+                return reader.readElementText().trimmed();
+        } else if (reader.isEndElement() && reader.name() == QLatin1String("Media")) {
+            inMedia = false;
+        }
+    }
+    return QString();
+}
+
+QVector<OnvifProfile> parseProfiles(const QByteArray &xml)
+{
+    QVector<OnvifProfile> result;
+    QXmlStreamReader reader(xml);
+    bool inProfile = false;
+    bool inEncoder = false;
+
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            const auto name = reader.name();
+            if (name == QLatin1String("Profiles")) {
+                inProfile = true;
+                OnvifProfile profile;
+                profile.token = reader.attributes().value("token").toString();
+                result.append(profile);
+            } else if (inProfile && name == QLatin1String("VideoEncoderConfiguration")) {
+                inEncoder = true;
+            } else if (inProfile && name == QLatin1String("Name") && result.last().name.isEmpty()) {
+                result.last().name = reader.readElementText();
+            } else if (inEncoder && name == QLatin1String("Width")) {
+                result.last().resolution.setWidth(reader.readElementText().toInt());
+            } else if (inEncoder && name == QLatin1String("Height")) {
+                result.last().resolution.setHeight(reader.readElementText().toInt());
+            }
+        } else if (reader.isEndElement()) {
+            if (reader.name() == QLatin1String("Profiles"))
+                inProfile = false;
+            else if (reader.name() == QLatin1String("VideoEncoderConfiguration"))
+                inEncoder = false;
+        }
+    }
+    return result;
+}
+
+QString parseStreamUri(const QByteArray &xml)
+{
+    QXmlStreamReader reader(xml);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement() && reader.name() == QLatin1String("Uri"))
+            return reader.readElementText().trimmed();
+    }
+    return QString();
+}
+
+qint64 pixelArea(const OnvifProfile &profile)
+{
+    return qint64(profile.resolution.width()) * profile.resolution.height();
+}
+
+} // namespace
+
+OnvifClient::OnvifClient(QNetworkAccessManager *manager, QObject *parent)
+    : QObject(parent), networkManager(manager)
+{
+}
+
+void OnvifClient::discover(const CameraInfo &camera)
+{
+    if (!camera.isOnvif() || profileCache.contains(camera.ip) || inFlight.contains(camera.ip))
+        return;
+    if (retryDelayMs(camera.ip) > 0)
+        return;  // 직전 실패 후 백오프 중 - 페이지 재바인딩마다 다시 조회하지 않음
+
+    inFlight.insert(camera.ip);
+    requestMediaService(camera);
+}
+
+int OnvifClient::retryDelayMs(const QString &ip) const
+{
+    auto it = retryState.constFind(ip);
+    if (it == retryState.constEnd())
+        return 0;
+    return static_cast<int>(qMax<qint64>(0, it->nextAttemptMs - QDateTime::currentMSecsSinceEpoch()));
+}
+
+OnvifProfile OnvifClient::selectProfile(const QVector<OnvifProfile> &profiles, const QSize &viewSize)
+{
+    // profiles는 해상도 오름차순 - 뷰를 채우는 첫 프로파일이 가장 가벼운 선택
+    for (const OnvifProfile &profile : profiles) {
+        if (profile.resolution.width() >= viewSize.width() && profile.resolution.height() >= viewSize.height())
+            return profile;
+    }
+    return profiles.isEmpty() ? OnvifProfile() : profiles.last();
+}
+
+void OnvifClient::requestMediaService(const CameraInfo &camera)
+{
+    const QString body = QString("<tds:GetCapabilities xmlns:tds=\"%1\"><tds:Category>Media</tds:Category></tds:GetCapabilities>")
+                             .arg(DeviceNs);
+
+    QNetworkReply *reply = post(camera, QUrl(camera.onvifServiceUrl()),
+                                QString("%1/GetCapabilities").arg(DeviceNs), body);
+
+    connect(reply, &QNetworkReply::finished, this, [=]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            fail(camera, reply->errorString());
+            return;
+        }
+
+        QString xaddr = parseMediaXAddr(reply->readAll());
+        if (xaddr.isEmpty()) {
+            fail(camera, "Media XAddr 없음");
+            return;
+        }
+        requestProfiles(camera, QUrl(xaddr));
+    });
+}
+
+void OnvifClient::requestProfiles(const CameraInfo &camera, const QUrl &mediaUrl)
+{
+    const QString body = QString("<trt:GetProfiles xmlns:trt=\"%1\"/>").arg(MediaNs);
+    QNetworkReply *reply = post(camera, mediaUrl, QString("%1/GetProfiles").arg(MediaNs), body);
+
+    connect(reply, &QNetworkReply::finished, this, [=]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            fail(camera, reply->errorString());
+            return;
+        }
+
+        QVector<OnvifProfile> profiles = parseProfiles(reply->readAll());
+        if (profiles.isEmpty()) {
+            fail(camera, "미디어 프로파일 없음");
+            return;
+        }
+        requestStreamUris(camera, mediaUrl, profiles);
+    });
+}
+
+void OnvifClient::requestStreamUris(const CameraInfo &camera, const QUrl &mediaUrl, QVector<OnvifProfile> profiles)
+{
+    // 프로파일별 GetStreamUri를 동시에 보내고 모두 끝나면 캐시에 반영
+    auto pending = std::make_shared<int>(static_cast<int>(profiles.size()));
+    auto collected = std::make_shared<QVector<OnvifProfile>>(profiles);
+
+    for (int i = 0; i < profiles.size(); ++i) {
+        const QString body = QString(
+            "<trt:GetStreamUri xmlns:trt=\"%1\" xmlns:tt=\"http://www.onvif.org/ver10/schema\">"
+            "<trt:StreamSetup><tt:Stream>RTP-Unicast</tt:Stream>"
+            "<tt:Transport><tt:Protocol>RTSP</tt:Protocol></tt:Transport></trt:StreamSetup>"
+            "<trt:ProfileToken>%2</trt:ProfileToken></trt:GetStreamUri>")
+                                 .arg(MediaNs, profiles[i].token.toHtmlEscaped());
+
+        QNetworkReply *reply = post(camera, mediaUrl, QString("%1/GetStreamUri").arg(MediaNs), body);
+
+        connect(reply, &QNetworkReply::finished, this, [=]() {
+            reply->deleteLater();
+            if (reply->error() == QNetworkReply::NoError) {
+                // 인증 정보는 붙이지 않음 (레지스트리에 저장되는 값) - 재생 직전에 onvifPlaybackUrl
+                (*collected)[i].streamUri = parseStreamUri(reply->readAll());
+            } else {
+                qWarning() << "[ONVIF] GetStreamUri 실패" << camera.ip << (*collected)[i].token << reply->errorString();
+            }
+
+            if (--(*pending) > 0)
+                return;
+
+            QVector<OnvifProfile> usable;
+            for (const OnvifProfile &profile : std::as_const(*collected)) {
+                if (!profile.streamUri.isEmpty())
+                    usable.append(profile);
+            }
+            if (usable.isEmpty()) {
+                fail(camera, "스트림 URI 없음");
+                return;
+            }
+
+            std::sort(usable.begin(), usable.end(), [](const OnvifProfile &a, const OnvifProfile &b) {
+                return pixelArea(a) < pixelArea(b);
+            });
+
+            inFlight.remove(camera.ip);
+            retryState.remove(camera.ip);
+            profileCache.insert(camera.ip, usable);
+            qDebug() << "[ONVIF] 프로파일" << usable.size() << "개 조회됨:" << camera.ip;
+            emit profilesReady(camera.ip);
+        });
+    }
+}
+
+void OnvifClient::fail(const CameraInfo &camera, const QString &error)
+{
+    inFlight.remove(camera.ip);
+
+    RetryState &retry = retryState[camera.ip];
+    const int delay = qMin(RetryMaxMs, RetryBaseMs << qMin(retry.failures, 5));
+    ++retry.failures;
+    retry.nextAttemptMs = QDateTime::currentMSecsSinceEpoch() + delay;
+
+    qWarning() << "[ONVIF] 프로파일 조회 실패" << camera.ip << ":" << error << "-" << delay << "ms 후 재시도";
+    emit discoveryFailed(camera.ip, error);
+}
+
+QNetworkReply *OnvifClient::post(const CameraInfo &camera, const QUrl &url, const QString &action, const QString &body)
+{
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader,
+                      QString("application/soap+xml; charset=utf-8; action=\"%1\"").arg(action));
+    request.setTransferTimeout(5000);
+    return networkManager->post(request, envelope(camera, body));
+}
+
+QByteArray OnvifClient::envelope(const CameraInfo &camera, const QString &body) const
+{
+    QString header;
+    if (!camera.onvifUser.isEmpty()) {
+        // WS-Security UsernameToken (PasswordDigest)
+        QByteArray nonce(16, Qt::Uninitialized);
+        for (char &c : nonce)
+            c = static_cast<char>(QRandomGenerator::global()->bounded(256));
+        const QByteArray created = QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toUtf8();
+        const QByteArray digest = QCryptographicHash::hash(nonce + created + camera.onvifPassword.toUtf8(),
+                                                           QCryptographicHash::Sha1).toBase64();
+
+        header = QString(
+            "<s:Header><wsse:Security xmlns:wsse=\"http://docs.oasis-open.org/wss/2004/01/oasis-200401-wss-wssecurity-secext-1.0.xsd\" "
+            "xmlns:wsu=\"http://docs.oasis-open.org/wss/2004/01/oasis-200401-wss-wssecurity-utility-1.0.xsd\">"
+            "<wsse:UsernameToken><wsse:Username>%1</wsse:Username>"
+            "<wsse:Password Type=\"http://docs.oasis-open.org/wss/2004/01/oasis-200401-wss-username-token-profile-1.0#PasswordDigest\">%2</wsse:Password>"
+            "<wsse:Nonce EncodingType=\"http://docs.oasis-open.org/wss/2004/01/oasis-200401-wss-soap-message-security-1.0#Base64Binary\">%3</wsse:Nonce>"
+            "<wsu:Created>%4</wsu:Created></wsse:UsernameToken></wsse:Security></s:Header>")
+                     .arg(camera.onvifUser.toHtmlEscaped(),
+                          QString::fromLatin1(digest),
+                          QString::fromLatin1(nonce.toBase64()),
+                          QString::fromLatin1(created));
+    }
+
+    return QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                   "<s:Envelope xmlns:s=\"http://www.w3.org/2003/05/soap-envelope\">%1<s:Body>%2</s:Body></s:Envelope>")
+        .arg(header, body)
+        .toUtf8();
+}
@@ -0,0 +1,66 @@
+#ifndef ONVIFCLIENT_H
+#define ONVIFCLIENT_H
+
+#include "camerainfo.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QSize>
+#include <QUrl>
+#include <QVector>
+#include <QNetworkAccessManager>
+
+struct OnvifProfile {
+    QString token;
+    QString name;
+    QSize resolution;   // VideoEncoderConfiguration 해상도
+    QString streamUri;  // GetStreamUri 결과 (인증 정보 없음 - 재생 시 CameraInfo::onvifPlaybackUrl)
+};
+
+// ONVIF SOAP 클라이언트 - GetCapabilities → GetProfiles → GetStreamUri 순서로 미디어 프로파일 조회
+// 엔드포인트는 CameraInfo::onvifServiceUrl() 기준이라 로컬 스텁 서버로 바꿔 테스트 가능
+class OnvifClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OnvifClient(QNetworkAccessManager *manager, QObject *parent = nullptr);
+
+    void discover(const CameraInfo &camera);  // 이미 조회 중이거나 캐시에 있거나 재시도 대기 중이면 무시
+    int retryDelayMs(const QString &ip) const;  // 실패 후 다음 조회까지 남은 시간 (0 = 바로 가능)
+    bool hasProfiles(const QString &ip) const { return profileCache.contains(ip); }
+    QVector<OnvifProfile> profiles(const QString &ip) const { return profileCache.value(ip); }
+
+    // 뷰 크기를 채우는 가장 낮은 프로파일, 없으면 가장 높은 프로파일
+    static OnvifProfile selectProfile(const QVector<OnvifProfile> &profiles, const QSize &viewSize);
+
+    // 조회 실패 시 지수 백오프 (RetryBaseMs → 2배씩 → RetryMaxMs), 성공하면 초기화
+    static constexpr int RetryBaseMs = 2000;
+    static constexpr int RetryMaxMs = 60000;
+
+signals:
+    void profilesReady(const QString &ip);
+    void discoveryFailed(const QString &ip, const QString &error);
+
+private:
+    void requestMediaService(const CameraInfo &camera);
+    void requestProfiles(const CameraInfo &camera, const QUrl &mediaUrl);
+    void requestStreamUris(const CameraInfo &camera, const QUrl &mediaUrl, QVector<OnvifProfile> profiles);
+    void fail(const CameraInfo &camera, const QString &error);
+
+    QNetworkReply *post(const CameraInfo &camera, const QUrl &url, const QString &action, const QString &body);
+    QByteArray envelope(const CameraInfo &camera, const QString &body) const;
+
+    QNetworkAccessManager *networkManager;
+    QHash<QString, QVector<OnvifProfile>> profileCache;  // IP → 해상도 오름차순 프로파일
+    QSet<QString> inFlight;
+
+    struct RetryState {
+        int failures = 0;
+        qint64 nextAttemptMs = 0;
+    };
+    QHash<QString, RetryState> retryState;
+};
+
+#endif // ONVIFCLIENT_H
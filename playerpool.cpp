@@ -0,0 +1,61 @@
+#include "playerpool.h"
+
+#include <QDebug>
+
+PlayerPool::PlayerPool(int maxActive, QObject *parent)
+    : QObject(parent), maxActiveCount(qMax(1, maxActive))
+{
+}
+
+PlayerPool::~PlayerPool()
+{
+    // 종료 시에는 자식 객체로 함께 삭제됨
+    for (QMediaPlayer *player : std::as_const(active))
+        player->stop();
+}
+
+QMediaPlayer *PlayerPool::acquire()
+{
+    if (activeCount() >= maxActiveCount) {
+        // capacityAvailable마다 bindPage가 다시 요청하므로 포화 구간 시작에만 경고
+        if (!saturated)
+            qWarning() << "[PlayerPool] 동시 디코더 한도 도달:" << maxActiveCount;
+        saturated = true;
+        return nullptr;
+    }
+    saturated = false;
+
+    QMediaPlayer *player = idle.isEmpty() ? new QMediaPlayer(this) : idle.takeLast();
+    active.insert(player);
+    return player;
+}
+
+void PlayerPool::release(QMediaPlayer *player)
+{
+    if (!player || !active.remove(player))
+        return;
+
+    // stop()은 백엔드에 따라 수십 ms 걸릴 수 있으므로 현재 호출 경로에서 분리
+    ++pendingTeardown;
+    QMetaObject::invokeMethod(this, [this, player]() { teardown(player); }, Qt::QueuedConnection);
+}
+
+void PlayerPool::setMaxActive(int maxActive)
+{
+    maxActiveCount = qMax(1, maxActive);
+}
+
+void PlayerPool::teardown(QMediaPlayer *player)
+{
+    player->stop();
+    player->setVideoOutput(nullptr);
+    player->setSource(QUrl());
+
+    if (idle.size() < maxIdle)
+        idle.append(player);
+    else
+        player->deleteLater();
+
+    --pendingTeardown;
+    emit capacityAvailable();
+}
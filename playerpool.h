@@ -0,0 +1,44 @@
+#ifndef PLAYERPOOL_H
+#define PLAYERPOOL_H
+
+#include <QObject>
+#include <QSet>
+#include <QVector>
+#include <QMediaPlayer>
+
+// QMediaPlayer 재사용 풀 - 동시 디코더 수 상한 + 비동기 정리
+class PlayerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PlayerPool(int maxActive, QObject *parent = nullptr);
+    ~PlayerPool();
+
+    // 한도 초과 시 nullptr - 호출자가 setVideoOutput / setSource 설정
+    QMediaPlayer *acquire();
+
+    // 호출자는 자신의 connect를 먼저 끊을 것 (player->disconnect(receiver))
+    // 정지/출력 해제는 이벤트 루프에서 처리되고, 끝나면 재사용 대기열 또는 deleteLater
+    void release(QMediaPlayer *player);
+
+    void setMaxActive(int maxActive);
+    int maxActive() const { return maxActiveCount; }
+    int activeCount() const { return static_cast<int>(active.size()) + pendingTeardown; }
+    int idleCount() const { return static_cast<int>(idle.size()); }
+
+signals:
+    void capacityAvailable();  // 정리가 끝나 acquire() 가능해짐
+
+private:
+    void teardown(QMediaPlayer *player);
+
+    QSet<QMediaPlayer*> active;
+    QVector<QMediaPlayer*> idle;
+    int pendingTeardown = 0;
+    int maxActiveCount;
+    int maxIdle = 4;
+    bool saturated = false;  // 한도 도달 경고는 포화 구간마다 한 번만
+};
+
+#endif // PLAYERPOOL_H
@@ -0,0 +1,55 @@
+#include "ppeclassifier.h"
+
+void PpeTally::add(PpeResult result)
+{
+    switch (result) {
+    case PpeResult::Compliant:     ++compliant; break;
+    case PpeResult::HelmetMissing: ++helmetMissing; break;
+    case PpeResult::VestMissing:   ++vestMissing; break;
+    case PpeResult::BothMissing:   ++bothMissing; break;
+    }
+}
+
+PpeTally &PpeTally::operator+=(const PpeTally &other)
+{
+    compliant += other.compliant;
+    helmetMissing += other.helmetMissing;
+    vestMissing += other.vestMissing;
+    bothMissing += other.bothMissing;
+    return *this;
+}
+
+PpeTally PpeClassifier::classify(const quint16 *person, const quint16 *helmet, const quint16 *vest,
+                                 qsizetype count, PpeResult *results)
+{
+    // 건수도 비교 결과(0/1)를 더하기만 - 분기/테이블 조회 없음
+    quint32 helmetOnly = 0;
+    quint32 vestOnly = 0;
+    quint32 both = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const quint32 h = helmet[i] < person[i];
+        const quint32 v = vest[i] < person[i];
+        results[i] = static_cast<PpeResult>(h | v << 1);
+        helmetOnly += h & ~v;
+        vestOnly += v & ~h;
+        both += h & v;
+    }
+
+    PpeTally tally;
+    tally.helmetMissing = helmetOnly;
+    tally.vestMissing = vestOnly;
+    tally.bothMissing = both;
+    tally.compliant = quint32(count) - helmetOnly - vestOnly - both;
+    return tally;
+}
+
+LogEvent PpeClassifier::logEvent(PpeResult result)
+{
+    switch (result) {
+    case PpeResult::HelmetMissing: return LogEvent::HelmetMissing;
+    case PpeResult::VestMissing:   return LogEvent::VestMissing;
+    case PpeResult::BothMissing:   return LogEvent::PpeMissing;
+    case PpeResult::Compliant:     break;
+    }
+    return LogEvent::PpeCompliant;
+}
@@ -0,0 +1,48 @@
+#ifndef PPECLASSIFIER_H
+#define PPECLASSIFIER_H
+
+#include "logentry.h"
+
+#include <QtGlobal>
+
+// PPE 착용 판정 - 실시간(new_detection)과 로그 동기화(REST /api/detections) 공용
+// 헬멧/조끼 수가 인원보다 적을 때만 미착용 (인원 0명이거나 모두 착용이면 Compliant)
+enum class PpeResult : quint8 {
+    Compliant = 0,
+    HelmetMissing = 1,  // 비트 0 = 헬멧 부족
+    VestMissing = 2,    // 비트 1 = 조끼 부족
+    BothMissing = 3
+};
+
+// 판정 결과별 건수 (카메라별 집계 단위)
+struct PpeTally {
+    quint32 compliant = 0;
+    quint32 helmetMissing = 0;
+    quint32 vestMissing = 0;
+    quint32 bothMissing = 0;
+
+    quint32 violations() const { return helmetMissing + vestMissing + bothMissing; }
+    quint32 total() const { return compliant + violations(); }
+
+    void add(PpeResult result);
+    PpeTally &operator+=(const PpeTally &other);
+};
+
+class PpeClassifier
+{
+public:
+    static PpeResult classify(quint16 person, quint16 helmet, quint16 vest)
+    {
+        return static_cast<PpeResult>(quint8(helmet < person) | quint8(vest < person) << 1);
+    }
+
+    // 열 단위 배열을 한 번 훑어 결과 + 건수를 함께 계산 (분기 없는 루프 - 컴파일러 자동 벡터화 대상)
+    // results는 count개 이상, 동기화 응답 수천 건도 한 번에
+    static PpeTally classify(const quint16 *person, const quint16 *helmet, const quint16 *vest,
+                             qsizetype count, PpeResult *results);
+
+    static LogEvent logEvent(PpeResult result);
+    static bool isViolation(PpeResult result) { return result != PpeResult::Compliant; }
+};
+
+#endif // PPECLASSIFIER_H
@@ -0,0 +1,198 @@
+#include "ruleengine.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+RuleEngine::RuleEngine()
+{
+    setRules(defaultRules());
+}
+
+void RuleEngine::setRules(const QVector<Rule> &rules)
+{
+    ruleList = rules;
+    cameraStates.clear();  // 규칙 포인터/윈도우 크기가 바뀌므로 상태 초기화
+}
+
+const RuleEngine::Rule *RuleEngine::resolveRule(const QString &cameraIp, Event event) const
+{
+    const Rule *fallback = nullptr;
+    for (const Rule &rule : ruleList) {
+        if (rule.event != event)
+            continue;
+        if (rule.cameraIp == cameraIp)
+            return &rule;
+        if (rule.cameraIp.isEmpty() && !fallback)
+            fallback = &rule;
+    }
+    return fallback;
+}
+
+bool RuleEngine::record(const QString &cameraIp, Event event, qint64 nowMs, Escalation *escalation)
+{
+    WindowState &state = cameraStates[cameraIp][static_cast<size_t>(event)];
+    if (!state.resolved) {
+        state.rule = resolveRule(cameraIp, event);
+        state.resolved = true;
+        if (state.rule)
+            state.ring.resize(qMax(1, state.rule->threshold));
+    }
+
+    const Rule *rule = state.rule;
+    if (!rule)
+        return false;  // 이 이벤트는 에스컬레이션 없음
+
+    const int size = static_cast<int>(state.ring.size());
+    state.ring[state.head] = nowMs;
+    state.head = (state.head + 1) % size;
+    state.filled = qMin(state.filled + 1, size);
+
+    if (state.filled < size || nowMs < state.cooldownUntilMs)
+        return false;
+
+    // 링이 가득 차면 head가 가장 오래된 기록 → 윈도우 안에 N회가 들어왔는지 한 번 비교
+    const qint64 oldest = state.ring[state.head];
+    if (rule->windowMs > 0 && nowMs - oldest > rule->windowMs)
+        return false;
+
+    state.filled = 0;  // 발동 후 다시 N회를 모아야 재발동
+    state.cooldownUntilMs = nowMs + rule->cooldownMs;
+    ++firedCount[static_cast<size_t>(event)];
+
+    if (escalation) {
+        escalation->event = event;
+        escalation->cameraIp = cameraIp;
+        escalation->count = size;
+        escalation->windowMs = rule->windowMs;
+    }
+    return true;
+}
+
+QString RuleEngine::eventName(Event event)
+{
+    switch (event) {
+    case Event::Ppe:      return QStringLiteral("ppe");
+    case Event::Trespass: return QStringLiteral("trespass");
+    case Event::Fall:     return QStringLiteral("fall");
+    case Event::Anomaly:  return QStringLiteral("anomaly");
+    case Event::Count:    break;
+    }
+    return QString();
+}
+
+QVector<RuleEngine::Rule> RuleEngine::defaultRules()
+{
+    Rule ppe;
+    ppe.event = Event::Ppe;
+    ppe.threshold = 4;
+    ppe.windowMs = 60 * 1000;
+    ppe.cooldownMs = 30 * 1000;
+
+    Rule fall;
+    fall.event = Event::Fall;
+    fall.threshold = 1;
+    fall.cooldownMs = 10 * 1000;
+
+    Rule trespass;
+    trespass.event = Event::Trespass;
+    trespass.threshold = 3;
+    trespass.windowMs = 30 * 1000;
+    trespass.cooldownMs = 30 * 1000;
+
+    return { ppe, fall, trespass };
+}
+
+QString RuleEngine::filePath()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return QDir(dir).filePath("escalation_rules.json");
+}
+
+QVector<RuleEngine::Rule> RuleEngine::loadRules()
+{
+    QFile file(filePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        // 첫 실행 - 편집할 수 있도록 기본 규칙을 파일로 남김
+        const QVector<Rule> defaults = defaultRules();
+        QJsonArray arr;
+        for (const Rule &rule : defaults) {
+            QJsonObject obj;
+            obj["event"] = eventName(rule.event);
+            obj["count"] = rule.threshold;
+            obj["window_s"] = static_cast<double>(rule.windowMs / 1000);
+            obj["cooldown_s"] = static_cast<double>(rule.cooldownMs / 1000);
+            arr.append(obj);
+        }
+        QJsonObject root;
+        root["rules"] = arr;
+
+        QDir().mkpath(QFileInfo(filePath()).absolutePath());
+        QSaveFile out(filePath());
+        if (out.open(QIODevice::WriteOnly)) {
+            out.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+            out.commit();
+        }
+        return defaults;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject()) {
+        qWarning() << "[RuleEngine] 규칙 파일 파싱 실패 → 기본 규칙 사용:" << file.fileName();
+        return defaultRules();
+    }
+
+    QVector<Rule> rules;
+    const QJsonArray arr = doc["rules"].toArray();
+    for (const QJsonValue &val : arr) {
+        const QJsonObject obj = val.toObject();
+        const QString name = obj["event"].toString();
+
+        Rule rule;
+        bool known = false;
+        for (int i = 0; i < static_cast<int>(Event::Count); ++i) {
+            if (eventName(static_cast<Event>(i)) == name) {
+                rule.event = static_cast<Event>(i);
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            qWarning() << "[RuleEngine] 알 수 없는 이벤트 무시:" << name;
+            continue;
+        }
+
+        rule.threshold = qBound(1, obj["count"].toInt(1), 1000);
+        rule.windowMs = static_cast<qint64>(obj["window_s"].toDouble() * 1000);
+        rule.cooldownMs = static_cast<qint64>(obj["cooldown_s"].toDouble() * 1000);
+        rule.cameraIp = obj["camera"].toString();
+        rules.append(rule);
+    }
+
+    qDebug() << "[RuleEngine] 에스컬레이션 규칙" << rules.size() << "개 로드";
+    return rules;
+}
+
+QString RuleEngine::statsText() const
+{
+    QString text;
+    for (const Rule &rule : ruleList) {
+        text += QString("%1%2: %3초 내 %4회 (재알림 %5초)\n")
+                    .arg(eventName(rule.event))
+                    .arg(rule.cameraIp.isEmpty() ? QString() : QString(" @%1").arg(rule.cameraIp))
+                    .arg(rule.windowMs / 1000)
+                    .arg(rule.threshold)
+                    .arg(rule.cooldownMs / 1000);
+    }
+    for (int i = 0; i < static_cast<int>(Event::Count); ++i) {
+        text += QString("%1 발동: %2회\n").arg(eventName(static_cast<Event>(i))).arg(firedCount[i]);
+    }
+    text += QString("추적 중인 카메라: %1대").arg(cameraStates.size());
+    return text;
+}
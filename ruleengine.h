@@ -0,0 +1,77 @@
+#ifndef RULEENGINE_H
+#define RULEENGINE_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <array>
+
+// 에스컬레이션 규칙 엔진 - 카메라/이벤트별 "T초 내 N회" 슬라이딩 윈도우
+// 최근 N개 시각만 링 버퍼에 보관해 이벤트당 O(1)로 판정
+class RuleEngine
+{
+public:
+    enum class Event : quint8 {
+        Ppe,
+        Trespass,
+        Fall,
+        Anomaly,
+        Count  // 배열 크기용
+    };
+
+    struct Rule {
+        Event event = Event::Ppe;
+        int threshold = 1;        // 윈도우 안의 발생 횟수
+        qint64 windowMs = 0;      // 0 = 기간 제한 없음 (threshold 1이면 즉시)
+        qint64 cooldownMs = 0;    // 발동 후 같은 카메라/이벤트 재발동 억제
+        QString cameraIp;         // 비어 있으면 전체 카메라 기본 규칙
+    };
+
+    struct Escalation {
+        Event event = Event::Ppe;
+        QString cameraIp;
+        int count = 0;
+        qint64 windowMs = 0;
+    };
+
+    RuleEngine();
+
+    // 카메라 전용 규칙이 기본 규칙보다 우선
+    void setRules(const QVector<Rule> &rules);
+    const QVector<Rule> &rules() const { return ruleList; }
+
+    // 이벤트 1건 기록 - 규칙이 발동하면 true와 함께 escalation 채움
+    bool record(const QString &cameraIp, Event event, qint64 nowMs, Escalation *escalation = nullptr);
+    void removeCamera(const QString &cameraIp) { cameraStates.remove(cameraIp); }
+    QStringList cameras() const { return cameraStates.keys(); }
+
+    static QString eventName(Event event);   // 설정 파일 키 ("ppe" 등)
+    static QVector<Rule> defaultRules();
+
+    // 앱 데이터 폴더의 escalation_rules.json (없으면 기본 규칙으로 생성)
+    static QString filePath();
+    static QVector<Rule> loadRules();
+
+    QString statsText() const;  // 진단 창 표시용
+
+private:
+    struct WindowState {
+        const Rule *rule = nullptr;   // 카메라별로 한 번만 결정
+        bool resolved = false;
+        QVector<qint64> ring;         // 최근 threshold개 발생 시각
+        int head = 0;                 // 다음 기록 위치 = 가장 오래된 기록
+        int filled = 0;
+        qint64 cooldownUntilMs = 0;
+    };
+    using CameraState = std::array<WindowState, static_cast<size_t>(Event::Count)>;
+
+    const Rule *resolveRule(const QString &cameraIp, Event event) const;
+
+    QVector<Rule> ruleList;
+    QHash<QString, CameraState> cameraStates;
+    std::array<quint64, static_cast<size_t>(Event::Count)> firedCount {};
+};
+
+#endif // RULEENGINE_H
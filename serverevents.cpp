@@ -0,0 +1,22 @@
+#include "serverevents.h"
+
+bool SchemaStats::add(const DecodeReport &report)
+{
+    ++decoded;
+    if (report.ok())
+        return false;
+    ++mismatched;
+    missingFields += report.missing;
+    wrongTypes += report.wrongType;
+    return mismatched == 1;
+}
+
+QString SchemaStats::text() const
+{
+    if (mismatched == 0)
+        return QString("스키마 불일치 없음");
+    return QString("스키마 불일치 %1건 (필드 누락 %2 | 타입 불일치 %3)")
+        .arg(mismatched)
+        .arg(missingFields)
+        .arg(wrongTypes);
+}
@@ -0,0 +1,203 @@
+#ifndef SERVEREVENTS_H
+#define SERVEREVENTS_H
+
+#include "eventframe.h"
+
+#include <QString>
+#include <QtAlgorithms>
+
+#include <climits>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+// 카메라 서버 메시지의 타입별 구조체 + 스키마 (필드 이름/타입/필수 여부는 아래 EventSchema 한 곳에만)
+// 문자열 필드는 수신 프레임을 가리키는 뷰 (핸들러 호출 동안만 유효) - 남길 값만 핸들러에서 복사
+
+struct DetectionEvent {      // new_detection, REST /api/detections 원소
+    int personCount = 0;
+    int helmetCount = 0;
+    int vestCount = 0;
+    double confidence = 0.0;
+    std::string_view imagePath;
+    std::string_view timestamp;
+};
+
+struct CountEvent {          // new_trespass / new_blur / new_fall
+    int count = 0;
+    std::string_view timestamp;
+};
+
+struct AnomalyEvent {        // anomaly_status
+    std::string_view status; // "detected" / "cleared"
+    std::string_view timestamp;
+};
+
+struct StmStatusEvent {      // stm_status_update
+    double temperature = 0.0;
+    int light = 0;
+    bool buzzerOn = false;
+    bool ledOn = false;
+};
+
+struct ModeAckEvent {        // mode_change_ack (data 없이 최상위 필드)
+    std::string_view status;
+    std::string_view mode;
+    std::string_view message;
+};
+
+// ---- 스키마
+
+template <typename Event, typename T>
+struct SchemaField {
+    std::string_view key;
+    T Event::*member;
+    bool required;
+};
+
+template <typename Event, typename T>
+constexpr SchemaField<Event, T> requiredField(std::string_view key, T Event::*member) { return { key, member, true }; }
+template <typename Event, typename T>
+constexpr SchemaField<Event, T> optionalField(std::string_view key, T Event::*member) { return { key, member, false }; }
+
+// 특수화마다 scope(필드가 있는 위치)와 fields(튜플)를 선언
+template <typename Event>
+struct EventSchema;
+
+template <>
+struct EventSchema<DetectionEvent> {
+    static constexpr EventFrame::Scope scope = EventFrame::Scope::Data;
+    static constexpr auto fields = std::make_tuple(
+        requiredField("person_count", &DetectionEvent::personCount),
+        requiredField("helmet_count", &DetectionEvent::helmetCount),
+        requiredField("safety_vest_count", &DetectionEvent::vestCount),
+        requiredField("avg_confidence", &DetectionEvent::confidence),
+        optionalField("image_path", &DetectionEvent::imagePath),
+        requiredField("timestamp", &DetectionEvent::timestamp));
+};
+
+template <>
+struct EventSchema<CountEvent> {
+    static constexpr EventFrame::Scope scope = EventFrame::Scope::Data;
+    static constexpr auto fields = std::make_tuple(
+        requiredField("count", &CountEvent::count),
+        requiredField("timestamp", &CountEvent::timestamp));
+};
+
+template <>
+struct EventSchema<AnomalyEvent> {
+    static constexpr EventFrame::Scope scope = EventFrame::Scope::Data;
+    static constexpr auto fields = std::make_tuple(
+        requiredField("status", &AnomalyEvent::status),
+        optionalField("timestamp", &AnomalyEvent::timestamp));
+};
+
+template <>
+struct EventSchema<StmStatusEvent> {
+    static constexpr EventFrame::Scope scope = EventFrame::Scope::Data;
+    static constexpr auto fields = std::make_tuple(
+        requiredField("temperature", &StmStatusEvent::temperature),
+        requiredField("light", &StmStatusEvent::light),
+        requiredField("buzzer_on", &StmStatusEvent::buzzerOn),
+        requiredField("led_on", &StmStatusEvent::ledOn));
+};
+
+template <>
+struct EventSchema<ModeAckEvent> {
+    static constexpr EventFrame::Scope scope = EventFrame::Scope::Top;
+    static constexpr auto fields = std::make_tuple(
+        requiredField("status", &ModeAckEvent::status),
+        requiredField("mode", &ModeAckEvent::mode),
+        optionalField("message", &ModeAckEvent::message));
+};
+
+// ---- 디코딩 결과 / 집계
+
+struct DecodeReport {
+    quint8 missing = 0;    // 필수 필드 없음 (null 포함)
+    quint8 wrongType = 0;  // 값 종류가 스키마와 다름 - 해당 필드는 기본값 유지
+    bool ok() const { return missing == 0 && wrongType == 0; }
+};
+
+struct SchemaStats {
+    quint64 decoded = 0;
+    quint64 mismatched = 0;     // 불일치가 하나라도 있던 건수
+    quint64 missingFields = 0;
+    quint64 wrongTypes = 0;
+
+    bool add(const DecodeReport &report);  // 이번이 첫 불일치면 true (경고 한 번만 남기는 용도)
+    QString text() const;
+};
+
+namespace SchemaDetail {
+
+inline bool readValue(const EventFrame &frame, const EventFrame::Field &field, int *value)
+{
+    qint64 number = 0;
+    if (!frame.readInteger(field, &number) || number < INT_MIN || number > INT_MAX)
+        return false;
+    *value = static_cast<int>(number);
+    return true;
+}
+
+inline bool readValue(const EventFrame &frame, const EventFrame::Field &field, double *value)
+{
+    return frame.readNumber(field, value);
+}
+
+inline bool readValue(const EventFrame &frame, const EventFrame::Field &field, bool *value)
+{
+    return frame.readBool(field, value);
+}
+
+inline bool readValue(const EventFrame &frame, const EventFrame::Field &field, std::string_view *value)
+{
+    return frame.readString(field, value);
+}
+
+// 키가 스키마 필드와 같으면 값을 채우고 true (null은 없는 것으로 취급)
+template <typename Event, typename T>
+bool match(const EventFrame &frame, const EventFrame::Field &field, const SchemaField<Event, T> &spec, quint32 bit,
+           Event *event, quint32 *seen, DecodeReport *report)
+{
+    if (field.key != spec.key)
+        return false;
+    if (field.kind == EventFrame::Kind::Null)
+        return true;
+    *seen |= bit;
+    if (!readValue(frame, field, &(event->*spec.member)))
+        ++report->wrongType;
+    return true;
+}
+
+template <typename Event, size_t... I>
+Event decode(const EventFrame &frame, EventFrame::Scope scope, DecodeReport *report, std::index_sequence<I...>)
+{
+    constexpr auto &fields = EventSchema<Event>::fields;
+    constexpr quint32 requiredMask = ((std::get<I>(fields).required ? (1u << I) : 0u) | ... | 0u);
+
+    Event event;
+    quint32 seen = 0;
+    // 수신 필드를 한 번 훑으며 스키마 필드와 길이 + 바이트 비교 (펼쳐진 비교열, 첫 일치에서 멈춤)
+    for (const EventFrame::Field &field : frame.fields()) {
+        if (field.scope == scope)
+            (match(frame, field, std::get<I>(fields), 1u << I, &event, &seen, report) || ...);
+    }
+    report->missing = static_cast<quint8>(qPopulationCount(requiredMask & ~seen));
+    return event;
+}
+
+} // namespace SchemaDetail
+
+// 스키마대로 디코딩 - 불일치는 report에 기록 (값은 기본값으로 남지만 호출자가 집계/경고)
+// scope는 스키마 기본값 대신 지정 가능 (REST 응답 배열 원소는 최상위에 필드가 있음)
+template <typename Event>
+Event decodeEvent(const EventFrame &frame, DecodeReport *report, EventFrame::Scope scope = EventSchema<Event>::scope)
+{
+    constexpr size_t count = std::tuple_size_v<std::decay_t<decltype(EventSchema<Event>::fields)>>;
+    static_assert(count <= 32, "스키마 필드는 32개까지 (seen 비트마스크)");
+    *report = DecodeReport();
+    return SchemaDetail::decode<Event>(frame, scope, report, std::make_index_sequence<count>());
+}
+
+#endif // SERVEREVENTS_H
@@ -0,0 +1,82 @@
+#include "startuptimeline.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+namespace {
+
+struct State {
+    QElapsedTimer clock;
+    QVector<StartupTimeline::Milestone> milestones;
+};
+
+State &state()
+{
+    static State instance;
+    return instance;
+}
+
+} // namespace
+
+void StartupTimeline::start()
+{
+    State &s = state();
+    s.clock.start();
+    s.milestones.clear();
+    mark(StartupMilestone::AppStarted);
+}
+
+void StartupTimeline::mark(const QString &name)
+{
+    State &s = state();
+    if (!s.clock.isValid())
+        s.clock.start();
+    for (const Milestone &milestone : std::as_const(s.milestones)) {
+        if (milestone.name == name)
+            return;
+    }
+    s.milestones.append({ name, s.clock.elapsed() });
+    qDebug() << "[시작]" << name << s.milestones.last().ms << "ms";
+}
+
+qint64 StartupTimeline::at(const QString &name)
+{
+    for (const Milestone &milestone : std::as_const(state().milestones)) {
+        if (milestone.name == name)
+            return milestone.ms;
+    }
+    return -1;
+}
+
+const QVector<StartupTimeline::Milestone> &StartupTimeline::milestones()
+{
+    return state().milestones;
+}
+
+QString StartupTimeline::text()
+{
+    // 로그인 기준 주요 구간 (재생 모드 등 로그인이 없으면 앱 시작 기준)
+    const qint64 login = at(StartupMilestone::Login);
+    const qint64 origin = login >= 0 ? login : 0;
+    const QString originName = login >= 0 ? StartupMilestone::Login : StartupMilestone::AppStarted;
+
+    QString text;
+    for (const QString &target : { StartupMilestone::ShellShown, StartupMilestone::FirstFrame,
+                                   StartupMilestone::AllFrames, StartupMilestone::FirstAlert }) {
+        const qint64 ms = at(target);
+        text += QString("%1 → %2: %3\n")
+                    .arg(originName, target)
+                    .arg(ms >= 0 ? QString("%1 ms").arg(ms - origin) : QStringLiteral("-"));
+    }
+
+    text += QStringLiteral("\n");
+    qint64 previous = 0;
+    for (const Milestone &milestone : milestones()) {
+        text += QString("%1  %2 ms (+%3)\n")
+                    .arg(milestone.name, -12)
+                    .arg(milestone.ms, 7)
+                    .arg(milestone.ms - previous);
+        previous = milestone.ms;
+    }
+    return text.trimmed();
+}
@@ -0,0 +1,38 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QString>
+#include <QVector>
+
+// 시작 타임라인 - 앱 시작부터 주요 시점(로그인, 셸 표시, 첫 연결/동기화/프레임/알림)을 한 번씩 기록
+// GUI 스레드 전용, 진단 창 "시작 타임라인" 섹션에 표시
+class StartupTimeline
+{
+public:
+    struct Milestone {
+        QString name;
+        qint64 ms = 0;  // start() 이후 경과
+    };
+
+    static void start();                     // main()에서 한 번 (기준 시각)
+    static void mark(const QString &name);   // 같은 이름은 처음 한 번만 기록
+    static qint64 at(const QString &name);   // 기록 안 됐으면 -1
+    static const QVector<Milestone> &milestones();
+    static QString text();
+};
+
+// 기록 지점 이름 (로그인 기준 구간 계산에 사용)
+namespace StartupMilestone {
+inline const QString AppStarted = QStringLiteral("앱 시작");
+inline const QString Login = QStringLiteral("로그인");
+inline const QString ShellShown = QStringLiteral("셸 표시");
+inline const QString GridReady = QStringLiteral("그리드 구성");
+inline const QString FirstConnection = QStringLiteral("첫 카메라 연결");
+inline const QString FirstLogSync = QStringLiteral("첫 로그 동기화");
+inline const QString FirstEvent = QStringLiteral("첫 이벤트");
+inline const QString FirstFrame = QStringLiteral("첫 프레임");
+inline const QString AllFrames = QStringLiteral("전체 첫 프레임");
+inline const QString FirstAlert = QStringLiteral("첫 알림");
+}
+
+#endif // STARTUPTIMELINE_H
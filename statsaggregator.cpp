@@ -0,0 +1,129 @@
+#include "statsaggregator.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr qint64 MinuteMs = 60 * 1000;
+constexpr qint64 HourMs = 60 * MinuteMs;
+
+bool isViolation(LogEvent event)
+{
+    return event == LogEvent::HelmetMissing || event == LogEvent::VestMissing || event == LogEvent::PpeMissing;
+}
+
+} // namespace
+
+StatsAggregator::Counters &StatsAggregator::Counters::operator+=(const Counters &other)
+{
+    ppeDetections += other.ppeDetections;
+    ppeViolations += other.ppeViolations;
+    falls += other.falls;
+    trespass += other.trespass;
+    anomalies += other.anomalies;
+    anomalyMs += other.anomalyMs;
+    confidenceSum += other.confidenceSum;
+    confidenceCount += other.confidenceCount;
+    for (int i = 0; i < FunctionCount; ++i)
+        functions[i] += other.functions[i];
+    return *this;
+}
+
+template <size_t N>
+StatsAggregator::Counters *StatsAggregator::bucketFor(std::array<Bucket, N> &ring, qint64 index)
+{
+    Bucket &bucket = ring[size_t(index % qint64(N))];
+    if (bucket.index > index)
+        return nullptr;  // 링보다 오래된 로그 - 더 최근 구간을 덮어쓰지 않음
+    if (bucket.index != index) {
+        bucket.index = index;
+        bucket.counters = Counters();
+    }
+    return &bucket.counters;
+}
+
+template <size_t N>
+StatsAggregator::Counters StatsAggregator::sumRing(const std::array<Bucket, N> &ring, qint64 nowIndex)
+{
+    Counters sum;
+    for (const Bucket &bucket : ring) {
+        if (bucket.index > nowIndex - qint64(N) && bucket.index <= nowIndex)
+            sum += bucket.counters;
+    }
+    return sum;
+}
+
+void StatsAggregator::record(const LogEntry &entry)
+{
+    if (entry.timestampMs <= 0)
+        return;
+    ++recorded;
+
+    CameraStats &stats = cameras[entry.cameraId];
+    ++stats.total;
+
+    // 이 로그가 더할 값
+    Counters delta;
+    delta.functions[qBound(0, int(entry.function), FunctionCount - 1)] = 1;
+    switch (entry.event) {
+    case LogEvent::HelmetMissing:
+    case LogEvent::VestMissing:
+    case LogEvent::PpeMissing:
+    case LogEvent::PpeCompliant:
+        delta.ppeDetections = 1;
+        delta.ppeViolations = isViolation(entry.event) ? 1 : 0;
+        if (entry.confidence > 0.0f) {
+            delta.confidenceSum = entry.confidence;
+            delta.confidenceCount = 1;
+        }
+        break;
+    case LogEvent::Fall:
+        delta.falls = 1;
+        break;
+    case LogEvent::Trespass:
+        delta.trespass = 1;
+        break;
+    case LogEvent::AnomalyDetected:
+        if (stats.anomalyStartMs == 0) {
+            stats.anomalyStartMs = entry.timestampMs;
+            delta.anomalies = 1;
+        }
+        break;
+    case LogEvent::AnomalyCleared:
+        if (stats.anomalyStartMs > 0) {
+            delta.anomalyMs = quint64(qMax<qint64>(0, entry.timestampMs - stats.anomalyStartMs));
+            stats.anomalyStartMs = 0;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (Counters *minute = bucketFor(stats.minutes, entry.timestampMs / MinuteMs))
+        *minute += delta;
+    if (Counters *hour = bucketFor(stats.hours, entry.timestampMs / HourMs))
+        *hour += delta;
+}
+
+QVector<StatsAggregator::Summary> StatsAggregator::summaries(qint64 nowMs) const
+{
+    QVector<Summary> result;
+    result.reserve(cameras.size());
+    for (auto it = cameras.cbegin(); it != cameras.cend(); ++it) {
+        const CameraStats &stats = it.value();
+        Summary summary;
+        summary.cameraId = it.key();
+        summary.lastHour = sumRing(stats.minutes, nowMs / MinuteMs);
+        summary.lastDay = sumRing(stats.hours, nowMs / HourMs);
+        summary.total = stats.total;
+        summary.anomalySinceMs = stats.anomalyStartMs;
+        result.append(summary);
+    }
+    std::sort(result.begin(), result.end(), [](const Summary &a, const Summary &b) { return a.cameraId < b.cameraId; });
+    return result;
+}
+
+qint64 StatsAggregator::memoryUsage() const
+{
+    return qint64(cameras.size()) * qint64(sizeof(CameraStats) + sizeof(quint16));
+}
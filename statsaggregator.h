@@ -0,0 +1,75 @@
+#ifndef STATSAGGREGATOR_H
+#define STATSAGGREGATOR_H
+
+#include "logentry.h"
+
+#include <QHash>
+#include <QVector>
+
+#include <array>
+
+// 카메라별 통계 - 로그 1건이 들어올 때 O(1)로 분/시간 버킷에 누적 (전체 로그를 다시 훑지 않음)
+// 최근 60분은 분 버킷 60개, 최근 24시간은 시간 버킷 24개 링 - 슬롯의 구간 번호가 바뀌면 그 자리에서 초기화
+// 버킷 시각은 LogEntry::timestampMs 기준 (동기화로 들어온 과거 로그도 제 구간에 들어감, 링보다 오래된 건 합계만)
+class StatsAggregator
+{
+public:
+    static constexpr int MinuteBuckets = 60;
+    static constexpr int HourBuckets = 24;
+    static constexpr int FunctionCount = int(LogFunction::Health) + 1;
+
+    struct Counters {
+        quint32 ppeDetections = 0;
+        quint32 ppeViolations = 0;
+        quint32 falls = 0;
+        quint32 trespass = 0;
+        quint32 anomalies = 0;
+        quint64 anomalyMs = 0;     // 해제 시점 구간에 지속 시간 누적
+        double confidenceSum = 0.0;
+        quint32 confidenceCount = 0;
+        std::array<quint32, FunctionCount> functions{};  // LogFunction별 건수
+
+        double meanConfidence() const { return confidenceCount ? confidenceSum / confidenceCount : 0.0; }
+        Counters &operator+=(const Counters &other);
+    };
+
+    struct Summary {
+        quint16 cameraId = 0;
+        Counters lastHour;         // 분 버킷 합
+        Counters lastDay;          // 시간 버킷 합
+        quint64 total = 0;         // 기록 이후 전체 건수
+        qint64 anomalySinceMs = 0; // 이상소음 진행 중이면 시작 시각 (0 = 정상)
+    };
+
+    void record(const LogEntry &entry);
+
+    // 카메라마다 버킷 84개만 합산 (진단/통계 창 갱신 주기에만 호출)
+    QVector<Summary> summaries(qint64 nowMs) const;
+
+    quint64 recordedCount() const { return recorded; }
+    qsizetype cameraCount() const { return cameras.size(); }
+    qint64 memoryUsage() const;
+
+private:
+    struct Bucket {
+        qint64 index = -1;  // 분/시간 구간 번호 (epoch 기준)
+        Counters counters;
+    };
+
+    struct CameraStats {
+        std::array<Bucket, MinuteBuckets> minutes;
+        std::array<Bucket, HourBuckets> hours;
+        quint64 total = 0;
+        qint64 anomalyStartMs = 0;
+    };
+
+    template <size_t N>
+    static Counters *bucketFor(std::array<Bucket, N> &ring, qint64 index);
+    template <size_t N>
+    static Counters sumRing(const std::array<Bucket, N> &ring, qint64 nowIndex);
+
+    QHash<quint16, CameraStats> cameras;  // LogStore 카메라 id
+    quint64 recorded = 0;
+};
+
+#endif // STATSAGGREGATOR_H
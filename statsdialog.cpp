@@ -0,0 +1,152 @@
+#include "statsdialog.h"
+#include "logstore.h"
+#include "statsaggregator.h"
+
+#include <QDateTime>
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+namespace {
+
+QString durationText(quint64 ms)
+{
+    const quint64 seconds = ms / 1000;
+    if (seconds < 60)
+        return QString("%1초").arg(seconds);
+    if (seconds < 3600)
+        return QString("%1분 %2초").arg(seconds / 60).arg(seconds % 60);
+    return QString("%1시간 %2분").arg(seconds / 3600).arg((seconds % 3600) / 60);
+}
+
+QTableWidget *makeTable(const QStringList &headers)
+{
+    QTableWidget *table = new QTableWidget(0, headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionMode(QAbstractItemView::NoSelection);
+    table->setAlternatingRowColors(true);
+    return table;
+}
+
+void setCell(QTableWidget *table, int row, int column, const QString &text)
+{
+    QTableWidgetItem *item = table->item(row, column);
+    if (!item) {
+        item = new QTableWidgetItem();
+        table->setItem(row, column, item);
+    }
+    item->setText(text);
+}
+
+} // namespace
+
+StatsDialog::StatsDialog(const StatsAggregator *stats, const LogStore *logStore, QWidget *parent)
+    : QDialog(parent), stats(stats), logStore(logStore)
+{
+    setWindowTitle("통계");
+    setMinimumSize(760, 480);
+    setModal(false);
+
+    QLabel *cameraTitle = new QLabel("카메라별 (최근 1시간 / 24시간)");
+    cameraTitle->setStyleSheet("font-weight: bold; color: orange;");
+    cameraTable = makeTable({ "카메라", "위반/1시간", "위반/24시간", "시간당 위반 (24h 평균)",
+                              "낙상 (24h)", "침입 (24h)", "평균 신뢰도 (24h)", "이상소음 (24h)" });
+
+    QLabel *functionTitle = new QLabel("기능별 로그 건수 (전체 카메라)");
+    functionTitle->setStyleSheet("font-weight: bold; color: orange;");
+    functionTable = makeTable({ "기능", "최근 1시간", "최근 24시간" });
+    functionTable->setRowCount(StatsAggregator::FunctionCount);
+    for (int i = 0; i < StatsAggregator::FunctionCount; ++i)
+        setCell(functionTable, i, 0, LogStore::functionText(static_cast<LogFunction>(i)));
+    functionTable->setFixedHeight(210);
+
+    summaryLabel = new QLabel();
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(cameraTitle);
+    layout->addWidget(cameraTable, 1);
+    layout->addWidget(functionTitle);
+    layout->addWidget(functionTable);
+    layout->addWidget(summaryLabel);
+
+    setStyleSheet(R"(
+        QDialog { background-color: #2b2b2b; color: white; }
+        QLabel { color: white; }
+        QTableWidget {
+            background-color: #404040;
+            alternate-background-color: #4a4a4a;
+            color: white;
+            gridline-color: #555;
+            border: 1px solid #555;
+        }
+        QHeaderView::section {
+            background-color: #555;
+            color: white;
+            padding: 4px;
+            border: 1px solid #666;
+        }
+    )");
+
+    refreshTimer.setInterval(5000);
+    connect(&refreshTimer, &QTimer::timeout, this, &StatsDialog::refresh);
+}
+
+void StatsDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    refresh();
+    refreshTimer.start();
+}
+
+void StatsDialog::hideEvent(QHideEvent *event)
+{
+    refreshTimer.stop();
+    QDialog::hideEvent(event);
+}
+
+void StatsDialog::refresh()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const QVector<StatsAggregator::Summary> summaries = stats->summaries(now);
+
+    StatsAggregator::Counters hourTotal;
+    StatsAggregator::Counters dayTotal;
+
+    cameraTable->setRowCount(summaries.size());
+    for (int row = 0; row < summaries.size(); ++row) {
+        const StatsAggregator::Summary &summary = summaries.at(row);
+        hourTotal += summary.lastHour;
+        dayTotal += summary.lastDay;
+
+        // 진행 중인 이상소음은 지금까지의 시간도 포함
+        quint64 anomalyMs = summary.lastDay.anomalyMs;
+        if (summary.anomalySinceMs > 0)
+            anomalyMs += quint64(qMax<qint64>(0, now - summary.anomalySinceMs));
+        QString anomalyText = QString("%1회 | %2").arg(summary.lastDay.anomalies).arg(durationText(anomalyMs));
+        if (summary.anomalySinceMs > 0)
+            anomalyText += QStringLiteral(" (진행 중)");
+
+        const StatsAggregator::Counters &day = summary.lastDay;
+        setCell(cameraTable, row, 0, logStore->cameraName(summary.cameraId));
+        setCell(cameraTable, row, 1, QString::number(summary.lastHour.ppeViolations));
+        setCell(cameraTable, row, 2, QString::number(day.ppeViolations));
+        setCell(cameraTable, row, 3, QString::number(day.ppeViolations / double(StatsAggregator::HourBuckets), 'f', 1));
+        setCell(cameraTable, row, 4, QString::number(day.falls));
+        setCell(cameraTable, row, 5, QString::number(day.trespass));
+        setCell(cameraTable, row, 6, day.confidenceCount ? QString::number(day.meanConfidence(), 'f', 2) : QStringLiteral("-"));
+        setCell(cameraTable, row, 7, anomalyText);
+    }
+
+    for (int i = 0; i < StatsAggregator::FunctionCount; ++i) {
+        setCell(functionTable, i, 1, QString::number(hourTotal.functions[i]));
+        setCell(functionTable, i, 2, QString::number(dayTotal.functions[i]));
+    }
+
+    summaryLabel->setText(QString("집계 %1건 | 카메라 %2대 | 갱신 %3")
+                              .arg(stats->recordedCount())
+                              .arg(stats->cameraCount())
+                              .arg(QDateTime::fromMSecsSinceEpoch(now).toString("HH:mm:ss")));
+}
@@ -0,0 +1,36 @@
+#ifndef STATSDIALOG_H
+#define STATSDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QTableWidget>
+#include <QTimer>
+
+class LogStore;
+class StatsAggregator;
+
+// 카메라별 통계 창 - StatsAggregator 버킷 합계만 표시 (로그를 다시 훑지 않음), 열려 있는 동안 5초마다 갱신
+class StatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    StatsDialog(const StatsAggregator *stats, const LogStore *logStore, QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void refresh();
+
+    const StatsAggregator *stats;
+    const LogStore *logStore;
+
+    QTableWidget *cameraTable;
+    QTableWidget *functionTable;
+    QLabel *summaryLabel;
+    QTimer refreshTimer;
+};
+
+#endif // STATSDIALOG_H
@@ -0,0 +1,165 @@
+#include "streamhealthmonitor.h"
+
+#include <QDateTime>
+#include <QDebug>
+
+#include <cmath>
+
+StreamHealthMonitor::StreamHealthMonitor(QObject *parent)
+    : QObject(parent)
+{
+    checkTimer.setInterval(CheckIntervalMs);
+    connect(&checkTimer, &QTimer::timeout, this, &StreamHealthMonitor::check);
+    checkTimer.start();
+}
+
+void StreamHealthMonitor::watch(const QString &id)
+{
+    Stream &stream = streams[id];
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (stream.state == State::Stalled)
+        return;  // 재시작으로 다시 바인딩된 경우 - 복구 판정은 프레임 도착 시
+
+    stream.state = State::Starting;
+    stream.watchedMs = nowMs;
+    stream.intervalCount = 0;
+    stream.intervalNext = 0;
+}
+
+void StreamHealthMonitor::unwatch(const QString &id)
+{
+    streams.remove(id);
+}
+
+void StreamHealthMonitor::frameArrived(const QString &id)
+{
+    auto it = streams.find(id);
+    if (it == streams.end())
+        return;
+
+    Stream &stream = it.value();
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    if (stream.lastFrameMs > 0 && stream.state == State::Live) {
+        stream.intervals[stream.intervalNext] = quint16(qMin<qint64>(nowMs - stream.lastFrameMs, 0xFFFF));
+        stream.intervalNext = (stream.intervalNext + 1) % IntervalWindow;
+        stream.intervalCount = qMin(stream.intervalCount + 1, IntervalWindow);
+    }
+    stream.lastFrameMs = nowMs;
+
+    if (stream.state == State::Stalled) {
+        const qint64 downtime = nowMs - stream.stalledSinceMs;
+        const int restarts = stream.restarts;
+        stream.state = State::Live;
+        stream.restarts = 0;
+        stream.backoffMs = MinBackoffMs;
+        qDebug() << "[StreamHealth] 복구:" << id << downtime << "ms, 재시작" << restarts << "회";
+        emit recovered(id, downtime, restarts);
+    } else {
+        stream.state = State::Live;
+    }
+}
+
+void StreamHealthMonitor::reportError(const QString &id, const QString &error)
+{
+    auto it = streams.find(id);
+    if (it == streams.end() || it->state == State::Stalled)
+        return;
+    markStalled(id, it.value(), QDateTime::currentMSecsSinceEpoch(), error);
+}
+
+void StreamHealthMonitor::markStalled(const QString &id, Stream &stream, qint64 nowMs, const QString &reason)
+{
+    stream.state = State::Stalled;
+    stream.stalledSinceMs = nowMs;
+    stream.nextRestartMs = nowMs;  // 첫 재시작은 즉시
+    stream.backoffMs = MinBackoffMs;
+    stream.restarts = 0;
+
+    const qint64 silence = stream.lastFrameMs > 0 ? nowMs - stream.lastFrameMs : nowMs - stream.watchedMs;
+    qWarning() << "[StreamHealth] 멈춤:" << id << reason << silence << "ms";
+    emit stalled(id, silence, reason);
+}
+
+void StreamHealthMonitor::check()
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QStringList restart;
+
+    for (auto it = streams.begin(); it != streams.end(); ++it) {
+        Stream &stream = it.value();
+        switch (stream.state) {
+        case State::Starting:
+            if (nowMs - stream.watchedMs > StartGraceMs)
+                markStalled(it.key(), stream, nowMs, "첫 프레임 없음");
+            break;
+        case State::Live:
+            if (nowMs - stream.lastFrameMs > FreezeMs)
+                markStalled(it.key(), stream, nowMs, "프레임 멈춤");
+            break;
+        case State::Stalled:
+            break;
+        }
+
+        // 멈춘 스트림은 백오프 간격으로 해당 플레이어만 재시작
+        if (stream.state == State::Stalled && nowMs >= stream.nextRestartMs) {
+            ++stream.restarts;
+            ++stream.totalRestarts;
+            stream.nextRestartMs = nowMs + stream.backoffMs;
+            stream.backoffMs = qMin(stream.backoffMs * 2, MaxBackoffMs);
+            restart.append(it.key());
+        }
+    }
+
+    // 재시작 처리 중 watch/unwatch가 호출될 수 있어 순회 후 알림
+    for (const QString &id : std::as_const(restart))
+        emit restartRequested(id);
+}
+
+StreamHealthMonitor::Snapshot StreamHealthMonitor::snapshotOf(const QString &id, const Stream &stream, qint64 nowMs) const
+{
+    Snapshot snapshot;
+    snapshot.id = id;
+    snapshot.state = stream.state;
+    snapshot.restarts = stream.totalRestarts;
+    snapshot.silenceMs = stream.lastFrameMs > 0 ? nowMs - stream.lastFrameMs : nowMs - stream.watchedMs;
+
+    if (stream.intervalCount > 0) {
+        double sum = 0.0;
+        for (int i = 0; i < stream.intervalCount; ++i)
+            sum += stream.intervals[i];
+        const double mean = sum / stream.intervalCount;
+        double variance = 0.0;
+        for (int i = 0; i < stream.intervalCount; ++i)
+            variance += (stream.intervals[i] - mean) * (stream.intervals[i] - mean);
+        snapshot.fps = mean > 0.0 ? 1000.0 / mean : 0.0;
+        snapshot.jitterMs = std::sqrt(variance / stream.intervalCount);
+    }
+    return snapshot;
+}
+
+QVector<StreamHealthMonitor::Snapshot> StreamHealthMonitor::snapshots() const
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QVector<Snapshot> result;
+    result.reserve(streams.size());
+    for (auto it = streams.constBegin(); it != streams.constEnd(); ++it)
+        result.append(snapshotOf(it.key(), it.value(), nowMs));
+    return result;
+}
+
+QString StreamHealthMonitor::statsText() const
+{
+    QString text;
+    for (const Snapshot &snapshot : snapshots()) {
+        const char *state = snapshot.state == State::Live ? "정상"
+                          : snapshot.state == State::Starting ? "연결 중" : "멈춤";
+        text += QString("%1: %2 | %3 fps | 지터 %4 ms | 마지막 프레임 %5 ms 전 | 재시작 %6회\n")
+                    .arg(snapshot.id, QString::fromUtf8(state))
+                    .arg(snapshot.fps, 0, 'f', 1)
+                    .arg(snapshot.jitterMs, 0, 'f', 1)
+                    .arg(snapshot.silenceMs)
+                    .arg(snapshot.restarts);
+    }
+    return text.isEmpty() ? QString("감시 중인 스트림 없음") : text.trimmed();
+}
@@ -0,0 +1,75 @@
+#ifndef STREAMHEALTHMONITOR_H
+#define STREAMHEALTHMONITOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <array>
+
+// 라이브 스트림별 프레임 도착 감시 - fps / 지터 측정, 멈춤 감지, 해당 스트림만 재시작 요청
+// 재시작은 restartRequested를 받은 쪽이 수행 (그리드 타일 / ONVIF 뷰)
+class StreamHealthMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class State { Starting, Live, Stalled };
+
+    struct Snapshot {
+        QString id;
+        State state = State::Starting;
+        double fps = 0.0;
+        double jitterMs = 0.0;      // 프레임 간격 표준편차
+        qint64 silenceMs = 0;       // 마지막 프레임 이후 경과
+        int restarts = 0;
+    };
+
+    explicit StreamHealthMonitor(QObject *parent = nullptr);
+
+    void watch(const QString &id);     // 재생 시작 (StartGraceMs 동안 첫 프레임 대기)
+    void unwatch(const QString &id);
+    void frameArrived(const QString &id);
+    void reportError(const QString &id, const QString &error);  // QMediaPlayer 오류 - 즉시 멈춤 처리
+
+    QVector<Snapshot> snapshots() const;
+    QString statsText() const;  // 진단 창 표시용
+
+    static constexpr int CheckIntervalMs = 1000;
+    static constexpr qint64 StartGraceMs = 10000;     // RTSPS 연결 + 첫 키프레임 대기
+    static constexpr qint64 FreezeMs = 4000;          // 이 시간 동안 프레임 없으면 멈춤
+    static constexpr qint64 MinBackoffMs = 2000;
+    static constexpr qint64 MaxBackoffMs = 60000;
+    static constexpr int IntervalWindow = 32;         // fps/지터 계산 구간 (프레임 수)
+
+signals:
+    void stalled(const QString &id, qint64 silenceMs, const QString &reason);
+    void recovered(const QString &id, qint64 downtimeMs, int restarts);
+    void restartRequested(const QString &id);
+
+private:
+    struct Stream {
+        State state = State::Starting;
+        qint64 watchedMs = 0;
+        qint64 lastFrameMs = 0;
+        qint64 stalledSinceMs = 0;
+        qint64 nextRestartMs = 0;
+        qint64 backoffMs = MinBackoffMs;
+        int restarts = 0;             // 이번 멈춤 동안 재시작 횟수
+        int totalRestarts = 0;
+        std::array<quint16, IntervalWindow> intervals{};  // 최근 프레임 간격 (ms, 링 버퍼)
+        int intervalCount = 0;
+        int intervalNext = 0;
+    };
+
+    void check();
+    void markStalled(const QString &id, Stream &stream, qint64 nowMs, const QString &reason);
+    Snapshot snapshotOf(const QString &id, const Stream &stream, qint64 nowMs) const;
+
+    QHash<QString, Stream> streams;
+    QTimer checkTimer;
+};
+
+#endif // STREAMHEALTHMONITOR_H
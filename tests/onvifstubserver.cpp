@@ -0,0 +1,123 @@
+#include "onvifstubserver.h"
+
+#include <QHostAddress>
+#include <QRegularExpression>
+
+namespace {
+
+QByteArray envelope(const QByteArray &body)
+{
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+           "<s:Envelope xmlns:s=\"http://www.w3.org/2003/05/soap-envelope\""
+           " xmlns:tds=\"http://www.onvif.org/ver10/device/wsdl\""
+           " xmlns:trt=\"http://www.onvif.org/ver10/media/wsdl\""
+           " xmlns:tt=\"http://www.onvif.org/ver10/schema\">"
+           "<s:Body>" + body + "</s:Body></s:Envelope>";
+}
+
+QByteArray profileXml(const char *token, const char *name, int width, int height)
+{
+    return QByteArray("<trt:Profiles token=\"") + token + "\" fixed=\"true\">"
+           "<tt:Name>" + name + "</tt:Name>"
+           "<tt:VideoEncoderConfiguration token=\"enc_" + token + "\">"
+           "<tt:Name>H264</tt:Name><tt:Encoding>H264</tt:Encoding>"
+           "<tt:Resolution><tt:Width>" + QByteArray::number(width) + "</tt:Width>"
+           "<tt:Height>" + QByteArray::number(height) + "</tt:Height></tt:Resolution>"
+           "</tt:VideoEncoderConfiguration></trt:Profiles>";
+}
+
+} // namespace
+
+OnvifStubServer::OnvifStubServer(QObject *parent)
+    : QObject(parent)
+{
+    connect(&server, &QTcpServer::newConnection, this, &OnvifStubServer::onNewConnection);
+}
+
+bool OnvifStubServer::listen()
+{
+    return server.listen(QHostAddress::LocalHost, 0);
+}
+
+void OnvifStubServer::onNewConnection()
+{
+    while (QTcpSocket *socket = server.nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void OnvifStubServer::onReadyRead(QTcpSocket *socket)
+{
+    QByteArray request = buffers.value(socket) + socket->readAll();
+
+    // 헤더 + Content-Length만큼 본문이 모이면 응답 (요청마다 연결 종료)
+    const qsizetype headerEnd = request.indexOf("\r\n\r\n");
+    qsizetype contentLength = 0;
+    if (headerEnd >= 0) {
+        for (const QByteArray &line : request.left(headerEnd).split('\n')) {
+            const QByteArray header = line.trimmed().toLower();
+            if (header.startsWith("content-length:"))
+                contentLength = header.mid(15).trimmed().toLongLong();
+        }
+    }
+    if (headerEnd < 0 || request.size() < headerEnd + 4 + contentLength) {
+        buffers.insert(socket, request);
+        return;
+    }
+    buffers.remove(socket);
+
+    const QByteArray body = request.mid(headerEnd + 4, contentLength);
+    bodies.append(body);
+
+    int status = 200;
+    const QByteArray xml = responseBody(body, &status);
+
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + (status == 200 ? " OK" : " Internal Server Error");
+    response += "\r\nContent-Type: application/soap+xml; charset=utf-8\r\nContent-Length: ";
+    response += QByteArray::number(xml.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += xml;
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+QByteArray OnvifStubServer::responseBody(const QByteArray &request, int *status) const
+{
+    const QByteArray faultXml = envelope("<s:Fault><s:Code><s:Value>s:Receiver</s:Value></s:Code>"
+                                         "<s:Reason><s:Text xml:lang=\"en\">stub fault</s:Text></s:Reason></s:Fault>");
+    if (fault) {
+        *status = 500;
+        return faultXml;
+    }
+
+    if (request.contains("GetCapabilities")) {
+        const QByteArray mediaUrl = "http://127.0.0.1:" + QByteArray::number(port()) + "/onvif/media_service";
+        return envelope("<tds:GetCapabilitiesResponse><tds:Capabilities>"
+                        "<tt:Media><tt:XAddr>" + mediaUrl + "</tt:XAddr></tt:Media>"
+                        "</tds:Capabilities></tds:GetCapabilitiesResponse>");
+    }
+
+    if (request.contains("GetStreamUri")) {
+        static const QRegularExpression tokenPattern("<trt:ProfileToken>([^<]*)</trt:ProfileToken>");
+        const QByteArray token = tokenPattern.match(QString::fromUtf8(request)).captured(1).toUtf8();
+        return envelope("<trt:GetStreamUriResponse><trt:MediaUri>"
+                        "<tt:Uri>rtsp://127.0.0.1:8554/" + token + "</tt:Uri>"
+                        "<tt:InvalidAfterConnect>false</tt:InvalidAfterConnect>"
+                        "</trt:MediaUri></trt:GetStreamUriResponse>");
+    }
+
+    if (request.contains("GetProfiles")) {
+        return envelope("<trt:GetProfilesResponse>"
+                        + profileXml("main", "MainStream", 1920, 1080)
+                        + profileXml("sub", "SubStream", 640, 360)
+                        + profileXml("mid", "MidStream", 1280, 720)
+                        + "</trt:GetProfilesResponse>");
+    }
+
+    *status = 500;
+    return faultXml;
+}
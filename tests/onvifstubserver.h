@@ -0,0 +1,40 @@
+#ifndef ONVIFSTUBSERVER_H
+#define ONVIFSTUBSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+// ONVIF 디바이스/미디어 서비스 스텁 - GetCapabilities / GetProfiles / GetStreamUri에 고정 응답
+// 프로파일은 일부러 해상도 순서가 섞여 있음 (main 1920x1080, sub 640x360, mid 1280x720)
+// 받은 SOAP 본문은 모두 보관 (WS-Security 헤더 확인용), fault 모드에서는 HTTP 500 + SOAP Fault
+class OnvifStubServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OnvifStubServer(QObject *parent = nullptr);
+
+    bool listen();  // 127.0.0.1 임의 포트
+    quint16 port() const { return server.serverPort(); }
+
+    void setFault(bool enabled) { fault = enabled; }
+    int requestCount() const { return static_cast<int>(bodies.size()); }
+    QList<QByteArray> requests() const { return bodies; }
+    void clearRequests() { bodies.clear(); }
+
+private:
+    void onNewConnection();
+    void onReadyRead(QTcpSocket *socket);
+    QByteArray responseBody(const QByteArray &request, int *status) const;
+
+    QTcpServer server;
+    QHash<QTcpSocket*, QByteArray> buffers;  // 연결별 수신 중인 요청
+    QList<QByteArray> bodies;
+    bool fault = false;
+};
+
+#endif // ONVIFSTUBSERVER_H
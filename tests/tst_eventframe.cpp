@@ -0,0 +1,157 @@
+#include "eventframe.h"
+
+#include <QtTest>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+// EventFrame - 최상위 / data 한 단계 토큰화, 이스케이프 풀기, 배열 원소 순회, type 미리 보기
+class TestEventFrame : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tokenizesTopAndData();
+    void keepsDeeperValuesRaw();
+    void unescapesOnlyEscapedStrings();
+    void readsTypedValues();
+    void rejectsMalformed();
+    void iteratesArrayElements();
+    void peeksType();
+};
+
+namespace {
+
+QString str(std::string_view view)
+{
+    return EventFrame::toQString(view);
+}
+
+} // namespace
+
+void TestEventFrame::tokenizesTopAndData()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    const std::string_view json = R"( {"type":"new_detection","data":{"person_count":3,"timestamp":"2025-01-02 03:04:05"},"id":7} )";
+    QVERIFY(frame.parse(json));
+
+    QCOMPARE(str(frame.type()), QString("new_detection"));
+    QCOMPARE(frame.integer("id"), qint64(7));
+    QCOMPARE(frame.integer("person_count", EventFrame::Scope::Data), qint64(3));
+    QCOMPARE(str(frame.text("timestamp", EventFrame::Scope::Data)), QString("2025-01-02 03:04:05"));
+
+    // data 안의 필드는 최상위로 찾으면 없음, data 자체는 원문 범위
+    QVERIFY(frame.find("person_count") == nullptr);
+    const EventFrame::Field *data = frame.find("data");
+    QVERIFY(data != nullptr);
+    QCOMPARE(data->kind, EventFrame::Kind::Object);
+    QCOMPARE(str(data->value), QString(R"({"person_count":3,"timestamp":"2025-01-02 03:04:05"})"));
+
+    // 문자열 뷰는 원본 버퍼를 가리킴 (이스케이프 없음 - 복사 없음)
+    const std::string_view type = frame.type();
+    QVERIFY(type.data() >= json.data() && type.data() + type.size() <= json.data() + json.size());
+}
+
+void TestEventFrame::keepsDeeperValuesRaw()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(frame.parse(R"({"data":{"boxes":[{"x":1,"label":"a}]"}],"meta":{"k":"v"}},"list":[1,[2,3]]})"));
+
+    // 더 깊은 값은 필드로 풀지 않고 괄호 포함 원문만 (문자열 안의 괄호는 무시)
+    const EventFrame::Field *boxes = frame.find("boxes", EventFrame::Scope::Data);
+    QVERIFY(boxes != nullptr);
+    QCOMPARE(boxes->kind, EventFrame::Kind::Array);
+    QCOMPARE(str(boxes->value), QString(R"([{"x":1,"label":"a}]"}])"));
+    QVERIFY(frame.find("x", EventFrame::Scope::Data) == nullptr);
+
+    const EventFrame::Field *meta = frame.find("meta", EventFrame::Scope::Data);
+    QVERIFY(meta != nullptr);
+    QCOMPARE(meta->kind, EventFrame::Kind::Object);
+    QCOMPARE(str(frame.find("list")->value), QString("[1,[2,3]]"));
+    QCOMPARE(frame.fields().size(), size_t(4));  // data, boxes, meta, list
+}
+
+void TestEventFrame::unescapesOnlyEscapedStrings()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(frame.parse(R"({"plain":"abc","quote":"say \"hi\"\n","path":"C:\\img\/1.jpg","name":"\uCE74\uBA54\uB77C","emoji":"\uD83D\uDE00"})"));
+
+    QVERIFY(!frame.find("plain")->escaped);
+    QVERIFY(frame.find("quote")->escaped);
+    QCOMPARE(str(frame.text("plain")), QString("abc"));
+    QCOMPARE(str(frame.text("quote")), QString("say \"hi\"\n"));
+    QCOMPARE(str(frame.text("path")), QString("C:\\img/1.jpg"));
+    QCOMPARE(str(frame.text("name")), QString::fromUtf8("카메라"));
+    QCOMPARE(str(frame.text("emoji")), QString::fromUtf8("\xF0\x9F\x98\x80"));  // 서로게이트 쌍 → 4바이트 UTF-8
+}
+
+void TestEventFrame::readsTypedValues()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(frame.parse(R"({"i":-12,"f":36.5,"whole":3.0,"frac":2.5,"t":true,"n":null,"s":"1"})"));
+
+    QCOMPARE(frame.integer("i"), qint64(-12));
+    QCOMPARE(frame.number("f"), 36.5);
+    QCOMPARE(frame.integer("whole"), qint64(3));  // 정수값인 실수 표기는 허용
+    QVERIFY(frame.boolean("t"));
+    QCOMPARE(frame.find("n")->kind, EventFrame::Kind::Null);
+
+    // 종류가 맞지 않으면 read*는 false (스키마 디코더가 불일치로 집계), 편의 함수는 기본값
+    qint64 integer = 0;
+    QVERIFY(!frame.readInteger(*frame.find("frac"), &integer));
+    QVERIFY(!frame.readInteger(*frame.find("s"), &integer));
+    bool flag = false;
+    QVERIFY(!frame.readBool(*frame.find("i"), &flag));
+    std::string_view text;
+    QVERIFY(!frame.readString(*frame.find("i"), &text));
+    QCOMPARE(frame.integer("s"), qint64(0));
+    QCOMPARE(frame.integer("missing"), qint64(0));
+    QVERIFY(frame.text("missing").empty());
+}
+
+void TestEventFrame::rejectsMalformed()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(!frame.parse(""));
+    QVERIFY(!frame.parse("[1,2]"));                       // 최상위가 객체가 아님
+    QVERIFY(!frame.parse(R"({"type":"x")"));             // 닫는 괄호 없음
+    QVERIFY(!frame.parse(R"({"type" "x"})"));            // 콜론 없음
+    QVERIFY(!frame.parse(R"({"data":{"a":1})"));         // data 객체 뒤 끝나지 않음
+    QVERIFY(!frame.parse(R"({"s":"unterminated})"));
+    QVERIFY(frame.parse("{}"));
+    QVERIFY(frame.fields().empty());
+}
+
+void TestEventFrame::iteratesArrayElements()
+{
+    const std::string_view array = R"( [ {"a":1}, "s,]", 3 ,[4,5] ] )";
+    size_t offset = 0;
+    std::string_view element;
+    QStringList elements;
+    while (EventFrame::nextElement(array, &offset, &element))
+        elements.append(str(element));
+    QCOMPARE(elements, QStringList({ R"({"a":1})", R"("s,]")", "3", "[4,5]" }));
+
+    offset = 0;
+    QVERIFY(!EventFrame::nextElement("[]", &offset, &element));
+    offset = 0;
+    QVERIFY(!EventFrame::nextElement(R"({"a":1})", &offset, &element));  // 배열이 아님
+}
+
+void TestEventFrame::peeksType()
+{
+    QCOMPARE(str(EventFrame::peekType(R"({"type":"new_blur","data":{"count":2}})")), QString("new_blur"));
+    QCOMPARE(str(EventFrame::peekType(R"({"data":{"type":"inner"},"type":"new_fall"})")), QString("new_fall"));
+    QVERIFY(EventFrame::peekType(R"({"type":"esc\"aped"})").empty());  // 이스케이프 있는 값은 미리 보지 않음
+    QVERIFY(EventFrame::peekType(R"({"data":{}})").empty());
+    QVERIFY(EventFrame::peekType("not json").empty());
+}
+
+QTEST_GUILESS_MAIN(TestEventFrame)
+#include "tst_eventframe.moc"
@@ -0,0 +1,172 @@
+#include "eventgateway.h"
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+// EventGateway - 가짜 카메라(로컬 ws 서버) 하나를 구독시키고
+// 카메라 → 클라이언트 봉투 태깅 / 클라이언트 → 카메라 명령 전달(허용 목록) / 구독 해제 확인
+class TestEventGateway : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void tagsCameraMessages();
+    void forwardsAllowedCommandsOnly();
+    void unsubscribeClosesUpstream();
+
+private:
+    void send(QWebSocket *socket, const QJsonObject &obj);
+    static QJsonObject parse(const QString &message);
+    static QJsonObject lastStatus(const QSignalSpy &spy);
+
+    EventGateway *gateway = nullptr;
+    QWebSocketServer *camera = nullptr;        // 가짜 카메라
+    QWebSocket *cameraSide = nullptr;          // 게이트웨이가 카메라에 맺은 연결 (카메라 쪽 소켓)
+    QWebSocket *client = nullptr;              // 로컬 클라이언트
+    QSignalSpy *clientMessages = nullptr;
+};
+
+void TestEventGateway::send(QWebSocket *socket, const QJsonObject &obj)
+{
+    socket->sendTextMessage(QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+}
+
+QJsonObject TestEventGateway::parse(const QString &message)
+{
+    return QJsonDocument::fromJson(message.toUtf8()).object();
+}
+
+QJsonObject TestEventGateway::lastStatus(const QSignalSpy &spy)
+{
+    for (qsizetype i = spy.size() - 1; i >= 0; --i) {
+        const QJsonObject obj = parse(spy.at(i).at(0).toString());
+        if (obj.value("type").toString() == "gateway_status")
+            return obj;
+    }
+    return {};
+}
+
+void TestEventGateway::init()
+{
+    camera = new QWebSocketServer("fake camera", QWebSocketServer::NonSecureMode, this);
+    QVERIFY(camera->listen(QHostAddress::LocalHost, 0));
+    connect(camera, &QWebSocketServer::newConnection, this, [this]() {
+        cameraSide = camera->nextPendingConnection();
+    });
+
+    gateway = new EventGateway(this);
+    QVERIFY(gateway->listen(QHostAddress::LocalHost, 0));
+
+    client = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    clientMessages = new QSignalSpy(client, &QWebSocket::textMessageReceived);
+    QSignalSpy connected(client, &QWebSocket::connected);
+    client->open(QUrl(QString("ws://127.0.0.1:%1").arg(gateway->serverPort())));
+    QVERIFY(connected.wait(5000));
+
+    // 클라이언트와 같은 구독 메시지 (ws:// 카메라는 TLS 없이 연결)
+    QJsonObject entry;
+    entry["camera"] = "cam1";
+    entry["url"] = QString("ws://127.0.0.1:%1").arg(camera->serverPort());
+    QJsonObject subscribe;
+    subscribe["type"] = "gateway_subscribe";
+    subscribe["cameras"] = QJsonArray{ entry };
+    send(client, subscribe);
+
+    QTRY_VERIFY_WITH_TIMEOUT(cameraSide != nullptr, 5000);
+    QTRY_VERIFY_WITH_TIMEOUT(lastStatus(*clientMessages).value("connected").toBool(), 5000);
+    QCOMPARE(lastStatus(*clientMessages).value("camera").toString(), QString("cam1"));
+    QCOMPARE(gateway->cameraCount(), 1);
+    clientMessages->clear();
+}
+
+void TestEventGateway::cleanup()
+{
+    delete clientMessages;
+    delete client;
+    delete gateway;
+    delete camera;  // 카메라 쪽 소켓은 서버가 부모
+    clientMessages = nullptr;
+    client = nullptr;
+    gateway = nullptr;
+    camera = nullptr;
+    cameraSide = nullptr;
+}
+
+void TestEventGateway::tagsCameraMessages()
+{
+    const QString raw = R"({"type":"detection","data":{"person_count":2,"helmet_count":1}})";
+    cameraSide->sendTextMessage(raw);
+    QTRY_COMPARE_WITH_TIMEOUT(clientMessages->size(), 1, 5000);
+
+    // 카메라 원본은 다시 직렬화하지 않고 msg에 그대로
+    const QString frame = clientMessages->first().at(0).toString();
+    QCOMPARE(frame, QString(R"({"camera":"cam1","msg":)") + raw + "}");
+    const QJsonObject envelope = parse(frame);
+    QCOMPARE(envelope.value("camera").toString(), QString("cam1"));
+    QCOMPARE(envelope.value("msg").toObject(), parse(raw));
+}
+
+void TestEventGateway::forwardsAllowedCommandsOnly()
+{
+    QSignalSpy cameraMessages(cameraSide, &QWebSocket::textMessageReceived);
+
+    QJsonObject setMode;
+    setMode["type"] = "set_mode";
+    setMode["mode"] = "blur";
+    QJsonObject frame;
+    frame["camera"] = "cam1";
+    frame["msg"] = setMode;
+    send(client, frame);
+    QVERIFY(cameraMessages.wait(5000));
+    QCOMPARE(parse(cameraMessages.first().at(0).toString()), setMode);
+
+    // 허용 목록 밖의 명령은 버림 - 뒤따른 request_stm_status만 도착
+    QJsonObject other;
+    other["type"] = "reboot";
+    frame["msg"] = other;
+    send(client, frame);
+    QJsonObject status;
+    status["type"] = "request_stm_status";
+    frame["msg"] = status;
+    send(client, frame);
+    QTRY_COMPARE_WITH_TIMEOUT(cameraMessages.size(), 2, 5000);
+    QCOMPARE(parse(cameraMessages.at(1).at(0).toString()), status);
+
+    // 모르는 카메라 id는 전달하지 않음
+    frame["camera"] = "cam2";
+    send(client, frame);
+    QTest::qWait(200);
+    QCOMPARE(cameraMessages.size(), 2);
+}
+
+void TestEventGateway::unsubscribeClosesUpstream()
+{
+    QSignalSpy cameraClosed(cameraSide, &QWebSocket::disconnected);
+
+    QJsonObject unsubscribe;
+    unsubscribe["type"] = "gateway_unsubscribe";
+    unsubscribe["cameras"] = QJsonArray{ "cam1" };
+    send(client, unsubscribe);
+
+    QVERIFY(cameraClosed.wait(5000));
+    QCOMPARE(gateway->cameraCount(), 0);
+    QTRY_VERIFY_WITH_TIMEOUT(!lastStatus(*clientMessages).isEmpty(), 5000);
+    QCOMPARE(lastStatus(*clientMessages).value("camera").toString(), QString("cam1"));
+    QVERIFY(!lastStatus(*clientMessages).value("connected").toBool());
+
+    // 해제 후에는 재연결하지 않음
+    cameraSide = nullptr;
+    QTest::qWait(1500);
+    QVERIFY(cameraSide == nullptr);
+}
+
+QTEST_GUILESS_MAIN(TestEventGateway)
+#include "tst_eventgateway.moc"
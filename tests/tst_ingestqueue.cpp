@@ -0,0 +1,164 @@
+#include "ingestqueue.h"
+
+#include <QtTest>
+#include <QSignalSpy>
+
+// 수신 큐 - 카메라 안 우선순위 / 카메라 간 순회 / 과부하 시 Low 병합, Normal 버림 / 파싱 실패 / 카메라 제거
+class TestIngestQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void drainsByPriority();
+    void roundRobinAcrossCameras();
+    void coalescesLowUnderOverload();
+    void shedsOldestNormalBeyondCap();
+    void countsMalformed();
+    void removeCameraDropsPending();
+
+private:
+    struct Processed {
+        QString ip;
+        QString type;
+        qint64 value = 0;  // data.count 또는 data.id
+    };
+
+    static QByteArray event(const char *type, const char *key, int value);
+
+    IngestQueue *queue = nullptr;
+    QVector<Processed> processed;
+};
+
+QByteArray TestIngestQueue::event(const char *type, const char *key, int value)
+{
+    return QByteArray("{\"type\":\"") + type + "\",\"data\":{\"" + key + "\":" + QByteArray::number(value) + "}}";
+}
+
+void TestIngestQueue::init()
+{
+    processed.clear();
+    queue = new IngestQueue([this](const QString &ip, const EventFrame &frame) {
+        Processed item;
+        item.ip = ip;
+        item.type = EventFrame::toQString(frame.type());
+        item.value = frame.find("count", EventFrame::Scope::Data) ? frame.integer("count", EventFrame::Scope::Data)
+                                                                   : frame.integer("id", EventFrame::Scope::Data);
+        processed.append(item);
+    }, this);
+    queue->setPriority("new_detection", IngestQueue::Priority::Normal);
+    queue->setPriority("new_blur", IngestQueue::Priority::Low);
+}
+
+void TestIngestQueue::cleanup()
+{
+    delete queue;
+    queue = nullptr;
+}
+
+void TestIngestQueue::drainsByPriority()
+{
+    // 처리 턴은 다음 이벤트 루프에서 - 그 전에 쌓인 것은 High → Normal → Low 순서
+    queue->enqueue("cam", event("new_blur", "count", 1));
+    queue->enqueue("cam", event("new_detection", "id", 2));
+    queue->enqueue("cam", event("new_fall", "count", 3));
+    QCOMPARE(queue->depth(), 3);
+
+    QTRY_COMPARE(processed.size(), 3);
+    QCOMPARE(processed.at(0).type, QString("new_fall"));
+    QCOMPARE(processed.at(1).type, QString("new_detection"));
+    QCOMPARE(processed.at(2).type, QString("new_blur"));
+    QCOMPARE(queue->depth(), 0);
+}
+
+void TestIngestQueue::roundRobinAcrossCameras()
+{
+    // 한 카메라가 먼저 많이 보내도 다른 카메라의 이벤트가 뒤로 밀리지 않음
+    for (int i = 0; i < 3; ++i)
+        queue->enqueue("a", event("new_detection", "id", i));
+    queue->enqueue("b", event("new_fall", "count", 1));
+
+    QTRY_COMPARE(processed.size(), 4);
+    QStringList order;
+    for (const Processed &item : std::as_const(processed))
+        order.append(item.ip);
+    QCOMPARE(order, QStringList({ "a", "b", "a", "a" }));
+    QCOMPARE(queue->cameras(), QStringList({ "a", "b" }));
+}
+
+void TestIngestQueue::coalescesLowUnderOverload()
+{
+    QSignalSpy shed(queue, &IngestQueue::shedCountChanged);
+
+    for (int i = 0; i < IngestQueue::OverloadDepth; ++i)
+        queue->enqueue("cam", event("new_detection", "id", i));
+    // 첫 blur는 대기열에 들어가고, 이후 blur는 그 자리를 최신 값으로 교체
+    for (int i = 1; i <= 5; ++i)
+        queue->enqueue("cam", event("new_blur", "count", i));
+
+    QCOMPARE(queue->coalescedCount(), quint64(4));
+    QCOMPARE(queue->droppedCount(), quint64(0));
+    QCOMPARE(queue->depth(), IngestQueue::OverloadDepth + 1);
+
+    QTRY_COMPARE(processed.size(), IngestQueue::OverloadDepth + 1);
+    QCOMPARE(processed.last().type, QString("new_blur"));
+    QCOMPARE(processed.last().value, qint64(5));
+
+    QVERIFY(!shed.isEmpty());
+    QCOMPARE(shed.last().at(1).toULongLong(), quint64(4));
+}
+
+void TestIngestQueue::shedsOldestNormalBeyondCap()
+{
+    // High는 상한 계산에서 빠지고 버려지지 않음
+    for (int i = 0; i < 200; ++i)
+        queue->enqueue("cam", event("new_fall", "count", i));
+    const int extra = 2;
+    for (int i = 0; i < IngestQueue::MaxQueuedPerCamera + extra; ++i)
+        queue->enqueue("cam", event("new_detection", "id", i));
+
+    QCOMPARE(queue->droppedCount(), quint64(extra));
+    QCOMPARE(queue->depth(), 200 + IngestQueue::MaxQueuedPerCamera);
+
+    QTRY_COMPARE(processed.size(), 200 + IngestQueue::MaxQueuedPerCamera);
+    int falls = 0;
+    qint64 firstDetection = -1;
+    for (const Processed &item : std::as_const(processed)) {
+        if (item.type == QLatin1String("new_fall"))
+            ++falls;
+        else if (firstDetection < 0)
+            firstDetection = item.value;
+    }
+    QCOMPARE(falls, 200);
+    QCOMPARE(firstDetection, qint64(extra));  // 가장 오래된 감지부터 버림
+}
+
+void TestIngestQueue::countsMalformed()
+{
+    queue->enqueue("cam", QByteArray("{\"type\":\"new_fall\",\"data\":"));
+    queue->enqueue("cam", event("new_fall", "count", 1));
+
+    QTRY_COMPARE(processed.size(), 1);
+    QCOMPARE(queue->malformedCount(), quint64(1));
+    QTRY_COMPARE(queue->depth(), 0);
+}
+
+void TestIngestQueue::removeCameraDropsPending()
+{
+    for (int i = 0; i < 3; ++i)
+        queue->enqueue("a", event("new_fall", "count", i));
+    queue->enqueue("b", event("new_fall", "count", 9));
+    queue->removeCamera("a");
+
+    QCOMPARE(queue->depth(), 1);
+    QCOMPARE(queue->cameras(), QStringList({ "b" }));
+    QTRY_COMPARE(processed.size(), 1);
+    QCOMPARE(processed.first().ip, QString("b"));
+    QTest::qWait(50);
+    QCOMPARE(processed.size(), 1);
+}
+
+QTEST_GUILESS_MAIN(TestIngestQueue)
+#include "tst_ingestqueue.moc"
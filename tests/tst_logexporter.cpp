@@ -0,0 +1,256 @@
+#include "logexporter.h"
+
+#include <QtTest>
+#include <QDateTime>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include <cstring>
+
+// 로그 내보내기 - 저장 순서와 무관하게 기록 시각 오름차순, 열 형식 왕복 읽기, CSV 필터/따옴표, 진행률
+class TestLogExporter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void filterBounds();
+    void columnarRoundTrip();
+    void csvSortedAndFiltered();
+
+private:
+    // 열 형식 파일 순차 읽기 (리틀 엔디언)
+    struct Reader {
+        QByteArray data;
+        qsizetype pos = 0;
+
+        template <typename T>
+        T read()
+        {
+            T value = qFromLittleEndian<T>(data.constData() + pos);
+            pos += qsizetype(sizeof(T));
+            return value;
+        }
+        QByteArray bytes(qsizetype size)
+        {
+            const QByteArray out = data.mid(pos, size);
+            pos += size;
+            return out;
+        }
+        QString string() { return QString::fromUtf8(bytes(read<quint16>())); }
+    };
+
+    static LogEntry entry(quint16 cameraId, qint64 timestampMs, LogFunction function, LogEvent event);
+    bool exportTo(const LogExporter::Filter &filter, LogExporter::Format format, const QString &path,
+                  qint64 *rows, QList<QVariant> *lastProgress = nullptr);
+
+    LogStore store;
+    quint16 entrance = 0;
+    quint16 storage = 0;
+    quint32 image = 0;
+    qint64 base = 0;
+};
+
+LogEntry TestLogExporter::entry(quint16 cameraId, qint64 timestampMs, LogFunction function, LogEvent event)
+{
+    LogEntry e;
+    e.cameraId = cameraId;
+    e.timestampMs = timestampMs;
+    e.function = function;
+    e.event = event;
+    return e;
+}
+
+void TestLogExporter::init()
+{
+    store = LogStore();
+    entrance = store.cameraId("입구, 동쪽", "10.0.0.1");  // 쉼표 - CSV에서 따옴표
+    storage = store.cameraId("창고", "10.0.0.2");
+    image = store.internImage("/img/a.jpg");
+    base = QDateTime(QDate(2025, 1, 2), QTime(3, 4, 0)).toMSecsSinceEpoch();
+
+    // 저장 순서 = [6s, 5s, 3s, 1s, 2s] - 실시간은 앞에 추가, 동기화된 과거 로그는 뒤에 추가
+    LogEntry fall = entry(entrance, base + 3000, LogFunction::Fall, LogEvent::Fall);
+    store.append(fall);
+    LogEntry ppe = entry(entrance, base + 5000, LogFunction::PPE, LogEvent::HelmetMissing);
+    ppe.confidence = 0.75f;
+    ppe.imageId = image;
+    store.prepend(ppe);
+    store.prepend(entry(storage, base + 6000, LogFunction::Night, LogEvent::Trespass));
+    store.append(entry(entrance, base + 1000, LogFunction::Blur, LogEvent::BlurCount));
+    store.append(entry(storage, base + 2000, LogFunction::Fall, LogEvent::Fall));
+}
+
+bool TestLogExporter::exportTo(const LogExporter::Filter &filter, LogExporter::Format format, const QString &path,
+                               qint64 *rows, QList<QVariant> *lastProgress)
+{
+    LogExporter exporter;
+    QSignalSpy progress(&exporter, &LogExporter::progress);
+    QSignalSpy finished(&exporter, &LogExporter::finished);
+    if (!exporter.start(store, filter, format, path))
+        return false;
+    if (!finished.wait(5000) && finished.isEmpty())
+        return false;
+
+    const QList<QVariant> args = finished.first();
+    *rows = args.at(1).toLongLong();
+    if (lastProgress && !progress.isEmpty())
+        *lastProgress = progress.last();
+    return args.at(0).toBool();
+}
+
+void TestLogExporter::filterBounds()
+{
+    LogExporter::Filter filter;
+    QVERIFY(filter.accepts(entry(entrance, base, LogFunction::Fall, LogEvent::Fall)));
+
+    // 시작/끝 모두 포함
+    filter.fromMs = base + 1000;
+    filter.toMs = base + 2000;
+    QVERIFY(!filter.accepts(entry(entrance, base + 999, LogFunction::Fall, LogEvent::Fall)));
+    QVERIFY(filter.accepts(entry(entrance, base + 1000, LogFunction::Fall, LogEvent::Fall)));
+    QVERIFY(filter.accepts(entry(entrance, base + 2000, LogFunction::Fall, LogEvent::Fall)));
+    QVERIFY(!filter.accepts(entry(entrance, base + 2001, LogFunction::Fall, LogEvent::Fall)));
+
+    filter.cameraId = storage;
+    filter.function = int(LogFunction::Night);
+    QVERIFY(!filter.accepts(entry(entrance, base + 1500, LogFunction::Night, LogEvent::Trespass)));
+    QVERIFY(!filter.accepts(entry(storage, base + 1500, LogFunction::Fall, LogEvent::Fall)));
+    QVERIFY(filter.accepts(entry(storage, base + 1500, LogFunction::Night, LogEvent::Trespass)));
+}
+
+void TestLogExporter::columnarRoundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("logs.ssncol");
+
+    qint64 rows = 0;
+    QList<QVariant> lastProgress;
+    QVERIFY(exportTo(LogExporter::Filter(), LogExporter::Format::Columnar, path, &rows, &lastProgress));
+    QCOMPARE(rows, qint64(5));
+    QCOMPARE(lastProgress.at(0).toLongLong(), qint64(5));
+    QCOMPARE(lastProgress.at(1).toLongLong(), qint64(5));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    Reader reader { file.readAll() };
+
+    QCOMPARE(reader.bytes(8), QByteArray("SSNCOL1\0", 8));
+    const quint32 chunkRows = reader.read<quint32>();
+    QCOMPARE(chunkRows, quint32(5));
+
+    // 열 순서대로 [행 수 × 폭] - 시각은 저장 순서가 아닌 오름차순
+    QList<qint64> times;
+    for (quint32 i = 0; i < chunkRows; ++i)
+        times.append(reader.read<qint64>() - base);
+    QCOMPARE(times, QList<qint64>({ 1000, 2000, 3000, 5000, 6000 }));
+    reader.pos += chunkRows * 8;  // source_timestamp_ms
+
+    QList<quint16> cameraIds;
+    for (quint32 i = 0; i < chunkRows; ++i)
+        cameraIds.append(reader.read<quint16>());
+    QCOMPARE(cameraIds, QList<quint16>({ entrance, storage, entrance, entrance, storage }));
+    reader.pos += chunkRows * 2;  // zone
+
+    QList<quint8> functions;
+    for (quint32 i = 0; i < chunkRows; ++i)
+        functions.append(reader.read<quint8>());
+    QCOMPARE(functions.at(3), quint8(LogFunction::PPE));
+    reader.pos += chunkRows * 1;      // event
+    reader.pos += chunkRows * 2 * 4;  // person / helmet / vest / count
+
+    reader.pos += 3 * 4;  // 4번째 행(5s PPE)의 confidence까지
+    float confidence = 0.0f;
+    const quint32 bits = reader.read<quint32>();
+    std::memcpy(&confidence, &bits, sizeof(confidence));
+    QCOMPARE(confidence, 0.75f);
+    reader.pos += 1 * 4;  // 5번째 행 confidence
+
+    // temperature(4) + light(2) + buzzer_on(1) + led_on(1) + duration_ms(4)
+    reader.pos += chunkRows * (4 + 2 + 1 + 1 + 4);
+    QList<quint32> imageIds;
+    for (quint32 i = 0; i < chunkRows; ++i)
+        imageIds.append(reader.read<quint32>());
+    QCOMPARE(imageIds, QList<quint32>({ 0, 0, 0, image, 0 }));
+    reader.pos += chunkRows * 4;  // clip_id
+
+    QCOMPARE(reader.read<quint32>(), quint32(0));  // 묶음 끝
+
+    // 열 정의
+    const quint32 columnCount = reader.read<quint32>();
+    QCOMPARE(columnCount, quint32(18));
+    qsizetype rowWidth = 0;
+    for (quint32 i = 0; i < columnCount; ++i) {
+        const QByteArray name = reader.bytes(reader.read<quint8>());
+        const quint8 type = reader.read<quint8>();
+        const quint8 width = reader.read<quint8>();
+        if (i == 0) {
+            QCOMPARE(name, QByteArray("timestamp_ms"));
+            QCOMPARE(type, quint8(LogExporter::ColumnType::Int));
+            QCOMPARE(width, quint8(8));
+        }
+        rowWidth += width;
+    }
+    QCOMPARE(rowWidth, qsizetype(54));
+
+    // 문자열 테이블 - 내보낸 행이 참조하는 것만
+    const quint32 cameraCount = reader.read<quint32>();
+    QCOMPARE(cameraCount, quint32(2));
+    QHash<quint16, QString> names;
+    for (quint32 i = 0; i < cameraCount; ++i) {
+        const quint16 id = reader.read<quint16>();
+        names.insert(id, reader.string());
+        reader.string();  // IP
+    }
+    QCOMPARE(names.value(entrance), QString("입구, 동쪽"));
+    QCOMPARE(names.value(storage), QString("창고"));
+
+    QCOMPARE(reader.read<quint32>(), quint32(1));
+    QCOMPARE(reader.read<quint32>(), image);
+    QCOMPARE(reader.string(), QString("/img/a.jpg"));
+    QCOMPARE(reader.read<quint32>(), quint32(0));  // 클립 없음
+
+    QCOMPARE(reader.read<quint64>(), quint64(5));
+    QCOMPARE(reader.bytes(8), QByteArray("SSNCOL1\0", 8));
+    QCOMPARE(reader.pos, reader.data.size());
+}
+
+void TestLogExporter::csvSortedAndFiltered()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("logs.csv");
+
+    LogExporter::Filter filter;
+    filter.cameraId = entrance;
+    qint64 rows = 0;
+    QVERIFY(exportTo(filter, LogExporter::Format::Csv, path, &rows));
+    QCOMPARE(rows, qint64(3));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray data = file.readAll();
+    QVERIFY(data.startsWith("\xEF\xBB\xBF"));
+    data.remove(0, 3);
+
+    const QList<QByteArray> lines = data.trimmed().split('\n');
+    QCOMPARE(lines.size(), 4);
+    QVERIFY(lines.at(0).startsWith("time,source_time,camera,ip,"));
+
+    // 1s blur → 3s fall → 5s PPE (저장 순서는 5s, 3s, 1s)
+    QVERIFY(lines.at(1).startsWith("2025-01-02 03:04:01.000,,\"입구, 동쪽\",10.0.0.1,"));
+    QVERIFY(lines.at(1).contains(",blur_count,"));
+    QVERIFY(lines.at(2).startsWith("2025-01-02 03:04:03.000,"));
+    QVERIFY(lines.at(2).contains(",fall,"));
+    QVERIFY(lines.at(3).startsWith("2025-01-02 03:04:05.000,"));
+    QVERIFY(lines.at(3).contains(",helmet_missing,"));
+    QVERIFY(lines.at(3).contains(",0.75,"));
+    QVERIFY(lines.at(3).endsWith(",/img/a.jpg,"));
+}
+
+QTEST_GUILESS_MAIN(TestLogExporter)
+#include "tst_logexporter.moc"
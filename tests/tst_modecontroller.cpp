@@ -0,0 +1,175 @@
+#include "modecontroller.h"
+
+#include <QtTest>
+#include <QSignalSpy>
+
+// 모드 제어 - 동시 전송 후 ack 집계, 부분 실패 롤백, 응답 시간 초과, 연결 대기, 이전 요청 대체, 카메라 제거
+class TestModeController : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void allAckedSucceeds();
+    void partialFailureRollsBack();
+    void timeoutFailsPending();
+    void unsentCameraWaits();
+    void newRequestSupersedesOld();
+    void removeCameraFinishesBatch();
+
+private:
+    ModeController *controller = nullptr;
+    QStringList sent;          // "ip=mode" 전송 순서
+    QSet<QString> offline;     // 전송 불가(연결 전) 카메라
+};
+
+void TestModeController::init()
+{
+    sent.clear();
+    offline.clear();
+    controller = new ModeController([this](const QString &ip, const QString &mode) {
+        if (offline.contains(ip))
+            return false;
+        sent.append(ip + "=" + mode);
+        return true;
+    }, this);
+}
+
+void TestModeController::cleanup()
+{
+    delete controller;
+    controller = nullptr;
+}
+
+void TestModeController::allAckedSucceeds()
+{
+    QSignalSpy applied(controller, &ModeController::modeApplied);
+    QSignalSpy acked(controller, &ModeController::cameraModeAcked);
+
+    controller->applyMode("blur", { "a", "b" });
+    QCOMPARE(sent, QStringList({ "a=blur", "b=blur" }));
+    QVERIFY(controller->state("a").pending);
+
+    controller->handleAck("a", "blur", "ok", QString());
+    QCOMPARE(applied.count(), 0);
+    controller->handleAck("b", QString(), "ok", QString());  // mode 생략 = 요청한 모드
+
+    QCOMPARE(applied.count(), 1);
+    const QList<QVariant> args = applied.takeFirst();
+    QCOMPARE(args.at(0).toString(), QString("blur"));
+    QCOMPARE(args.at(1).toStringList(), QStringList({ "a", "b" }));
+    QVERIFY(args.at(2).toStringList().isEmpty());
+    QCOMPARE(args.at(3).toBool(), false);
+
+    QCOMPARE(acked.count(), 2);
+    QCOMPARE(controller->state("b").acked, QString("blur"));
+    QVERIFY(!controller->state("b").pending);
+}
+
+void TestModeController::partialFailureRollsBack()
+{
+    // 요청 없이 온 ack로 현재 확인 모드 설정
+    controller->handleAck("a", "raw", "ok", QString());
+    controller->handleAck("b", "raw", "ok", QString());
+    QCOMPARE(controller->state("a").acked, QString("raw"));
+
+    QSignalSpy applied(controller, &ModeController::modeApplied);
+    controller->applyMode("blur", { "a", "b" });
+    controller->handleAck("a", "blur", "ok", QString());
+    controller->handleAck("b", "blur", "error", "busy");
+
+    QCOMPARE(applied.count(), 1);
+    const QList<QVariant> args = applied.takeFirst();
+    QCOMPARE(args.at(1).toStringList(), QStringList({ "a" }));
+    QCOMPARE(args.at(2).toStringList(), QStringList({ "b" }));
+    QCOMPARE(args.at(3).toBool(), true);
+
+    // 성공한 a만 이전 모드로 다시 전송, 실패한 b는 원래 모드 유지로 간주
+    QCOMPARE(sent.last(), QString("a=raw"));
+    QCOMPARE(controller->state("a").desired, QString("raw"));
+    QVERIFY(controller->state("a").pending);
+    QCOMPARE(controller->state("b").desired, QString("raw"));
+    QCOMPARE(controller->state("b").error, QString("busy"));
+
+    // 롤백 batch는 modeApplied로 다시 보고하지 않음
+    controller->handleAck("a", "raw", "ok", QString());
+    QCOMPARE(controller->state("a").acked, QString("raw"));
+    QVERIFY(!controller->state("a").pending);
+    QCOMPARE(applied.count(), 0);
+}
+
+void TestModeController::timeoutFailsPending()
+{
+    controller->setAckTimeout(50);
+    QSignalSpy applied(controller, &ModeController::modeApplied);
+
+    controller->applyMode("ppe", { "a" });
+    QTRY_COMPARE_WITH_TIMEOUT(applied.count(), 1, 2000);
+
+    const QList<QVariant> args = applied.takeFirst();
+    QVERIFY(args.at(1).toStringList().isEmpty());
+    QCOMPARE(args.at(2).toStringList(), QStringList({ "a" }));
+    QCOMPARE(args.at(3).toBool(), false);  // 성공한 카메라가 없으면 롤백 없음
+    QCOMPARE(controller->state("a").error, QString("응답 시간 초과"));
+    QVERIFY(!controller->state("a").pending);
+}
+
+void TestModeController::unsentCameraWaits()
+{
+    offline.insert("b");
+    QSignalSpy applied(controller, &ModeController::modeApplied);
+
+    controller->applyMode("blur", { "a", "b" });
+    QCOMPARE(sent, QStringList({ "a=blur" }));
+    controller->handleAck("a", "blur", "ok", QString());
+
+    // 연결 전 카메라는 실패가 아님 - 연결 시 desired 모드가 다시 적용됨
+    QCOMPARE(applied.count(), 1);
+    const QList<QVariant> args = applied.takeFirst();
+    QCOMPARE(args.at(1).toStringList(), QStringList({ "a" }));
+    QVERIFY(args.at(2).toStringList().isEmpty());
+    QCOMPARE(controller->state("b").desired, QString("blur"));
+    QVERIFY(controller->state("b").error.isEmpty());
+    QVERIFY(!controller->state("b").pending);
+}
+
+void TestModeController::newRequestSupersedesOld()
+{
+    QSignalSpy applied(controller, &ModeController::modeApplied);
+
+    controller->applyMode("blur", { "a" });
+    controller->applyMode("ppe", { "a" });  // 이전 batch는 대상이 없어져 바로 종료
+    QCOMPARE(applied.count(), 1);
+    QCOMPARE(applied.first().at(0).toString(), QString("blur"));
+    QVERIFY(applied.first().at(1).toStringList().isEmpty());
+
+    // 늦게 도착한 이전 요청의 ack는 무시
+    controller->handleAck("a", "blur", "ok", QString());
+    QCOMPARE(applied.count(), 1);
+    QVERIFY(controller->state("a").pending);
+
+    controller->handleAck("a", "ppe", "ok", QString());
+    QCOMPARE(applied.count(), 2);
+    QCOMPARE(applied.last().at(0).toString(), QString("ppe"));
+    QCOMPARE(applied.last().at(1).toStringList(), QStringList({ "a" }));
+    QCOMPARE(controller->state("a").acked, QString("ppe"));
+}
+
+void TestModeController::removeCameraFinishesBatch()
+{
+    QSignalSpy applied(controller, &ModeController::modeApplied);
+
+    controller->applyMode("blur", { "a", "b" });
+    controller->handleAck("a", "blur", "ok", QString());
+    controller->removeCamera("b");
+
+    QCOMPARE(applied.count(), 1);
+    QCOMPARE(applied.first().at(1).toStringList(), QStringList({ "a" }));
+    QVERIFY(applied.first().at(2).toStringList().isEmpty());
+    QCOMPARE(controller->cameras(), QStringList({ "a" }));
+}
+
+QTEST_GUILESS_MAIN(TestModeController)
+#include "tst_modecontroller.moc"
@@ -0,0 +1,160 @@
+#include "onvifclient.h"
+#include "onvifstubserver.h"
+
+#include <QtTest>
+#include <QNetworkAccessManager>
+#include <QSignalSpy>
+
+// OnvifClient - 로컬 스텁 서버 상대로 프로파일 조회 / 선택 / 인증 헤더 / 실패 백오프 확인
+class TestOnvifClient : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void profilesSortedByResolution();
+    void selectProfileUpgradesWhenEnlarged();
+    void sendsWsSecurityDigest();
+    void backsOffAfterFault();
+
+private:
+    CameraInfo stubCamera(const QString &user = QString()) const;
+    QVector<OnvifProfile> discoverProfiles(const CameraInfo &camera);
+
+    OnvifStubServer *stub = nullptr;
+    QNetworkAccessManager *manager = nullptr;
+};
+
+CameraInfo TestOnvifClient::stubCamera(const QString &user) const
+{
+    CameraInfo camera;
+    camera.name = "stub";
+    camera.ip = "127.0.0.1";
+    camera.port = QString::number(stub->port());
+    camera.type = CameraInfo::Type::Onvif;
+    camera.onvifUser = user;
+    camera.onvifPassword = user.isEmpty() ? QString() : QString("secret-pass");
+    return camera;
+}
+
+QVector<OnvifProfile> TestOnvifClient::discoverProfiles(const CameraInfo &camera)
+{
+    OnvifClient client(manager);
+    QSignalSpy ready(&client, &OnvifClient::profilesReady);
+    client.discover(camera);
+    if (!ready.wait(5000))
+        return {};
+    return client.profiles(camera.ip);
+}
+
+void TestOnvifClient::init()
+{
+    stub = new OnvifStubServer(this);
+    QVERIFY(stub->listen());
+    manager = new QNetworkAccessManager(this);
+}
+
+void TestOnvifClient::cleanup()
+{
+    delete manager;
+    delete stub;
+    manager = nullptr;
+    stub = nullptr;
+}
+
+void TestOnvifClient::profilesSortedByResolution()
+{
+    const QVector<OnvifProfile> profiles = discoverProfiles(stubCamera());
+    QCOMPARE(profiles.size(), 3);
+
+    // 스텁은 main / sub / mid 순서로 응답 - 캐시는 해상도 오름차순
+    QCOMPARE(profiles.at(0).token, QString("sub"));
+    QCOMPARE(profiles.at(0).resolution, QSize(640, 360));
+    QCOMPARE(profiles.at(1).token, QString("mid"));
+    QCOMPARE(profiles.at(1).resolution, QSize(1280, 720));
+    QCOMPARE(profiles.at(2).token, QString("main"));
+    QCOMPARE(profiles.at(2).resolution, QSize(1920, 1080));
+    QCOMPARE(profiles.at(0).name, QString("SubStream"));
+    QCOMPARE(profiles.at(0).streamUri, QString("rtsp://127.0.0.1:8554/sub"));
+}
+
+void TestOnvifClient::selectProfileUpgradesWhenEnlarged()
+{
+    const QVector<OnvifProfile> profiles = discoverProfiles(stubCamera());
+    QCOMPARE(profiles.size(), 3);
+
+    // 썸네일 → 일반 타일 → 포커스 주 화면으로 커질수록 높은 프로파일
+    QCOMPARE(OnvifClient::selectProfile(profiles, QSize(320, 180)).token, QString("sub"));
+    QCOMPARE(OnvifClient::selectProfile(profiles, QSize(640, 360)).token, QString("sub"));
+    QCOMPARE(OnvifClient::selectProfile(profiles, QSize(960, 540)).token, QString("mid"));
+    QCOMPARE(OnvifClient::selectProfile(profiles, QSize(1440, 810)).token, QString("main"));
+
+    // 어떤 프로파일도 채우지 못하면 가장 높은 프로파일, 목록이 비면 빈 프로파일
+    QCOMPARE(OnvifClient::selectProfile(profiles, QSize(3840, 2160)).token, QString("main"));
+    QVERIFY(OnvifClient::selectProfile({}, QSize(640, 360)).token.isEmpty());
+}
+
+void TestOnvifClient::sendsWsSecurityDigest()
+{
+    const CameraInfo camera = stubCamera("admin");
+    const QVector<OnvifProfile> profiles = discoverProfiles(camera);
+    QCOMPARE(profiles.size(), 3);
+
+    // GetCapabilities + GetProfiles + GetStreamUri x3 - 모두 UsernameToken(PasswordDigest), 평문 비밀번호 없음
+    const QList<QByteArray> requests = stub->requests();
+    QCOMPARE(requests.size(), 5);
+    for (const QByteArray &body : requests) {
+        QVERIFY(body.contains("<wsse:Username>admin</wsse:Username>"));
+        QVERIFY(body.contains("#PasswordDigest\">"));
+        QVERIFY(body.contains("<wsse:Nonce"));
+        QVERIFY(body.contains("<wsu:Created>"));
+        QVERIFY(!body.contains("secret-pass"));
+    }
+
+    // 캐시/레지스트리에 남는 URI에는 인증 정보 없음 - 재생 직전에만 붙임
+    QVERIFY(QUrl(profiles.at(0).streamUri).userInfo().isEmpty());
+    const QUrl playback(camera.onvifPlaybackUrl(profiles.at(0).streamUri));
+    QCOMPARE(playback.userName(), QString("admin"));
+    QCOMPARE(playback.password(), QString("secret-pass"));
+
+    // 인증 정보가 없는 카메라는 Security 헤더 없이 요청
+    stub->clearRequests();
+    QCOMPARE(discoverProfiles(stubCamera()).size(), 3);
+    for (const QByteArray &body : stub->requests())
+        QVERIFY(!body.contains("wsse:Security"));
+}
+
+void TestOnvifClient::backsOffAfterFault()
+{
+    stub->setFault(true);
+    const CameraInfo camera = stubCamera();
+
+    OnvifClient client(manager);
+    QSignalSpy failed(&client, &OnvifClient::discoveryFailed);
+    client.discover(camera);
+    QVERIFY(failed.wait(5000));
+    QCOMPARE(failed.first().at(0).toString(), camera.ip);
+    QVERIFY(!client.hasProfiles(camera.ip));
+
+    const int firstDelay = client.retryDelayMs(camera.ip);
+    QVERIFY(firstDelay > 0);
+    QVERIFY(firstDelay <= OnvifClient::RetryBaseMs);
+
+    // 백오프 중에는 다시 불러도 요청하지 않음 (페이지 재바인딩마다 재조회 방지)
+    const int requests = stub->requestCount();
+    client.discover(camera);
+    QTest::qWait(200);
+    QCOMPARE(stub->requestCount(), requests);
+    QCOMPARE(failed.size(), 1);
+
+    // 대기가 끝난 뒤 다시 실패하면 간격이 두 배
+    QTRY_COMPARE_WITH_TIMEOUT(client.retryDelayMs(camera.ip), 0, OnvifClient::RetryBaseMs + 1000);
+    client.discover(camera);
+    QVERIFY(failed.wait(5000));
+    QVERIFY(client.retryDelayMs(camera.ip) > OnvifClient::RetryBaseMs);
+}
+
+QTEST_GUILESS_MAIN(TestOnvifClient)
+#include "tst_onvifclient.moc"
@@ -0,0 +1,91 @@
+#include "ppeclassifier.h"
+
+#include <QtTest>
+#include <QVector>
+
+// PPE 판정 - 열 단위 일괄 판정이 1건 판정과 같은 결과/건수를 내는지, 로그 이벤트 매핑
+class TestPpeClassifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void scalarRules();
+    void batchMatchesScalar();
+    void emptyBatch();
+    void logEventMapping();
+};
+
+void TestPpeClassifier::scalarRules()
+{
+    // 헬멧/조끼 수가 인원보다 적을 때만 미착용
+    QCOMPARE(PpeClassifier::classify(0, 0, 0), PpeResult::Compliant);
+    QCOMPARE(PpeClassifier::classify(3, 3, 3), PpeResult::Compliant);
+    QCOMPARE(PpeClassifier::classify(3, 5, 4), PpeResult::Compliant);  // 오검출로 더 많아도 착용
+    QCOMPARE(PpeClassifier::classify(3, 2, 3), PpeResult::HelmetMissing);
+    QCOMPARE(PpeClassifier::classify(3, 3, 0), PpeResult::VestMissing);
+    QCOMPARE(PpeClassifier::classify(3, 0, 0), PpeResult::BothMissing);
+    QCOMPARE(PpeClassifier::classify(0xFFFF, 0xFFFE, 0xFFFF), PpeResult::HelmetMissing);
+}
+
+void TestPpeClassifier::batchMatchesScalar()
+{
+    // 0~5 전 조합 + 경계값 - 자동 벡터화된 루프도 같은 결과여야 함 (벡터 폭의 배수가 아닌 길이)
+    QVector<quint16> persons, helmets, vests;
+    for (quint16 p = 0; p <= 5; ++p) {
+        for (quint16 h = 0; h <= 5; ++h) {
+            for (quint16 v = 0; v <= 5; ++v) {
+                persons.append(p);
+                helmets.append(h);
+                vests.append(v);
+            }
+        }
+    }
+    persons.append(0xFFFF);
+    helmets.append(0);
+    vests.append(0xFFFF);
+    const qsizetype count = persons.size();
+    QCOMPARE(count, qsizetype(6 * 6 * 6 + 1));
+
+    QVector<PpeResult> results(count);
+    const PpeTally tally = PpeClassifier::classify(persons.constData(), helmets.constData(), vests.constData(),
+                                                   count, results.data());
+
+    PpeTally expected;
+    for (qsizetype i = 0; i < count; ++i) {
+        const PpeResult scalar = PpeClassifier::classify(persons.at(i), helmets.at(i), vests.at(i));
+        QCOMPARE(results.at(i), scalar);
+        expected.add(scalar);
+    }
+    QCOMPARE(tally.compliant, expected.compliant);
+    QCOMPARE(tally.helmetMissing, expected.helmetMissing);
+    QCOMPARE(tally.vestMissing, expected.vestMissing);
+    QCOMPARE(tally.bothMissing, expected.bothMissing);
+    QCOMPARE(tally.total(), quint32(count));
+    QCOMPARE(tally.violations(), quint32(count) - tally.compliant);
+
+    // 카메라별 누적
+    PpeTally sum;
+    sum += tally;
+    sum += tally;
+    QCOMPARE(sum.total(), quint32(count * 2));
+    QCOMPARE(sum.bothMissing, tally.bothMissing * 2);
+}
+
+void TestPpeClassifier::emptyBatch()
+{
+    const PpeTally tally = PpeClassifier::classify(nullptr, nullptr, nullptr, 0, nullptr);
+    QCOMPARE(tally.total(), quint32(0));
+}
+
+void TestPpeClassifier::logEventMapping()
+{
+    QCOMPARE(PpeClassifier::logEvent(PpeResult::Compliant), LogEvent::PpeCompliant);
+    QCOMPARE(PpeClassifier::logEvent(PpeResult::HelmetMissing), LogEvent::HelmetMissing);
+    QCOMPARE(PpeClassifier::logEvent(PpeResult::VestMissing), LogEvent::VestMissing);
+    QCOMPARE(PpeClassifier::logEvent(PpeResult::BothMissing), LogEvent::PpeMissing);
+    QVERIFY(!PpeClassifier::isViolation(PpeResult::Compliant));
+    QVERIFY(PpeClassifier::isViolation(PpeResult::VestMissing));
+}
+
+QTEST_GUILESS_MAIN(TestPpeClassifier)
+#include "tst_ppeclassifier.moc"
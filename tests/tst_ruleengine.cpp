@@ -0,0 +1,139 @@
+#include "ruleengine.h"
+
+#include <QtTest>
+
+// 에스컬레이션 규칙 - "T초 내 N회" 슬라이딩 윈도우, 발동 후 재집계, 재알림 억제, 카메라 전용 규칙
+class TestRuleEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firesAfterThresholdWithinWindow();
+    void slidesWindow();
+    void cooldownSuppressesRefire();
+    void thresholdOneWithoutWindow();
+    void cameraRuleOverridesDefault();
+    void eventsWithoutRuleNeverFire();
+    void camerasAreIndependent();
+
+private:
+    static RuleEngine::Rule rule(RuleEngine::Event event, int threshold, qint64 windowMs, qint64 cooldownMs,
+                                 const QString &cameraIp = QString());
+};
+
+RuleEngine::Rule TestRuleEngine::rule(RuleEngine::Event event, int threshold, qint64 windowMs, qint64 cooldownMs,
+                                      const QString &cameraIp)
+{
+    RuleEngine::Rule r;
+    r.event = event;
+    r.threshold = threshold;
+    r.windowMs = windowMs;
+    r.cooldownMs = cooldownMs;
+    r.cameraIp = cameraIp;
+    return r;
+}
+
+void TestRuleEngine::firesAfterThresholdWithinWindow()
+{
+    RuleEngine engine;
+    engine.setRules({ rule(RuleEngine::Event::Ppe, 3, 1000, 0) });
+
+    RuleEngine::Escalation escalation;
+    QVERIFY(!engine.record("10.0.0.1", RuleEngine::Event::Ppe, 0, &escalation));
+    QVERIFY(!engine.record("10.0.0.1", RuleEngine::Event::Ppe, 400, &escalation));
+    QVERIFY(engine.record("10.0.0.1", RuleEngine::Event::Ppe, 900, &escalation));
+    QCOMPARE(escalation.cameraIp, QString("10.0.0.1"));
+    QCOMPARE(escalation.event, RuleEngine::Event::Ppe);
+    QCOMPARE(escalation.count, 3);
+    QCOMPARE(escalation.windowMs, qint64(1000));
+
+    // 발동 후에는 다시 N회를 모아야 함
+    QVERIFY(!engine.record("10.0.0.1", RuleEngine::Event::Ppe, 950));
+    QVERIFY(!engine.record("10.0.0.1", RuleEngine::Event::Ppe, 960));
+    QVERIFY(engine.record("10.0.0.1", RuleEngine::Event::Ppe, 970));
+}
+
+void TestRuleEngine::slidesWindow()
+{
+    RuleEngine engine;
+    engine.setRules({ rule(RuleEngine::Event::Trespass, 3, 1000, 0) });
+
+    // 0 / 600 / 1200 - 가장 오래된 기록이 윈도우 밖
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Trespass, 0));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Trespass, 600));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Trespass, 1200));
+    // 600 / 1200 / 1600 - 윈도우 안 (경계 포함)
+    QVERIFY(engine.record("cam", RuleEngine::Event::Trespass, 1600));
+}
+
+void TestRuleEngine::cooldownSuppressesRefire()
+{
+    RuleEngine engine;
+    engine.setRules({ rule(RuleEngine::Event::Ppe, 3, 1000, 5000) });
+
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 0));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 100));
+    QVERIFY(engine.record("cam", RuleEngine::Event::Ppe, 200));
+
+    // 다시 3회가 모여도 재알림 억제 기간 (200 + 5000) 안이면 발동하지 않음
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 300));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 400));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 500));
+
+    // 억제가 끝난 뒤에도 윈도우 안의 최근 3회가 있어야 발동
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 6000));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Ppe, 6100));
+    QVERIFY(engine.record("cam", RuleEngine::Event::Ppe, 6200));
+}
+
+void TestRuleEngine::thresholdOneWithoutWindow()
+{
+    RuleEngine engine;  // 기본 규칙 - 낙상은 1회 즉시, 10초 재알림 억제
+    QVERIFY(engine.record("cam", RuleEngine::Event::Fall, 1000));
+    QVERIFY(!engine.record("cam", RuleEngine::Event::Fall, 5000));
+    QVERIFY(engine.record("cam", RuleEngine::Event::Fall, 11000));
+}
+
+void TestRuleEngine::cameraRuleOverridesDefault()
+{
+    RuleEngine engine;
+    engine.setRules({
+        rule(RuleEngine::Event::Ppe, 3, 60000, 0),
+        rule(RuleEngine::Event::Ppe, 1, 0, 0, "10.0.0.9"),
+    });
+
+    QVERIFY(engine.record("10.0.0.9", RuleEngine::Event::Ppe, 0));
+    QVERIFY(!engine.record("10.0.0.1", RuleEngine::Event::Ppe, 0));
+
+    // 규칙을 바꾸면 윈도우 상태도 초기화
+    engine.setRules({ rule(RuleEngine::Event::Ppe, 2, 0, 0) });
+    QVERIFY(engine.cameras().isEmpty());
+    QVERIFY(!engine.record("10.0.0.9", RuleEngine::Event::Ppe, 10));
+    QVERIFY(engine.record("10.0.0.9", RuleEngine::Event::Ppe, 100000));  // 기간 제한 없음
+}
+
+void TestRuleEngine::eventsWithoutRuleNeverFire()
+{
+    RuleEngine engine;  // 기본 규칙에 이상소음 없음
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(!engine.record("cam", RuleEngine::Event::Anomaly, i * 10));
+}
+
+void TestRuleEngine::camerasAreIndependent()
+{
+    RuleEngine engine;
+    engine.setRules({ rule(RuleEngine::Event::Ppe, 2, 1000, 0) });
+
+    QVERIFY(!engine.record("a", RuleEngine::Event::Ppe, 0));
+    QVERIFY(!engine.record("b", RuleEngine::Event::Ppe, 10));
+    QVERIFY(engine.record("a", RuleEngine::Event::Ppe, 20));
+    QCOMPARE(engine.cameras().size(), 2);
+
+    // 삭제된 카메라는 상태가 사라져 처음부터 다시 집계
+    engine.removeCamera("b");
+    QCOMPARE(engine.cameras(), QStringList({ "a" }));
+    QVERIFY(!engine.record("b", RuleEngine::Event::Ppe, 30));
+}
+
+QTEST_GUILESS_MAIN(TestRuleEngine)
+#include "tst_ruleengine.moc"
@@ -0,0 +1,149 @@
+#include "serverevents.h"
+
+#include <QtTest>
+
+#include <memory_resource>
+#include <string_view>
+
+// 스키마 디코더 - 필드 채우기, 누락/타입 불일치 집계, scope 지정, SchemaStats 첫 불일치 보고
+class TestServerEvents : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decodesDetection();
+    void countsMissingAndWrongType();
+    void nullCountsAsMissing();
+    void optionalFieldsMayBeAbsent();
+    void decodesTopLevelScope();
+    void statsReportFirstMismatchOnce();
+};
+
+namespace {
+
+QString str(std::string_view view)
+{
+    return EventFrame::toQString(view);
+}
+
+} // namespace
+
+void TestServerEvents::decodesDetection()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(frame.parse(R"({"type":"new_detection","data":{"person_count":3,"helmet_count":2,"safety_vest_count":3,)"
+                        R"("avg_confidence":0.875,"image_path":"/img/a.jpg","timestamp":"2025-01-02 03:04:05","extra":1}})"));
+
+    DecodeReport report;
+    const DetectionEvent event = decodeEvent<DetectionEvent>(frame, &report);
+    QVERIFY(report.ok());
+    QCOMPARE(event.personCount, 3);
+    QCOMPARE(event.helmetCount, 2);
+    QCOMPARE(event.vestCount, 3);
+    QCOMPARE(event.confidence, 0.875);
+    QCOMPARE(str(event.imagePath), QString("/img/a.jpg"));
+    QCOMPARE(str(event.timestamp), QString("2025-01-02 03:04:05"));
+}
+
+void TestServerEvents::countsMissingAndWrongType()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    // helmet_count 없음, safety_vest_count는 문자열, person_count는 int 범위 밖
+    QVERIFY(frame.parse(R"({"data":{"person_count":4294967296,"safety_vest_count":"2",)"
+                        R"("avg_confidence":0.5,"timestamp":"t"}})"));
+
+    DecodeReport report;
+    const DetectionEvent event = decodeEvent<DetectionEvent>(frame, &report);
+    QVERIFY(!report.ok());
+    QCOMPARE(int(report.missing), 1);
+    QCOMPARE(int(report.wrongType), 2);
+    // 불일치 필드는 기본값 유지, 나머지는 채워짐
+    QCOMPARE(event.personCount, 0);
+    QCOMPARE(event.vestCount, 0);
+    QCOMPARE(event.confidence, 0.5);
+
+    // 다시 디코딩하면 report는 새로 시작
+    QVERIFY(frame.parse(R"({"data":{"count":2,"timestamp":"t"}})"));
+    const CountEvent count = decodeEvent<CountEvent>(frame, &report);
+    QVERIFY(report.ok());
+    QCOMPARE(count.count, 2);
+}
+
+void TestServerEvents::nullCountsAsMissing()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(frame.parse(R"({"data":{"count":null,"timestamp":"t"}})"));
+
+    DecodeReport report;
+    decodeEvent<CountEvent>(frame, &report);
+    QCOMPARE(int(report.missing), 1);
+    QCOMPARE(int(report.wrongType), 0);
+}
+
+void TestServerEvents::optionalFieldsMayBeAbsent()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+    QVERIFY(frame.parse(R"({"data":{"status":"detected"}})"));
+
+    DecodeReport report;
+    const AnomalyEvent event = decodeEvent<AnomalyEvent>(frame, &report);
+    QVERIFY(report.ok());
+    QCOMPARE(str(event.status), QString("detected"));
+    QVERIFY(event.timestamp.empty());
+
+    // 선택 필드도 타입이 다르면 불일치
+    QVERIFY(frame.parse(R"({"data":{"status":"cleared","timestamp":5}})"));
+    decodeEvent<AnomalyEvent>(frame, &report);
+    QCOMPARE(int(report.missing), 0);
+    QCOMPARE(int(report.wrongType), 1);
+}
+
+void TestServerEvents::decodesTopLevelScope()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    EventFrame frame(&arena);
+
+    // mode_change_ack는 최상위 필드 (data에 같은 이름이 있어도 보지 않음)
+    QVERIFY(frame.parse(R"({"type":"mode_change_ack","status":"ok","mode":"blur","data":{"mode":"raw"}})"));
+    DecodeReport report;
+    const ModeAckEvent ack = decodeEvent<ModeAckEvent>(frame, &report);
+    QVERIFY(report.ok());
+    QCOMPARE(str(ack.mode), QString("blur"));
+    QVERIFY(ack.message.empty());
+
+    // REST /api/detections 원소는 필드가 최상위 - scope 지정
+    QVERIFY(frame.parse(R"({"person_count":1,"helmet_count":1,"safety_vest_count":0,"avg_confidence":1,"timestamp":"t"})"));
+    const DetectionEvent row = decodeEvent<DetectionEvent>(frame, &report, EventFrame::Scope::Top);
+    QVERIFY(report.ok());
+    QCOMPARE(row.personCount, 1);
+    QCOMPARE(row.confidence, 1.0);
+
+    decodeEvent<DetectionEvent>(frame, &report);  // 기본 scope(data)로는 전부 누락
+    QCOMPARE(int(report.missing), 5);
+}
+
+void TestServerEvents::statsReportFirstMismatchOnce()
+{
+    SchemaStats stats;
+    DecodeReport ok;
+    DecodeReport bad;
+    bad.missing = 2;
+    bad.wrongType = 1;
+
+    QVERIFY(!stats.add(ok));
+    QVERIFY(stats.add(bad));   // 첫 불일치만 true (경고 한 번)
+    QVERIFY(!stats.add(bad));
+    QVERIFY(!stats.add(ok));
+
+    QCOMPARE(stats.decoded, quint64(4));
+    QCOMPARE(stats.mismatched, quint64(2));
+    QCOMPARE(stats.missingFields, quint64(4));
+    QCOMPARE(stats.wrongTypes, quint64(2));
+}
+
+QTEST_GUILESS_MAIN(TestServerEvents)
+#include "tst_serverevents.moc"
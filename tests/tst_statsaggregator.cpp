@@ -0,0 +1,145 @@
+#include "statsaggregator.h"
+
+#include <QtTest>
+
+// 카메라별 통계 - 분/시간 버킷 누적, 링 회전 시 초기화, 링보다 오래된 로그는 합계만, 이상소음 지속 시간
+class TestStatsAggregator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void ignoresUntimedEntries();
+    void countsIntoCurrentBuckets();
+    void minuteRingRollsOver();
+    void oldEntriesCountOnlyInTotal();
+    void tracksAnomalyDuration();
+    void summariesSortedByCamera();
+
+private:
+    static LogEntry entry(quint16 cameraId, qint64 timestampMs, LogEvent event,
+                          LogFunction function = LogFunction::Fall, float confidence = 0.0f);
+};
+
+namespace {
+
+constexpr qint64 MinuteMs = 60 * 1000;
+constexpr qint64 HourMs = 60 * MinuteMs;
+constexpr qint64 Base = 1000 * HourMs;  // 시간/분 경계 - 분 링 슬롯 0
+
+} // namespace
+
+LogEntry TestStatsAggregator::entry(quint16 cameraId, qint64 timestampMs, LogEvent event,
+                                    LogFunction function, float confidence)
+{
+    LogEntry e;
+    e.cameraId = cameraId;
+    e.timestampMs = timestampMs;
+    e.event = event;
+    e.function = function;
+    e.confidence = confidence;
+    return e;
+}
+
+void TestStatsAggregator::ignoresUntimedEntries()
+{
+    StatsAggregator stats;
+    stats.record(entry(1, 0, LogEvent::Fall));
+    QCOMPARE(stats.recordedCount(), quint64(0));
+    QCOMPARE(stats.cameraCount(), qsizetype(0));
+}
+
+void TestStatsAggregator::countsIntoCurrentBuckets()
+{
+    StatsAggregator stats;
+    stats.record(entry(1, Base + 1000, LogEvent::HelmetMissing, LogFunction::PPE, 0.5f));
+    stats.record(entry(1, Base + 2000, LogEvent::PpeCompliant, LogFunction::PPE, 0.75f));
+    stats.record(entry(1, Base + 3000, LogEvent::Fall));
+    stats.record(entry(1, Base + 4000, LogEvent::Trespass, LogFunction::Night));
+
+    const QVector<StatsAggregator::Summary> summaries = stats.summaries(Base + 30 * 1000);
+    QCOMPARE(summaries.size(), qsizetype(1));
+    const StatsAggregator::Summary &summary = summaries.first();
+    QCOMPARE(summary.cameraId, quint16(1));
+    QCOMPARE(summary.total, quint64(4));
+    QCOMPARE(summary.lastHour.ppeDetections, quint32(2));
+    QCOMPARE(summary.lastHour.ppeViolations, quint32(1));
+    QCOMPARE(summary.lastHour.falls, quint32(1));
+    QCOMPARE(summary.lastHour.trespass, quint32(1));
+    QCOMPARE(summary.lastHour.meanConfidence(), 0.625);
+    QCOMPARE(summary.lastHour.functions[int(LogFunction::PPE)], quint32(2));
+    QCOMPARE(summary.lastHour.functions[int(LogFunction::Night)], quint32(1));
+    QCOMPARE(summary.lastDay.ppeDetections, quint32(2));
+    QCOMPARE(summary.lastDay.falls, quint32(1));
+}
+
+void TestStatsAggregator::minuteRingRollsOver()
+{
+    StatsAggregator stats;
+    stats.record(entry(1, Base, LogEvent::Fall));
+    stats.record(entry(1, Base + 59 * MinuteMs, LogEvent::Fall));
+
+    QCOMPARE(stats.summaries(Base + 59 * MinuteMs).first().lastHour.falls, quint32(2));
+
+    // 60분이 지나면 첫 분 버킷은 최근 1시간 합에서 빠짐 (최근 24시간에는 남음)
+    StatsAggregator::Summary summary = stats.summaries(Base + 60 * MinuteMs).first();
+    QCOMPARE(summary.lastHour.falls, quint32(1));
+    QCOMPARE(summary.lastDay.falls, quint32(2));
+
+    // 같은 슬롯에 새 구간이 들어오면 그 자리에서 초기화
+    stats.record(entry(1, Base + 60 * MinuteMs, LogEvent::Fall));
+    summary = stats.summaries(Base + 60 * MinuteMs).first();
+    QCOMPARE(summary.lastHour.falls, quint32(2));
+    QCOMPARE(summary.lastDay.falls, quint32(3));
+    QCOMPARE(summary.total, quint64(3));
+}
+
+void TestStatsAggregator::oldEntriesCountOnlyInTotal()
+{
+    StatsAggregator stats;
+    const qint64 now = Base + 2 * HourMs;
+    stats.record(entry(1, now, LogEvent::Fall));
+
+    // 동기화로 늦게 들어온 2시간 전 로그 - 분 링의 같은 슬롯(최신 구간)을 덮어쓰지 않고 시간 버킷에만
+    stats.record(entry(1, Base, LogEvent::Fall));
+    // 25시간 전 로그 - 어느 링에도 잡히지 않음
+    stats.record(entry(1, now - 25 * HourMs, LogEvent::Fall));
+
+    const StatsAggregator::Summary summary = stats.summaries(now).first();
+    QCOMPARE(summary.lastHour.falls, quint32(1));
+    QCOMPARE(summary.lastDay.falls, quint32(2));
+    QCOMPARE(summary.total, quint64(3));
+    QCOMPARE(stats.recordedCount(), quint64(3));
+}
+
+void TestStatsAggregator::tracksAnomalyDuration()
+{
+    StatsAggregator stats;
+    stats.record(entry(2, Base, LogEvent::AnomalyDetected, LogFunction::Sound));
+    stats.record(entry(2, Base + 1000, LogEvent::AnomalyDetected, LogFunction::Sound));  // 진행 중 - 새 건 아님
+    QCOMPARE(stats.summaries(Base + 2000).first().anomalySinceMs, Base);
+
+    stats.record(entry(2, Base + 5000, LogEvent::AnomalyCleared, LogFunction::Sound));
+    stats.record(entry(2, Base + 6000, LogEvent::AnomalyCleared, LogFunction::Sound));  // 이미 해제됨
+
+    const StatsAggregator::Summary summary = stats.summaries(Base + 10000).first();
+    QCOMPARE(summary.anomalySinceMs, qint64(0));
+    QCOMPARE(summary.lastHour.anomalies, quint32(1));
+    QCOMPARE(summary.lastHour.anomalyMs, quint64(5000));
+    QCOMPARE(summary.total, quint64(4));
+}
+
+void TestStatsAggregator::summariesSortedByCamera()
+{
+    StatsAggregator stats;
+    for (quint16 id : { 3, 1, 2 })
+        stats.record(entry(id, Base, LogEvent::Fall));
+
+    const QVector<StatsAggregator::Summary> summaries = stats.summaries(Base);
+    QCOMPARE(stats.cameraCount(), qsizetype(3));
+    QCOMPARE(summaries.size(), qsizetype(3));
+    for (int i = 0; i < summaries.size(); ++i)
+        QCOMPARE(summaries.at(i).cameraId, quint16(i + 1));
+}
+
+QTEST_GUILESS_MAIN(TestStatsAggregator)
+#include "tst_statsaggregator.moc"
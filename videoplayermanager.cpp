@@ -1,96 +1,642 @@
 #include "videoplayermanager.h"
-#include <QLabel>
+#include <QVBoxLayout>
+#include <QVideoSink>
+#include <QBuffer>
+#include <QDateTime>
+#include <QTimer>
+#include <QImage>
+
+#include <memory>
+
+namespace {
+
+QByteArray encodeJpeg(const QImage &image, int quality)
+{
+    QByteArray jpeg;
+    if (!image.isNull()) {
+        QBuffer out(&jpeg);
+        out.open(QIODevice::WriteOnly);
+        image.save(&out, "JPEG", quality);
+    }
+    return jpeg;
+}
+
+// 매핑 가능한 RGB 계열 프레임은 매핑된 메모리를 그대로 QImage로 감싸 압축 (복사 없음)
+// 그 외 (YUV 등)는 QVideoFrame::toImage 변환
+QByteArray encodeJpeg(QVideoFrame frame, int quality)
+{
+    const QImage::Format format = QVideoFrameFormat::imageFormatFromPixelFormat(frame.pixelFormat());
+    if (format != QImage::Format_Invalid && frame.map(QVideoFrame::ReadOnly)) {
+        const QByteArray jpeg = encodeJpeg(QImage(frame.bits(0), frame.width(), frame.height(),
+                                                  frame.bytesPerLine(0), format), quality);
+        frame.unmap();
+        return jpeg;
+    }
+    return encodeJpeg(frame.toImage(), quality);
+}
+
+} // namespace
 
 VideoPlayerManager::VideoPlayerManager(QObject *parent)
     : QObject(parent)
 {
+    pool = new PlayerPool(MaxLivePlayers + 1, this);  // +1: ONVIF 뷰
+
+    // 정리 중이던 플레이어가 반환되면 플레이어 없는 타일을 다시 채움
+    connect(pool, &PlayerPool::capacityAvailable, this, [this]() { bindPage(false); });
+
+    // 멈춘 스트림은 해당 카메라 타일만 재연결 (다른 id - ONVIF 뷰 등 - 는 무시)
+    healthMonitor = new StreamHealthMonitor(this);
+    connect(healthMonitor, &StreamHealthMonitor::restartRequested, this, &VideoPlayerManager::restartStream);
+
+    // 포커스 모드 Pi 썸네일 - 일시정지해 두고 주기적으로 한 프레임씩만 갱신
+    thumbnailTimer = new QTimer(this);
+    thumbnailTimer->setInterval(ThumbnailRefreshMs);
+    connect(thumbnailTimer, &QTimer::timeout, this, &VideoPlayerManager::refreshThumbnails);
 }
 
 VideoPlayerManager::~VideoPlayerManager()
 {
     clearPlayers();
+    snapshotPool.waitForDone();
 }
 
 void VideoPlayerManager::clearPlayers()
 {
-    for (QMediaPlayer* player : players) {
-        player->stop();
-        delete player;
-    }
-    players.clear();
+    for (VideoTile &tile : tiles)
+        releasePlayer(tile);
 
-    for (QVideoWidget* widget : videoWidgets) {
-        delete widget;
+    for (VideoTile &tile : tiles) {
+        if (tile.frame)
+            tile.frame->deleteLater();
     }
-    videoWidgets.clear();
+    tiles.clear();
+    layoutDirty = true;
 }
 
 void VideoPlayerManager::setupVideoGrid(QGridLayout *layout, const QVector<CameraInfo> &cameraList, const QString &streamSuffix)
 {
+    if (gridLayout != layout) {
+        gridLayout = layout;
+        layoutDirty = true;
+    }
+    cameras = cameraList;
+    this->streamSuffix = streamSuffix;
+
+    if (layoutDirty)
+        buildTiles();
+
+    // 카메라 수가 줄었으면 페이지 범위 보정
+    currentPage = qBound(0, currentPage, pageCount() - 1);
+    bindPage(false);
+    emit pageChanged(currentPage, pageCount());
+}
+
+void VideoPlayerManager::restartStream(const QString &ip)
+{
+    for (VideoTile &tile : tiles) {
+        if (!tile.player || tile.cameraIp != ip)
+            continue;
+        tile.player->stop();
+        tile.player->setSource(QUrl(tile.url));
+        tile.player->play();
+        tile.awaitingFirstFrame = true;
+        tile.refreshing = tile.throttled;  // 썸네일은 첫 프레임 후 다시 일시정지
+        healthMonitor->watch(ip);  // 재연결 동안은 멈춤으로 보지 않음 (이미 멈춤 상태면 유지)
+    }
+}
+
+void VideoPlayerManager::setOnvifClient(OnvifClient *client)
+{
+    onvifClient = client;
+    if (!onvifClient)
+        return;
+
+    connect(onvifClient, &OnvifClient::profilesReady, this, [this](const QString &ip) {
+        onvifErrors.remove(ip);
+        bindPage(false);
+    });
+
+    // 조회 실패는 타일에 표시하고 백오프가 끝나면 다시 바인딩 (그때 streamUrl이 재조회)
+    // PreciseTimer - 일반 타이머는 일찍 울릴 수 있어 백오프 안쪽이면 discover가 무시됨
+    connect(onvifClient, &OnvifClient::discoveryFailed, this, [this](const QString &ip, const QString &error) {
+        onvifErrors.insert(ip, error);
+        bindPage(false);
+        QTimer::singleShot(onvifClient->retryDelayMs(ip), Qt::PreciseTimer, this, [this]() { bindPage(false); });
+    });
+}
+
+void VideoPlayerManager::setGridLayout(int rows, int columns)
+{
+    rows = qBound(1, rows, 8);
+    columns = qBound(1, columns, 8);
+    if (rows == this->rows && columns == this->columns)
+        return;
+
+    // 현재 페이지 첫 카메라가 새 레이아웃에서도 보이도록 페이지 환산
+    const int firstIndex = currentPage * this->rows * this->columns;
+    this->rows = rows;
+    this->columns = columns;
+    currentPage = firstIndex / (rows * columns);
+
+    layoutDirty = true;
+    if (gridLayout) {
+        buildTiles();
+        currentPage = qBound(0, currentPage, pageCount() - 1);
+        bindPage(false);
+    }
+    emit pageChanged(currentPage, pageCount());
+}
+
+void VideoPlayerManager::setGridWidth(int width)
+{
+    if (width <= 0 || width == gridWidth)
+        return;
+    gridWidth = width;
+    layoutDirty = true;
+}
+
+void VideoPlayerManager::setPage(int page)
+{
+    page = qBound(0, page, pageCount() - 1);
+    if (page == currentPage)
+        return;
+
+    currentPage = page;
+    bindPage(false);  // 타일은 그대로 두고 카메라만 다시 바인딩
+    emit pageChanged(currentPage, pageCount());
+}
+
+int VideoPlayerManager::pageCount() const
+{
+    if (focusMode)
+        return 1;  // 포커스 모드는 한 화면 (주 화면 + 썸네일)
+    const int perPage = rows * columns;
+    return qMax(1, static_cast<int>((cameras.size() + perPage - 1) / perPage));
+}
+
+void VideoPlayerManager::buildTiles()
+{
+    if (!gridLayout)
+        return;
+
     // 기존 레이아웃 초기화
+    for (VideoTile &tile : tiles)
+        releasePlayer(tile);
+    tiles.clear();
+
     QLayoutItem *child;
-    while ((child = layout->takeAt(0)) != nullptr) {
+    while ((child = gridLayout->takeAt(0)) != nullptr) {
         if (child->widget())
             child->widget()->deleteLater();
         delete child;
     }
 
-    clearPlayers();
+    // 타일 배치 (행, 열, 행 span, 열 span) - 일반: rows x columns 균등, 포커스: 주 화면 + 오른쪽/아래 썸네일
+    struct Placement { int row, column, rowSpan, columnSpan; };
+    QVector<Placement> placements;
+    int cellColumns = columns;
+    int cellRows = rows;
+    if (focusMode) {
+        cellColumns = cellRows = FocusGridCells;
+        const int primary = FocusGridCells - 1;
+        placements.append({ 0, 0, primary, primary });
+        for (int r = 0; r < FocusGridCells; ++r)
+            placements.append({ r, primary, 1, 1 });
+        for (int c = 0; c < primary; ++c)
+            placements.append({ primary, c, 1, 1 });
+    } else {
+        for (int i = 0; i < rows * columns; ++i)
+            placements.append({ i / columns, i % columns, 1, 1 });
+    }
 
-    int total = std::max(4, static_cast<int>(cameraList.size()));
-    int columns = 2;
-    int rows = (total + 1) / 2;
-
-    for (int i = 0; i < total; ++i) {
-        QWidget *videoFrame = new QWidget();
-        videoFrame->setFixedSize(320, 240);
-        videoFrame->setStyleSheet("background-color: black;");
-
-        if (i < cameraList.size()) {
-            QLabel *nameLabel = new QLabel(cameraList[i].name, videoFrame);
-            nameLabel->setStyleSheet("color: white; font-weight: bold; background-color: rgba(0,0,0,100); padding: 2px;");
-            nameLabel->move(5, 5);
-            nameLabel->show();
-
-            QVideoWidget *vw = new QVideoWidget(videoFrame);
-            vw->setGeometry(0, 0, 320, 240);
-            vw->lower();
-
-            QMediaPlayer *player = new QMediaPlayer(this);
-            player->setVideoOutput(vw);
-
-            QString url = QString("rtsps://%1:%2/%3")
-                              .arg(cameraList[i].ip)
-                              .arg(cameraList[i].port)
-                              .arg(streamSuffix);
-            player->setSource(QUrl(url));
-            player->play();
-
-            players.append(player);
-            videoWidgets.append(vw);
-        } else {
-            QVBoxLayout *noCamLayout = new QVBoxLayout(videoFrame);
-            QLabel *noCam = new QLabel("No Camera");
-            noCam->setAlignment(Qt::AlignCenter);
-            noCam->setStyleSheet("color: white;");
-            noCamLayout->addWidget(noCam);
-            videoFrame->setLayout(noCamLayout);
+    const int spacing = gridLayout->spacing();
+    const int cellWidth = (gridWidth - spacing * (cellColumns - 1)) / cellColumns;
+    const int cellHeight = cellWidth * 3 / 4;
+
+    for (int i = 0; i < placements.size(); ++i) {
+        const Placement &place = placements.at(i);
+        const int tileWidth = cellWidth * place.columnSpan + spacing * (place.columnSpan - 1);
+        const int tileHeight = cellHeight * place.rowSpan + spacing * (place.rowSpan - 1);
+
+        VideoTile tile;
+        tile.size = QSize(tileWidth, tileHeight);
+
+        tile.frame = new QWidget();
+        tile.frame->setFixedSize(tileWidth, tileHeight);
+        tile.frame->setStyleSheet("background-color: black;");
+
+        tile.videoWidget = new QVideoWidget(tile.frame);
+        tile.videoWidget->setGeometry(0, 0, tileWidth, tileHeight);
+        tile.videoWidget->lower();
+
+        tile.nameLabel = new QLabel(tile.frame);
+        tile.nameLabel->setStyleSheet("color: white; font-weight: bold; background-color: rgba(0,0,0,100); padding: 2px;");
+        tile.nameLabel->move(5, 5);
+
+        tile.activityBorder = new QWidget(tile.frame);
+        tile.activityBorder->setGeometry(0, 0, tileWidth, tileHeight);
+        tile.activityBorder->setAttribute(Qt::WA_TransparentForMouseEvents);
+        tile.activityBorder->setAttribute(Qt::WA_StyledBackground);
+        tile.activityBorder->hide();
+
+        QVBoxLayout *noCamLayout = new QVBoxLayout(tile.frame);
+        tile.placeholder = new QLabel("No Camera");
+        tile.placeholder->setAlignment(Qt::AlignCenter);
+        tile.placeholder->setStyleSheet("color: white;");
+        noCamLayout->addWidget(tile.placeholder);
+
+        // 프레임 탭 - 재생 중인 디코더의 출력을 그대로 관찰 (추가 디코딩 없음)
+        QVideoWidget *widget = tile.videoWidget;
+        connect(widget->videoSink(), &QVideoSink::videoFrameChanged, this, [this, i, widget](const QVideoFrame &frame) {
+            onTileFrame(i, widget, frame);
+        });
+
+        gridLayout->addWidget(tile.frame, place.row, place.column, place.rowSpan, place.columnSpan);
+        tiles.append(tile);
+    }
+
+    if (QWidget *area = gridLayout->parentWidget())
+        area->setMinimumSize(cellColumns * cellWidth + spacing * (cellColumns - 1),
+                             cellRows * cellHeight + spacing * (cellRows - 1));
+
+    layoutDirty = false;
+}
+
+void VideoPlayerManager::bindPage(bool forceRestart)
+{
+    const QVector<const CameraInfo*> targets = tileCameras();
+
+    // 다른 타일로 옮겨 가는 카메라(포커스 승격, 페이지 이동)는 재연결 없이 플레이어째 이동
+    if (!forceRestart) {
+        QVector<QString> urls(tiles.size());
+        for (int i = 0; i < tiles.size(); ++i)
+            urls[i] = targets[i] ? streamUrl(*targets[i], tiles[i].size) : QString();
+        for (int i = 0; i < tiles.size(); ++i) {
+            if (!urls[i].isEmpty() && tiles[i].url != urls[i])
+                adoptPlayer(i, urls);
         }
+    }
+
+    for (int i = 0; i < tiles.size(); ++i)
+        bindTile(tiles[i], targets[i], forceRestart);
 
-        layout->addWidget(videoFrame, i / columns, i % columns);
+    // Pi 카메라는 서브스트림이 없어 썸네일도 전체 해상도 스트림 - 썸네일 디코딩은 주기적 한 프레임으로 제한
+    // (ONVIF 썸네일은 streamUrl이 작은 프로파일을 고름)
+    bool anyThrottled = false;
+    for (int i = 0; i < tiles.size(); ++i) {
+        setTileThrottled(tiles[i], focusMode && i > 0 && targets[i] && !targets[i]->isOnvif());
+        anyThrottled = anyThrottled || tiles[i].throttled;
     }
+    if (!anyThrottled)
+        thumbnailTimer->stop();
+    else if (!thumbnailTimer->isActive())
+        thumbnailTimer->start();
 }
 
-void VideoPlayerManager::switchStreamForAllPlayers(const QVector<CameraInfo> &cameraList, const QString &suffix)
+void VideoPlayerManager::setTileThrottled(VideoTile &tile, bool throttled)
 {
-    for (int i = 0; i < cameraList.size() && i < players.size(); ++i) {
-        QString streamUrl = QString("rtsps://%1:%2/%3")
-        .arg(cameraList[i].ip)
-            .arg(cameraList[i].port)
-            .arg(suffix);
+    tile.throttled = throttled && tile.player;
+    if (!tile.player) {
+        tile.refreshing = false;
+        return;
+    }
 
-        players[i]->stop();
-        players[i]->setSource(QUrl(streamUrl));
-        players[i]->play();
+    if (tile.throttled) {
+        // 재생 중이면 (새 바인딩, 주 화면에서 내려옴) 다음 프레임을 받은 뒤 일시정지
+        tile.refreshing = tile.player->playbackState() != QMediaPlayer::PausedState;
+    } else {
+        // 주 화면/일반 그리드 - 썸네일에서 넘겨받은 플레이어면 다시 전체 재생
+        tile.refreshing = false;
+        if (tile.player->playbackState() == QMediaPlayer::PausedState)
+            tile.player->play();
     }
 }
+
+void VideoPlayerManager::refreshThumbnails()
+{
+    for (VideoTile &tile : tiles) {
+        if (!tile.throttled || !tile.player || tile.refreshing)
+            continue;
+        tile.refreshing = true;
+        tile.player->play();
+    }
+}
+
+QVector<const CameraInfo*> VideoPlayerManager::tileCameras() const
+{
+    QVector<const CameraInfo*> targets(tiles.size(), nullptr);
+    if (tiles.isEmpty())
+        return targets;
+
+    if (!focusMode) {
+        const int first = currentPage * rows * columns;
+        for (int i = 0; i < tiles.size() && first + i < cameras.size(); ++i)
+            targets[i] = &cameras.at(first + i);
+        return targets;
+    }
+
+    // 포커스 - 0번 타일이 주 화면, 나머지 카메라는 목록 순서로 썸네일
+    const CameraInfo *focused = cameras.isEmpty() ? nullptr : &cameras.first();
+    for (const CameraInfo &camera : cameras) {
+        if (camera.ip == focusedIp) {
+            focused = &camera;
+            break;
+        }
+    }
+    targets[0] = focused;
+
+    int next = 1;
+    for (const CameraInfo &camera : cameras) {
+        if (next >= tiles.size())
+            break;
+        if (&camera != focused)
+            targets[next++] = &camera;
+    }
+    return targets;
+}
+
+void VideoPlayerManager::adoptPlayer(int index, const QVector<QString> &urls)
+{
+    for (int j = 0; j < tiles.size(); ++j) {
+        // 그 타일이 계속 재생할 스트림이면 가져오지 않음
+        if (j == index || !tiles[j].player || tiles[j].url != urls[index] || tiles[j].url == urls[j])
+            continue;
+
+        VideoTile &to = tiles[index];
+        VideoTile &from = tiles[j];
+        std::swap(to.player, from.player);
+        std::swap(to.url, from.url);
+        std::swap(to.cameraIp, from.cameraIp);
+        std::swap(to.lastFrame, from.lastFrame);
+        std::swap(to.awaitingFirstFrame, from.awaitingFirstFrame);
+        to.player->setVideoOutput(to.videoWidget);
+        if (from.player)
+            from.player->setVideoOutput(from.videoWidget);
+        from.activityBorder->hide();
+        return;
+    }
+}
+
+void VideoPlayerManager::setFocusMode(bool enabled)
+{
+    if (enabled == focusMode)
+        return;
+
+    focusMode = enabled;
+    focusHoldUntilMs = 0;
+    currentPage = 0;
+    layoutDirty = true;
+    if (gridLayout) {
+        buildTiles();
+        bindPage(false);
+    }
+    emit pageChanged(currentPage, pageCount());
+}
+
+void VideoPlayerManager::focusCamera(const QString &ip, FocusReason reason)
+{
+    if (!focusMode)
+        return;
+
+    bool known = false;
+    for (const CameraInfo &camera : cameras)
+        known = known || camera.ip == ip;
+    if (!known)
+        return;
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (ip == focusedIp) {
+        // 같은 카메라 - 유지 시간만 연장
+        focusHoldUntilMs = nowMs + FocusHoldMs;
+        focusReason = qMax(focusReason, reason);
+        return;
+    }
+    if (nowMs < focusHoldUntilMs && reason <= focusReason)
+        return;  // 주 화면 유지 중 - 잦은 전환 방지
+
+    focusedIp = ip;
+    focusReason = reason;
+    focusHoldUntilMs = nowMs + FocusHoldMs;
+    bindPage(false);
+    emit focusChanged(ip);
+}
+
+void VideoPlayerManager::bindTile(VideoTile &tile, const CameraInfo *camera, bool forceRestart)
+{
+    if (!camera) {
+        releasePlayer(tile);
+        tile.nameLabel->hide();
+        tile.videoWidget->hide();
+        tile.placeholder->setText("No Camera");
+        tile.placeholder->show();
+        return;
+    }
+
+    tile.nameLabel->setText(camera->name);
+    tile.nameLabel->adjustSize();
+    tile.nameLabel->show();
+    tile.nameLabel->raise();
+
+    const QString url = streamUrl(*camera, tile.size);
+    if (url.isEmpty()) {
+        // ONVIF 프로파일 조회 중 (또는 실패 후 재시도 대기) - profilesReady 후 다시 바인딩
+        releasePlayer(tile);
+        tile.videoWidget->hide();
+        const auto error = onvifErrors.constFind(camera->ip);
+        tile.placeholder->setText(error != onvifErrors.constEnd()
+                                      ? QString("ONVIF 조회 실패\n%1\n재시도 대기 중...").arg(*error)
+                                      : QString("ONVIF 프로파일 조회 중..."));
+        tile.placeholder->show();
+        return;
+    }
+
+    if (tile.player && tile.url == url && !forceRestart)
+        return;  // 같은 카메라가 그대로 바인딩됨 - 재연결 불필요
+
+    if (!tile.player) {
+        tile.player = pool->acquire();
+        if (!tile.player) {
+            // 동시 디코더 한도 - 풀에 자리가 나면 capacityAvailable로 다시 바인딩
+            tile.videoWidget->hide();
+            tile.placeholder->setText("재생 한도 초과");
+            tile.placeholder->show();
+            return;
+        }
+        tile.player->setVideoOutput(tile.videoWidget);
+
+        // 재생 오류는 멈춤으로 바로 보고 (플레이어가 다른 타일로 옮겨 갈 수 있어 오류 시점에 타일 조회)
+        QMediaPlayer *player = tile.player;
+        connect(player, &QMediaPlayer::errorOccurred, this, [this, player](QMediaPlayer::Error, const QString &message) {
+            for (const VideoTile &t : std::as_const(tiles)) {
+                if (t.player == player && !t.cameraIp.isEmpty())
+                    healthMonitor->reportError(t.cameraIp, message);
+            }
+        });
+    }
+
+    tile.placeholder->hide();
+    tile.videoWidget->show();
+
+    tile.lastFrame = QVideoFrame();  // 이전 카메라 프레임으로 스냅샷하지 않도록
+    tile.activityBorder->hide();
+    tile.player->stop();
+    tile.player->setSource(QUrl(url));
+    tile.player->play();
+    if (!tile.cameraIp.isEmpty() && tile.cameraIp != camera->ip)
+        healthMonitor->unwatch(tile.cameraIp);
+    tile.url = url;
+    tile.cameraIp = camera->ip;
+    tile.awaitingFirstFrame = true;
+    healthMonitor->watch(camera->ip);
+}
+
+void VideoPlayerManager::onTileFrame(int index, QVideoWidget *widget, const QVideoFrame &frame)
+{
+    // 레이아웃 변경으로 삭제 대기 중인 타일의 프레임은 무시
+    if (index >= tiles.size() || tiles[index].videoWidget != widget || !frame.isValid())
+        return;
+
+    VideoTile &tile = tiles[index];
+    if (tile.awaitingFirstFrame) {
+        tile.awaitingFirstFrame = false;
+        emit firstFrame(tile.cameraIp);
+    }
+    tile.lastFrame = frame;
+    tile.lastFrameMs = QDateTime::currentMSecsSinceEpoch();
+    healthMonitor->frameArrived(tile.cameraIp);
+    emit tileFrame(tile.cameraIp, frame);
+
+    if (tile.refreshing && tile.player) {
+        tile.refreshing = false;
+        tile.player->pause();  // 썸네일 한 프레임 갱신 끝
+    }
+}
+
+void VideoPlayerManager::setTileActivity(const QString &ip, double level)
+{
+    for (VideoTile &tile : tiles) {
+        if (!tile.player || tile.cameraIp != ip)
+            continue;
+        if (level <= 0.0) {
+            tile.activityBorder->hide();
+            continue;
+        }
+        // 활동량이 클수록 두껍고 진한 주황 테두리
+        tile.activityBorder->setStyleSheet(QString("border: %1px solid rgba(255, 140, 0, %2); background: transparent;")
+                                               .arg(2 + qRound(level * 4))
+                                               .arg(qRound(80 + level * 175)));
+        tile.activityBorder->show();
+        tile.activityBorder->raise();
+        tile.nameLabel->raise();
+    }
+}
+
+void VideoPlayerManager::clearTileActivity()
+{
+    for (VideoTile &tile : tiles)
+        tile.activityBorder->hide();
+}
+
+QVideoFrame VideoPlayerManager::latestFrame(const QString &ip) const
+{
+    for (const VideoTile &tile : tiles) {
+        if (tile.player && tile.cameraIp == ip && tile.lastFrame.isValid())
+            return tile.lastFrame;
+    }
+    return QVideoFrame();
+}
+
+int VideoPlayerManager::captureSnapshots(const QStringList &ips)
+{
+    struct Batch {
+        int requested = 0;
+        int remaining = 0;
+        int succeeded = 0;
+    };
+    auto batch = std::make_shared<Batch>();
+
+    for (const VideoTile &tile : std::as_const(tiles)) {
+        if (!tile.player || !tile.lastFrame.isValid() || !ips.contains(tile.cameraIp))
+            continue;
+
+        QVideoFrame frame = tile.lastFrame;
+        QImage image;
+        // 하드웨어 프레임은 렌더링 컨텍스트가 있는 GUI 스레드에서 변환 후 압축만 작업 스레드
+        if (frame.handleType() != QVideoFrame::NoHandle) {
+            image = frame.toImage();
+            if (image.isNull())
+                continue;
+            frame = QVideoFrame();
+        }
+
+        ++batch->requested;
+        ++batch->remaining;
+        const QString ip = tile.cameraIp;
+        const qint64 capturedMs = tile.lastFrameMs;
+
+        snapshotPool.start([this, batch, frame, image, ip, capturedMs]() {
+            const QByteArray jpeg = frame.isValid() ? encodeJpeg(frame, SnapshotJpegQuality)
+                                                    : encodeJpeg(image, SnapshotJpegQuality);
+            QMetaObject::invokeMethod(this, [this, batch, ip, capturedMs, jpeg]() {
+                if (!jpeg.isEmpty())
+                    ++batch->succeeded;
+                emit snapshotReady(ip, jpeg, capturedMs);
+                if (--batch->remaining == 0)
+                    emit snapshotsFinished(batch->requested, batch->succeeded);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    if (batch->requested == 0)
+        emit snapshotsFinished(0, 0);
+    return batch->requested;
+}
+
+QStringList VideoPlayerManager::liveCameraIps() const
+{
+    QStringList ips;
+    for (const VideoTile &tile : tiles) {
+        if (tile.player)
+            ips.append(tile.cameraIp);
+    }
+    return ips;
+}
+
+void VideoPlayerManager::releasePlayer(VideoTile &tile)
+{
+    if (!tile.player)
+        return;
+
+    tile.player->disconnect(this);
+    pool->release(tile.player);  // 정지/삭제는 풀에서 비동기로
+    tile.player = nullptr;
+    healthMonitor->unwatch(tile.cameraIp);
+    tile.url.clear();
+    tile.cameraIp.clear();
+    tile.awaitingFirstFrame = false;
+    tile.throttled = false;
+    tile.refreshing = false;
+    tile.lastFrame = QVideoFrame();  // 디코더 버퍼 반환
+    tile.activityBorder->hide();
+}
+
+QString VideoPlayerManager::streamUrl(const CameraInfo &camera, const QSize &size) const
+{
+    if (camera.isOnvif()) {
+        if (!onvifClient)
+            return QString();
+        if (!onvifClient->hasProfiles(camera.ip)) {
+            onvifClient->discover(camera);
+            // 저장된 프로파일로 먼저 재생 (없으면 조회 대기)
+            return camera.preferredStreamUri.isEmpty() ? QString() : camera.onvifPlaybackUrl(camera.preferredStreamUri);
+        }
+        // 타일이 커지면 (레이아웃 변경, 포커스 승격) 더 높은 프로파일로 자동 전환
+        return camera.onvifPlaybackUrl(OnvifClient::selectProfile(onvifClient->profiles(camera.ip), size).streamUri);
+    }
+
+    return QString("rtsps://%1:%2/%3")
+        .arg(camera.ip)
+        .arg(camera.port)
+        .arg(streamSuffix);
+}
@@ -2,12 +2,21 @@
 #define VIDEOPLAYERMANAGER_H
 
 #include "camerainfo.h"
+#include "playerpool.h"
+#include "onvifclient.h"
+#include "streamhealthmonitor.h"
 
 #include <QObject>
 #include <QVector>
+#include <QHash>
 #include <QMediaPlayer>
 #include <QVideoWidget>
 #include <QGridLayout>
+#include <QLabel>
+#include <QVideoFrame>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
 
 class VideoPlayerManager : public QObject
 {
@@ -19,11 +28,115 @@ public:
 
     void clearPlayers();
     void setupVideoGrid(QGridLayout *layout, const QVector<CameraInfo> &cameraList, const QString &streamSuffix);
-    void switchStreamForAllPlayers(const QVector<CameraInfo> &cameraList, const QString &suffix);
+    void restartStream(const QString &ip);  // 해당 카메라 타일만 재연결 (모드 전환 후)
+
+    // 레이아웃 (행 x 열) - 변경 시에만 타일을 다시 만듦
+    void setGridLayout(int rows, int columns);
+    void setGridWidth(int width);  // 그리드 전체 폭 (타일 크기 계산용)
+    int gridRows() const { return rows; }
+    int gridColumns() const { return columns; }
+
+    // 페이지 - 현재 페이지의 카메라만 라이브 재생
+    void setPage(int page);
+    int page() const { return currentPage; }
+    int pageCount() const;
+
+    // 포커스 모드 - 알림/활동 카메라를 큰 주 화면에, 나머지는 썸네일로 (동시 디코더 수 고정)
+    // 주 화면은 FocusHoldMs 동안 유지되고, 그 사이에는 더 높은 우선순위 요청만 전환
+    // Pi 썸네일은 서브스트림이 없어 일시정지해 두고 ThumbnailRefreshMs마다 한 프레임만 디코딩
+    enum class FocusReason { Activity, Alert };
+    void setFocusMode(bool enabled);
+    bool isFocusMode() const { return focusMode; }
+    void focusCamera(const QString &ip, FocusReason reason);
+    QString focusedCamera() const { return focusedIp; }
+
+    // ONVIF 카메라 타일은 타일 크기에 맞는 프로파일을 선택
+    void setOnvifClient(OnvifClient *client);
+
+    // 그리드 + ONVIF 뷰가 함께 쓰는 플레이어 풀
+    PlayerPool *playerPool() const { return pool; }
+
+    // 타일 스트림 프레임 도착 감시 (멈추면 해당 타일만 재시작) - ONVIF 뷰도 같은 모니터 사용
+    StreamHealthMonitor *streamHealth() const { return healthMonitor; }
+
+    // 현재 플레이어가 붙어 재생 중인 카메라 IP 목록
+    QStringList liveCameraIps() const;
+
+    // 스냅샷 - 타일 비디오 싱크의 마지막 디코딩 프레임 사용 (추가 디코더 없음)
+    // JPEG 압축은 작업 스레드, 결과는 카메라별 snapshotReady → 요청 전체가 끝나면 snapshotsFinished
+    QVideoFrame latestFrame(const QString &ip) const;
+    int captureSnapshots(const QStringList &ips);  // 반환: 실제 요청된 수 (프레임 없는 카메라 제외)
+    int captureAll() { return captureSnapshots(liveCameraIps()); }
+
+    // 활동량 테두리 (0 = 숨김, 1.0 = 최대) - ActivityAnalyzer 결과 표시
+    void setTileActivity(const QString &ip, double level);
+    void clearTileActivity();
+
+    static constexpr int MaxLivePlayers = 16;  // 동시에 재생할 수 있는 최대 타일 수
+    static constexpr int SnapshotJpegQuality = 90;
+    static constexpr int FocusGridCells = 4;     // 포커스 레이아웃 4x4 셀 - 주 화면 3x3 + 썸네일 7개
+    static constexpr int FocusHoldMs = 20000;
+    static constexpr int ThumbnailRefreshMs = 1000;  // StreamHealthMonitor::FreezeMs보다 짧게
+
+signals:
+    void pageChanged(int page, int pageCount);
+    void firstFrame(const QString &ip);  // 바인딩 후 첫 프레임 도착
+    void tileFrame(const QString &ip, const QVideoFrame &frame);  // 재생 중인 타일의 디코딩된 프레임 (클립 버퍼 등)
+    void snapshotReady(const QString &ip, const QByteArray &jpeg, qint64 capturedMs);  // jpeg 비어 있으면 실패
+    void snapshotsFinished(int requested, int succeeded);
+    void focusChanged(const QString &ip);
 
 private:
-    QVector<QMediaPlayer*> players;
-    QVector<QVideoWidget*> videoWidgets;
+    struct VideoTile {
+        QWidget *frame = nullptr;
+        QSize size;                         // 타일 크기 (포커스 모드에서는 주 화면/썸네일이 다름)
+        QLabel *nameLabel = nullptr;
+        QLabel *placeholder = nullptr;
+        QVideoWidget *videoWidget = nullptr;
+        QWidget *activityBorder = nullptr;  // 타일 위 투명 테두리
+        QMediaPlayer *player = nullptr;  // 카메라가 바인딩된 동안만 풀에서 빌려옴
+        QString url;
+        QString cameraIp;
+        bool awaitingFirstFrame = false;
+        QVideoFrame lastFrame;  // 스냅샷용 (암시적 공유 - 복사 없음)
+        qint64 lastFrameMs = 0;
+        bool throttled = false;   // 포커스 모드 Pi 썸네일 - 평소 일시정지
+        bool refreshing = false;  // 다음 프레임을 받으면 다시 일시정지
+    };
+
+    void buildTiles();
+    void bindPage(bool forceRestart);
+    void bindTile(VideoTile &tile, const CameraInfo *camera, bool forceRestart);
+    QVector<const CameraInfo*> tileCameras() const;  // 타일 순서대로 표시할 카메라
+    void adoptPlayer(int index, const QVector<QString> &urls);  // 같은 스트림을 재생 중인 다른 타일의 플레이어 넘겨받기
+    void releasePlayer(VideoTile &tile);
+    void setTileThrottled(VideoTile &tile, bool throttled);
+    void refreshThumbnails();
+    void onTileFrame(int index, QVideoWidget *widget, const QVideoFrame &frame);
+    QString streamUrl(const CameraInfo &camera, const QSize &size) const;
+
+    PlayerPool *pool = nullptr;
+    StreamHealthMonitor *healthMonitor = nullptr;
+    OnvifClient *onvifClient = nullptr;
+    QHash<QString, QString> onvifErrors;  // IP → 마지막 프로파일 조회 실패 사유 (성공 시 제거)
+    QGridLayout *gridLayout = nullptr;
+    QVector<CameraInfo> cameras;
+    QString streamSuffix;
+    QVector<VideoTile> tiles;
+
+    int rows = 2;
+    int columns = 2;
+    int gridWidth = 640;
+    int currentPage = 0;
+    bool layoutDirty = true;
+
+    bool focusMode = false;
+    QString focusedIp;
+    FocusReason focusReason = FocusReason::Activity;
+    qint64 focusHoldUntilMs = 0;
+    QTimer *thumbnailTimer = nullptr;
+
+    QThreadPool snapshotPool;  // 스냅샷 JPEG 압축 (소멸 시 완료 대기)
 };
 
 #endif // VIDEOPLAYERMANAGER_H